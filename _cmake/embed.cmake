@@ -0,0 +1,41 @@
+cmake_minimum_required(VERSION 3.18)
+
+# ----------------------------------------------------------------------------
+# embed_resources(<target> BASE_DIR <dir> FILES <file>...)
+#
+# Generates a source file that holds every listed file as a constexpr byte
+# array and adds it to <target>. Files are looked up at runtime by their path
+# relative to BASE_DIR (see include/utils/resource.hpp), so the executable
+# does not need the resources directory next to it.
+#
+# The generation runs at build time and depends on the listed files, so
+# editing a shader or replacing a font only regenerates the embedded table.
+# ----------------------------------------------------------------------------
+set(EMBED_GENERATE_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/embed_generate.cmake")
+
+function(embed_resources TARGET)
+  cmake_parse_arguments(EMBED "" "BASE_DIR" "FILES" ${ARGN})
+
+  set(OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/generated/${TARGET}_resources.cpp")
+
+  set(INPUTS)
+  foreach(FILE ${EMBED_FILES})
+    list(APPEND INPUTS "${EMBED_BASE_DIR}/${FILE}")
+  endforeach()
+
+  # a list cannot be passed through -D as-is, so join it with a separator the script splits again
+  string(REPLACE ";" "," FILE_LIST "${EMBED_FILES}")
+
+  add_custom_command(
+    OUTPUT ${OUTPUT}
+    COMMAND ${CMAKE_COMMAND}
+      "-DBASE_DIR=${EMBED_BASE_DIR}"
+      "-DFILES=${FILE_LIST}"
+      "-DOUTPUT=${OUTPUT}"
+      -P ${EMBED_GENERATE_SCRIPT}
+    DEPENDS ${INPUTS} ${EMBED_GENERATE_SCRIPT}
+    COMMENT "Embedding resources into ${TARGET}"
+    VERBATIM)
+
+  target_sources(${TARGET} PRIVATE ${OUTPUT})
+endfunction()
@@ -0,0 +1,45 @@
+# ----------------------------------------------------------------------------
+# Script mode helper for embed_resources() (cmake -P)
+#
+#   BASE_DIR : directory the FILES paths are relative to
+#   FILES    : comma separated list of files to embed
+#   OUTPUT   : generated C++ source path
+# ----------------------------------------------------------------------------
+string(REPLACE "," ";" FILES "${FILES}")
+
+set(ARRAYS "")
+set(ENTRIES "")
+set(INDEX 0)
+
+# CMake regular expressions have no {n} quantifier, so spell out one line of 16 bytes
+string(REPEAT "0x[0-9a-f][0-9a-f]," 16 LINE_PATTERN)
+
+foreach(FILE ${FILES})
+  file(READ "${BASE_DIR}/${FILE}" HEX HEX)
+  file(SIZE "${BASE_DIR}/${FILE}" SIZE)
+
+  # "a1b2..." -> "0xa1,0xb2,..." with 16 bytes per line
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," BYTES "${HEX}")
+  string(REGEX REPLACE "(${LINE_PATTERN})" "\\1\n    " BYTES "${BYTES}")
+
+  # a trailing zero keeps empty files valid and lets text resources be used as C strings
+  string(APPEND ARRAYS "  // ${FILE}\n  constexpr unsigned char RESOURCE_${INDEX}[] = {\n    ${BYTES}0x00};\n\n")
+  string(APPEND ENTRIES "    {\"${FILE}\", RESOURCE_${INDEX}, ${SIZE}},\n")
+
+  math(EXPR INDEX "${INDEX} + 1")
+endforeach()
+
+file(WRITE "${OUTPUT}"
+  "// Generated by _cmake/embed_generate.cmake -- do not edit.\n"
+  "#include \"utils/resource.hpp\"\n"
+  "\n"
+  "namespace\n"
+  "{\n"
+  "${ARRAYS}"
+  "}\n"
+  "\n"
+  "extern const EmbeddedResource EMBEDDED_RESOURCES[] = {\n"
+  "${ENTRIES}"
+  "    {NULL, NULL, 0}};\n"
+  "\n"
+  "extern const size_t EMBEDDED_RESOURCE_COUNT = ${INDEX};\n")
@@ -0,0 +1,30 @@
+cmake_minimum_required(VERSION 3.18)
+
+include(FetchContent)
+Set(FETCHCONTENT_QUIET FALSE)
+
+FetchContent_Declare(
+  harfbuzz
+  GIT_REPOSITORY https://github.com/harfbuzz/harfbuzz.git
+  GIT_PROGRESS TRUE
+  GIT_TAG 8.3.0
+)
+
+FetchContent_GetProperties(harfbuzz)
+
+if(NOT harfbuzz_POPULATED)
+  # shape through the FreeType face (hb-ft) using the freetype target from freetype.cmake,
+  # and skip every optional backend and tool
+  set(HB_HAVE_FREETYPE ON CACHE BOOL "" FORCE)
+  set(HB_HAVE_GLIB OFF CACHE BOOL "" FORCE)
+  set(HB_HAVE_GOBJECT OFF CACHE BOOL "" FORCE)
+  set(HB_HAVE_ICU OFF CACHE BOOL "" FORCE)
+  set(HB_HAVE_GRAPHITE2 OFF CACHE BOOL "" FORCE)
+  set(HB_BUILD_SUBSET OFF CACHE BOOL "" FORCE)
+  set(HB_BUILD_UTILS OFF CACHE BOOL "" FORCE)
+  FetchContent_MakeAvailable(harfbuzz)
+endif()
+
+set(harfbuzz_INCLUDE ${harfbuzz_SOURCE_DIR}/src)
+
+message(STATUS "HarfBuzz Should Be Downloaded")
@@ -12,6 +12,22 @@
 #include <sstream>     // 문자열 스트림
 #include <iostream>    // 콘솔 입출력을 위한 헤더
 #include <glm/glm.hpp> // glm 라이브러리
+#include <vector>      // std::vector
+
+/**
+ * 링킹 시점에 미리 조회해 둔 uniform 변수의 핸들
+ *
+ * Shader::getUniform() 으로 한 번만 조회해두고 핸들 기반 setter 에 넘기면,
+ * uniform 을 갱신할 때마다 이름 문자열 비교나 glGetUniformLocation() 드라이버 호출을 하지 않아도 됨.
+ * (쉐이더에 없거나 컴파일러가 최적화로 제거한 uniform 은 location 이 -1 이며, glUniform*() 은 -1 을 조용히 무시함)
+ */
+struct UniformHandle
+{
+  GLint location;
+  GLenum type; // glGetActiveUniform() 이 알려준 GLSL 자료형 (GL_FLOAT_MAT4 등)
+
+  bool isValid() const { return location >= 0; }
+};
 
 /*
   Shader 클래스
@@ -29,32 +45,126 @@ class Shader
 public:
   unsigned int ID; // 생성된 ShaderProgram의 참조 ID
 
-  // Shader 클래스 생성자
-  Shader(const GLchar *vertexPath, const GLchar *fragmentPath);
+  /**
+   * Shader 클래스 생성자
+   *
+   * binaryCacheDir 를 지정하면 링킹된 프로그램 바이너리를 해당 디렉토리에 저장해두고,
+   * 다음 실행부터는 GLSL 컴파일 없이 glProgramBinary() 로 바로 프로그램을 복원함. (디렉토리는 미리 존재해야 함)
+   * (GL 4.1 또는 GL_ARB_get_program_binary 가 필요하며, 3.3 컨텍스트에서는 loadGLExtensions() 를 먼저 호출해야 확장 함수가 로드됨)
+   *
+   * deferred 가 true 면 컴파일 / 링킹 명령만 드라이버에 제출하고 결과 확인은 finish() 로 미룸.
+   * (GL_COMPILE_STATUS, GL_LINK_STATUS 조회는 드라이버가 컴파일을 끝낼 때까지 호출 스레드를 멈추게 하므로,
+   *  여러 프로그램을 먼저 모두 제출해두고 나중에 확인해야 드라이버가 컴파일을 병렬로 진행할 수 있음 -> ShaderLibrary 참고)
+   *
+   * defines 의 각 항목은 두 쉐이더 소스의 #version 바로 아래에 "#define 항목" 으로 주입되므로,
+   * 같은 소스 파일에서 #ifdef 로 나뉜 기능만 골라 컴파일한 permutation(variant) 을 만들 수 있음. ("NAME" 또는 "NAME VALUE")
+   * 주입된 define 은 소스 해시에도 포함되므로 variant 마다 별도의 바이너리 캐시 파일이 만들어짐.
+   */
+  Shader(const GLchar *vertexPath, const GLchar *fragmentPath,
+         const std::vector<std::string> &defines = std::vector<std::string>(),
+         const char *binaryCacheDir = NULL, bool deferred = false);
 
   // Shader 클래스 소멸자
   ~Shader();
 
-  // ShaderProgram 객체 활성화
+  // ShaderProgram 객체 활성화 (아직 finish() 되지 않았다면 먼저 finish() 함)
   void use();
 
-  // 유니폼 변수 관련 유틸리티
-  void setBool(const std::string &name, bool value) const;
-  void setInt(const std::string &name, int value) const;
-  void setFloat(const std::string &name, float value) const;
-  void setVec2(const std::string &name, const glm::vec2 &value) const;
-  void setVec2(const std::string &name, float x, float y) const;
-  void setVec3(const std::string &name, const glm::vec3 &value) const;
-  void setVec3(const std::string &name, float x, float y, float z) const;
-  void setVec4(const std::string &name, const glm::vec4 &value) const;
-  void setVec4(const std::string &name, float x, float y, float z, float w) const;
-  void setMat2(const std::string &name, const glm::mat2 &mat) const;
-  void setMat3(const std::string &name, const glm::mat3 &mat) const;
-  void setMat4(const std::string &name, const glm::mat4 &mat) const;
+  /**
+   * 컴파일 / 링킹 결과를 확인하고 uniform 테이블을 만들어서 프로그램을 사용 가능한 상태로 만듦
+   *
+   * 드라이버가 아직 컴파일 중이라면 끝날 때까지 기다리며, 이미 finish() 되었다면 아무것도 하지 않음.
+   * getUniform() 은 finish() 이후에만 uniform 을 찾을 수 있음.
+   */
+  void finish();
+  bool isFinished() const { return finished; }
+
+  /**
+   * finish() 에서 소스 컴파일로 링킹된 프로그램의 바이너리를 캐시 파일로 저장 (저장할 것이 없으면 아무것도 하지 않음)
+   *
+   * glGetProgramBinary() 는 드라이버가 바이너리를 만들 때까지 기다리고 파일 쓰기도 느리므로,
+   * deferred 로 생성된 Shader 는 finish() 에서 저장하지 않고 프레임이 끝난 뒤나 종료 시점에 이 함수로 저장함. (소멸자도 호출함)
+   */
+  void saveBinary();
+
+  // 이름으로 uniform 핸들 조회 (링킹 직후 만들어 둔 uniform 테이블에서 찾으므로 GL 함수를 호출하지 않음)
+  UniformHandle getUniform(const char *name) const;
+
+  // 유니폼 변수 관련 유틸리티 (핸들 기반 -> 매 프레임 호출되는 경로에서 사용)
+  void setBool(UniformHandle uniform, bool value) const { glUniform1i(uniform.location, (int)value); }
+  void setInt(UniformHandle uniform, int value) const { glUniform1i(uniform.location, value); }
+  void setFloat(UniformHandle uniform, float value) const { glUniform1f(uniform.location, value); }
+  void setVec2(UniformHandle uniform, const glm::vec2 &value) const { glUniform2fv(uniform.location, 1, &value[0]); }
+  void setVec2(UniformHandle uniform, float x, float y) const { glUniform2f(uniform.location, x, y); }
+  void setVec3(UniformHandle uniform, const glm::vec3 &value) const { glUniform3fv(uniform.location, 1, &value[0]); }
+  void setVec3(UniformHandle uniform, float x, float y, float z) const { glUniform3f(uniform.location, x, y, z); }
+  void setVec4(UniformHandle uniform, const glm::vec4 &value) const { glUniform4fv(uniform.location, 1, &value[0]); }
+  void setVec4(UniformHandle uniform, float x, float y, float z, float w) const { glUniform4f(uniform.location, x, y, z, w); }
+  void setMat2(UniformHandle uniform, const glm::mat2 &mat) const { glUniformMatrix2fv(uniform.location, 1, GL_FALSE, &mat[0][0]); }
+  void setMat3(UniformHandle uniform, const glm::mat3 &mat) const { glUniformMatrix3fv(uniform.location, 1, GL_FALSE, &mat[0][0]); }
+  void setMat4(UniformHandle uniform, const glm::mat4 &mat) const { glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &mat[0][0]); }
+
+  // 유니폼 변수 관련 유틸리티 (이름 기반 -> 초기화 코드처럼 가끔 호출되는 경로에서 사용)
+  // -> const std::string & 대신 const char * 를 받으므로 문자열 리터럴을 넘겨도 std::string 이 생성(heap 할당)되지 않음.
+  void setBool(const char *name, bool value) const { setBool(getUniform(name), value); }
+  void setInt(const char *name, int value) const { setInt(getUniform(name), value); }
+  void setFloat(const char *name, float value) const { setFloat(getUniform(name), value); }
+  void setVec2(const char *name, const glm::vec2 &value) const { setVec2(getUniform(name), value); }
+  void setVec2(const char *name, float x, float y) const { setVec2(getUniform(name), x, y); }
+  void setVec3(const char *name, const glm::vec3 &value) const { setVec3(getUniform(name), value); }
+  void setVec3(const char *name, float x, float y, float z) const { setVec3(getUniform(name), x, y, z); }
+  void setVec4(const char *name, const glm::vec4 &value) const { setVec4(getUniform(name), value); }
+  void setVec4(const char *name, float x, float y, float z, float w) const { setVec4(getUniform(name), x, y, z, w); }
+  void setMat2(const char *name, const glm::mat2 &mat) const { setMat2(getUniform(name), mat); }
+  void setMat3(const char *name, const glm::mat3 &mat) const { setMat3(getUniform(name), mat); }
+  void setMat4(const char *name, const glm::mat4 &mat) const { setMat4(getUniform(name), mat); }
 
 private:
+  struct UniformInfo
+  {
+    std::string name; // 배열 uniform 은 "[0]" 을 제거한 이름과 "name[i]" 형태의 원소별 이름이 각각 따로 등록됨
+    UniformHandle handle;
+
+    bool operator<(const UniformInfo &other) const { return name < other.name; }
+  };
+
+  // 링킹된 프로그램의 active uniform 들을 조회해서 이름순으로 정렬된 uniform 테이블 생성
+  void buildUniformTable();
+
+  // 버텍스 / 프래그먼트 쉐이더 소스의 컴파일 및 프로그램 링킹 명령 제출 (retrievable 이 true 면 링킹 후 바이너리를 꺼낼 수 있도록 설정)
+  void compileProgram(bool retrievable);
+
+  /**
+   * 프로그램 바이너리 캐시
+   *
+   * 드라이버가 만든 바이너리는 같은 GPU / 드라이버 버전에서만 유효하므로, 쉐이더 소스 해시와 함께
+   * GL_VENDOR, GL_RENDERER, GL_VERSION 문자열의 해시를 캐시 키로 기록해두고 불러올 때 둘 다 일치하는지 확인함.
+   * 키가 다르거나 파일이 손상되었다면 false 를 반환해서 소스 컴파일로 대체하고,
+   * 드라이버가 바이너리를 거부(링킹 실패)한 경우는 finish() 에서 확인해서 소스 컴파일로 대체함.
+   */
+  bool loadProgramBinary();
+  void saveProgramBinary() const;
+
+  std::string vertexCode;   // 쉐이더 소스 (finish() 전까지만 보관)
+  std::string fragmentCode;
+  unsigned int vertexShader;   // 컴파일 결과를 finish() 에서 확인할 쉐이더 객체
+  unsigned int fragmentShader;
+  bool fromBinary; // 프로그램 바이너리 캐시로부터 복원되었는지 여부
+  bool finished;
+  bool binaryUnsaved; // finish() 되었지만 아직 캐시 파일로 저장하지 않은 바이너리가 있는지 여부
+
+  std::string cachePath; // 프로그램 바이너리 캐시 파일 경로 (비어있으면 캐시 사용 안함)
+  unsigned long long sourceHash;
+  unsigned long long driverHash;
+
+  std::vector<UniformInfo> uniforms;
+
   // 쉐이더 객체 및 쉐이더 프로그램 객체의 컴파일 및 링킹 에러 대응
   void checkCompileErrors(unsigned int shader, std::string type);
+
+  // 복사 방지 (쉐이더 프로그램 객체 중복 해제 방지)
+  Shader(const Shader &);
+  Shader &operator=(const Shader &);
 };
 
 #endif // SHADER_HPP
@@ -0,0 +1,85 @@
+#ifndef SHADER_LIBRARY_HPP
+#define SHADER_LIBRARY_HPP
+
+#include <glad/glad.h>         // OpenGL 함수를 초기화하기 위한 헤더
+#include <shader/shader.hpp>   // Shader 클래스
+#include <map>                 // std::map
+#include <string>              // std::string
+#include <vector>              // std::vector
+
+/*
+  ShaderLibrary 클래스
+
+  여러 쉐이더 프로그램을 이름으로 등록해두고, 컴파일을 병렬로 진행시키기 위한 쉐이더 모음.
+
+  Shader 를 하나씩 생성하면 생성자가 컴파일 직후 GL_COMPILE_STATUS / GL_LINK_STATUS 를 조회하기 때문에
+  드라이버는 그 프로그램의 컴파일을 끝낼 때까지 호출 스레드를 멈추게 되고, 결국 모든 프로그램이 하나씩 순서대로 컴파일됨.
+
+  ShaderLibrary 는 add() 로 모든 프로그램의 컴파일 / 링킹 명령을 먼저 제출해두고, 결과 확인은 get() 으로 처음 사용되는 시점까지 미룸.
+  드라이버가 GL_KHR_parallel_shader_compile (또는 GL_ARB_parallel_shader_compile) 을 지원하면
+  컴파일 스레드 개수 제한을 풀어서 제출된 프로그램들이 드라이버 내부 스레드에서 동시에 컴파일되도록 하고,
+  poll() 에서 GL_COMPLETION_STATUS_KHR 로 컴파일이 끝난 프로그램만 골라서 기다림 없이 마무리함.
+*/
+class ShaderLibrary
+{
+public:
+  /**
+   * ShaderLibrary 클래스 생성자
+   *
+   * loader 는 glad 로더에 포함되지 않은 parallel shader compile 확장 함수를 불러올 때 사용하며 (gladLoadGLLoader() 에 넘긴 것과 동일),
+   * binaryCacheDir 는 등록되는 모든 Shader 의 프로그램 바이너리 캐시 디렉토리임. (NULL 이면 캐시 사용 안함)
+   */
+  ShaderLibrary(GLADloadproc loader, const char *binaryCacheDir = NULL);
+
+  // ShaderLibrary 클래스 소멸자 (등록된 모든 Shader 해제)
+  ~ShaderLibrary();
+
+  // 쉐이더 프로그램의 컴파일 / 링킹을 제출하고 이름으로 등록 (같은 이름이 이미 있으면 기존 Shader 반환)
+  Shader *add(const std::string &name, const GLchar *vertexPath, const GLchar *fragmentPath,
+              const std::vector<std::string> &defines = std::vector<std::string>());
+
+  /**
+   * 같은 소스 파일에 define 조합만 다르게 주입한 permutation 을 등록
+   *
+   * 등록 이름은 소스 경로와 정렬된 define 목록으로 만들어지므로, define 순서가 달라도 같은 조합이면 한 번만 컴파일됨.
+   * 사용할 조합을 시작 시점에 미리 addVariant() 해두면 다른 프로그램들과 함께 병렬로 컴파일되고,
+   * getVariant() 는 등록되지 않은 조합이면 그 자리에서 등록한 뒤 바로 finish() 해서 반환함.
+   */
+  Shader *addVariant(const GLchar *vertexPath, const GLchar *fragmentPath, const std::vector<std::string> &defines);
+  Shader *getVariant(const GLchar *vertexPath, const GLchar *fragmentPath, const std::vector<std::string> &defines);
+
+  // 이름으로 등록된 Shader 반환 (아직 결과를 확인하지 않았다면 이 시점에 finish() 함, 없는 이름이면 NULL)
+  Shader *get(const std::string &name);
+
+  // 드라이버가 컴파일을 끝낸 프로그램들만 기다림 없이 finish() 함 (병렬 컴파일을 지원하지 않으면 완료 여부를 알 수 없으므로 finish() 하지 않음)
+  void poll();
+
+  /**
+   * finish() 된 프로그램들 중 아직 저장하지 않은 바이너리를 캐시 디렉토리에 저장
+   *
+   * poll() 은 매 프레임 호출되므로 프로그램이 완성되는 즉시 바이너리를 꺼내서 쓰면 프레임 도중에 멈추게 됨.
+   * 그래서 저장은 로딩 화면이나 종료 시점처럼 멈춰도 되는 때에 이 함수로 한꺼번에 함. (소멸자에서 Shader 를 해제할 때도 저장됨)
+   */
+  void saveBinaries();
+
+  // 등록되었지만 아직 finish() 되지 않은 프로그램 개수
+  size_t getPendingCount() const { return pending.size(); }
+
+  // 드라이버의 병렬 쉐이더 컴파일 사용 여부
+  bool isParallel() const { return parallel; }
+
+private:
+  // permutation 의 등록 이름 생성 ("vertexPath|fragmentPath|DEFINE_A,DEFINE_B")
+  static std::string variantName(const GLchar *vertexPath, const GLchar *fragmentPath, std::vector<std::string> defines);
+
+  std::map<std::string, Shader *> shaders;
+  std::vector<Shader *> pending;
+  std::string binaryCacheDir;
+  bool parallel;
+
+  // 복사 방지 (Shader 중복 해제 방지)
+  ShaderLibrary(const ShaderLibrary &);
+  ShaderLibrary &operator=(const ShaderLibrary &);
+};
+
+#endif // SHADER_LIBRARY_HPP
@@ -0,0 +1,27 @@
+#ifndef CHARACTER_HPP
+#define CHARACTER_HPP
+
+#include <glm/glm.hpp> // glm 라이브러리
+
+// 공백 문자처럼 bitmap 이 없어서 아틀라스 페이지에 저장되지 않은 glyph 의 페이지 번호
+const unsigned int NO_PAGE = 0xFFFFFFFFu;
+
+/**
+ * FreeType 라이브러리로 로드한 glyph metrices(각 글꼴의 크기, 위치, baseline 등)를 파싱할 자료형 정의
+ *
+ * glyph bitmap 은 GlyphAtlas 텍스쳐(페이지)에 모아서 저장되므로,
+ * glyph 마다 텍스쳐 ID 를 들고 있는 대신 아틀라스 페이지 번호와 페이지 내에서 차지하는 uv 영역을 저장함.
+ *
+ * glyph 캐시 안에서는 GlyphMetrics 가 필드별 배열로 나눠서 저장하므로,
+ * Character 는 glyph 하나의 metrices 를 주고받을 때(캐시 추가, 디스크 캐시 저장)만 사용함.
+ */
+struct Character
+{
+  glm::vec4 UV;         // 아틀라스 텍스쳐 내에서 glyph 가 차지하는 uv 영역 (u0, v0, u1, v1)
+  unsigned int Page;    // glyph 가 저장된 아틀라스 페이지 번호 (bitmap 이 없는 glyph 는 NO_PAGE)
+  glm::ivec2 Size;      // glyph 크기
+  glm::ivec2 Bearing;   // glyph 원점에서 x축, y축 방향으로 각각 떨어진 offset
+  unsigned int Advance; // 현재 glyph 원점에서 다음 glyph 원점까지의 거리 (1/64px 단위로 정의되어 있으므로, 값 사용 시 1px 단위로 변환해야 함.)
+};
+
+#endif // CHARACTER_HPP
@@ -0,0 +1,65 @@
+#ifndef FONT_LOADER_HPP
+#define FONT_LOADER_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <utils/resource.hpp> // 내장 리소스 / 메모리 매핑된 폰트 바이트
+#include <cstddef>            // size_t
+#include <map>                // std::map
+#include <string>             // std::string
+
+/*
+  FontLoader 클래스
+
+  폰트 파일을 경로마다 한 번만 읽기 전용으로 메모리 매핑하고, 그 바이트로 FT_New_Memory_Face() 를 호출해서 FT_Face 를 만들어 주는 클래스.
+
+  FT_New_Face() 로 폰트를 열면 FT_Face 마다 별도의 stream 으로 파일을 읽게 되지만,
+  FontLoader 는 같은 폰트의 모든 FT_Face (메인 스레드의 FT_Face, GlyphRasterizer worker 들의 FT_Face)가 하나의 매핑을 공유하도록 함.
+
+  매핑은 PROT_READ + MAP_SHARED 로 만들어지므로 (MappedFile 참고) 폰트 바이트는 프로세스의 private 메모리가 아니라 page cache 에 있고,
+  같은 호스트에서 같은 폰트를 여는 렌더러 프로세스들은 모두 같은 물리 페이지를 공유함.
+  실행파일에 내장된 폰트도 실행파일 이미지의 읽기 전용 페이지이므로 마찬가지로 프로세스 간에 공유됨.
+
+  getReport() 로 현재 로드된 폰트 바이트를 매핑 방식별로 확인할 수 있으며,
+  폰트 바이트는 FontLoader 가 소멸될 때 해제되므로 FontLoader 로 만든 FT_Face 와 GlyphRasterizer 보다 오래 살아있어야 함.
+*/
+class FontLoader
+{
+public:
+  // 로드된 폰트들이 차지하는 메모리
+  struct Report
+  {
+    unsigned int fonts;   // 로드된 폰트 파일 개수
+    size_t mappedBytes;   // 디스크에서 메모리 매핑한 폰트 바이트 (page cache 를 프로세스 간에 공유)
+    size_t embeddedBytes; // 실행파일에 내장된 폰트 바이트 (실행파일 이미지를 프로세스 간에 공유)
+  };
+
+  // FontLoader 클래스 생성자
+  FontLoader();
+
+  // FontLoader 클래스 소멸자 (모든 폰트 매핑 해제)
+  ~FontLoader();
+
+  // 폰트 파일 바이트를 가져옴 (같은 경로는 처음 한 번만 매핑하며, 찾을 수 없으면 NULL 반환)
+  const Resource *load(const char *path);
+
+  /**
+   * load() 한 폰트 바이트로 FT_Face 생성 (실패하면 NULL 반환)
+   *
+   * 반환된 FT_Face 의 해제(FT_Done_Face() 또는 FT_Done_FreeType())는 호출한 쪽에서 FontLoader 소멸 전에 해야 함.
+   */
+  FT_Face openFace(FT_Library library, const char *path, FT_Long faceIndex = 0);
+
+  const Report &getReport() const { return report; }
+
+private:
+  std::map<std::string, Resource *> fonts;
+  Report report;
+
+  // 복사 방지 (폰트 매핑 중복 해제 방지)
+  FontLoader(const FontLoader &);
+  FontLoader &operator=(const FontLoader &);
+};
+
+#endif // FONT_LOADER_HPP
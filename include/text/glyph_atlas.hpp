@@ -0,0 +1,71 @@
+#ifndef GLYPH_ATLAS_HPP
+#define GLYPH_ATLAS_HPP
+
+#include <glad/glad.h>             // OpenGL 함수를 초기화하기 위한 헤더
+#include <glm/glm.hpp>             // glm 라이브러리
+#include "text/skyline_packer.hpp" // glyph 배치용 rectangle packer
+#include <vector>                  // std::vector
+
+/*
+  GlyphAtlas 클래스
+
+  모든 glyph 의 grayscale bitmap 을 하나의 큰 GL_RED 텍스쳐에 모아서 저장하는 텍스쳐 아틀라스.
+  (channels 를 3 으로 생성하면 MSDF 처럼 채널마다 다른 값을 가진 glyph 를 저장하는 GL_RGB 텍스쳐가 됨)
+
+  기존처럼 glyph 마다 텍스쳐 객체를 하나씩 생성하면
+  128 개의 작은 텍스쳐 객체가 만들어지고, 문자마다 glBindTexture() 를 다시 호출해야 하지만,
+  아틀라스를 사용하면 하나의 텍스쳐만 바인딩한 상태로 문자열 전체를 렌더링할 수 있음.
+
+  각 glyph 가 아틀라스 내에서 차지하는 영역은 SkylinePacker 로 배치하며,
+  선형 필터링 시 인접한 glyph 의 텍셀이 번져 보이는 현상(bleeding)을 막기 위해
+  glyph 사이사이에 padding 만큼의 빈 텍셀을 남겨둠.
+*/
+class GlyphAtlas
+{
+public:
+  unsigned int TextureID; // 아틀라스 텍스쳐 객체의 참조 ID
+
+  // GlyphAtlas 클래스 생성자
+  GlyphAtlas(int width, int height, int padding = 1, int channels = 1);
+
+  // GlyphAtlas 클래스 소멸자
+  ~GlyphAtlas();
+
+  /**
+   * glyph bitmap 을 아틀라스에 배치하고 텍스쳐에 업로드한 뒤,
+   * 해당 glyph 의 uv 영역 (u0, v0, u1, v1) 을 uvRect 에 기록함.
+   *
+   * pitch 는 bitmap 한 줄(row)의 byte 수(픽셀 개수 x channels 이상)이며, 아틀라스에 남은 공간이 없으면 false 반환.
+   */
+  bool addGlyph(int width, int height, int pitch, const unsigned char *pixels, glm::vec4 &uvRect);
+
+  // 배치된 모든 glyph 를 지우고 아틀라스를 빈 상태로 되돌림 (텍스쳐도 0 으로 초기화)
+  void clear();
+
+  // 아틀라스 텍스쳐 전체 픽셀을 CPU 메모리로 읽어옴 (width x height x channels 크기의 8-bit 배열)
+  void readPixels(std::vector<unsigned char> &pixels) const;
+
+  // 디스크 캐시 등에서 읽어온 아틀라스 전체 픽셀과 packer 상태로 아틀라스를 복원
+  void restore(const unsigned char *pixels, const std::vector<SkylinePacker::Node> &skyline, long long usedArea);
+
+  // glyph 배치 상태
+  const SkylinePacker &getPacker() const { return packer; }
+
+  int getWidth() const { return packer.getWidth() + padding; }
+  int getHeight() const { return packer.getHeight() + padding; }
+  int getChannels() const { return channels; }
+
+private:
+  // channels 에 대응되는 텍스쳐 픽셀 포맷 (GL_RED 또는 GL_RGB)
+  GLenum getFormat() const { return channels == 3 ? GL_RGB : GL_RED; }
+
+  SkylinePacker packer;
+  int padding;
+  int channels;
+
+  // 복사 방지 (텍스쳐 객체 중복 해제 방지)
+  GlyphAtlas(const GlyphAtlas &);
+  GlyphAtlas &operator=(const GlyphAtlas &);
+};
+
+#endif // GLYPH_ATLAS_HPP
@@ -0,0 +1,212 @@
+#ifndef GLYPH_CACHE_HPP
+#define GLYPH_CACHE_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <text/character.hpp>        // Character 자료형
+#include <text/glyph_atlas.hpp>      // 아틀라스 페이지
+#include <text/glyph_metrics.hpp>    // glyph metrices 필드별 저장소
+#include <text/glyph_rasterizer.hpp> // glyph rasterize 경로 및 GlyphRenderMode
+#include <text/glyph_table.hpp>      // codepoint -> glyph 번호 조회 테이블
+#include <text/kerning_table.hpp>    // 문자 쌍 kerning 조회 테이블
+#include <cstddef>                   // size_t
+#include <unordered_set>             // std::unordered_set
+#include <vector>                    // std::vector
+
+/**
+ * 디스크 캐시 파일이 현재 glyph 캐시와 같은 조건으로 만들어졌는지 확인하기 위한 키
+ *
+ * 폰트 파일 내용, pixel size, FreeType render mode 중 하나라도 다르면
+ * 같은 codepoint 라도 다른 bitmap 이 rasterize 되므로 캐시 파일을 사용할 수 없음.
+ */
+struct GlyphCacheKey
+{
+  unsigned long long fontHash; // 폰트 파일 전체 내용의 해시
+  unsigned int pixelSize;      // FT_Set_Pixel_Sizes() 에 지정한 pixel height
+  unsigned int renderMode;     // 아틀라스에 저장된 glyph 형태 (GlyphRenderMode)
+};
+
+/*
+  GlyphCache 클래스
+
+  유니코드 전체를 미리 rasterize 해두는 대신, 문자가 처음 요청되는 순간에
+  FT_Face 로 glyph 를 rasterize 해서 아틀라스 페이지에 추가하는 on-demand glyph 캐시.
+
+  아틀라스 페이지는 필요할 때마다 하나씩 늘어나지만, 전체 페이지 메모리가 memoryBudget 을 넘어서게 되면
+  가장 오랫동안 사용되지 않은(LRU) 페이지를 비우고 그 페이지에 있던 glyph 들을 캐시에서 제거한 뒤 재사용함.
+
+  skyline packer 는 개별 사각형을 해제해서 공간을 돌려받을 수 없기 때문에, 제거 단위는 glyph 가 아닌 페이지이며
+  페이지의 사용 시각은 그 페이지에 있는 glyph 중 가장 최근에 사용된 시각으로 갱신됨.
+
+  단, 현재 프레임에서 이미 사용된 페이지는 (그 uv 를 참조하는 glyph 들이 아직 flush 되지 않았을 수 있으므로)
+  제거 대상에서 제외하며, 모든 페이지가 현재 프레임에서 사용 중이라면 새 glyph 추가를 포기함.
+
+  loadFromDisk() / saveToDisk() 로 아틀라스 페이지 픽셀과 glyph metrices 를 버전이 붙은 바이너리 파일에 저장해두면,
+  다음 실행 시에는 파일을 메모리 매핑해서 텍스쳐에 바로 업로드하므로 캐시에 있는 glyph 는 FreeType 을 전혀 거치지 않음.
+
+  setRasterizer() 로 GlyphRasterizer 를 연결하면 glyph rasterize 는 worker 스레드들이 병렬로 처리하고,
+  GlyphCache 는 GL 스레드에서 완료된 결과를 꺼내 아틀라스에 업로드하는 일만 담당함.
+  이 때 prefetch() 로 앞으로 사용할 문자들을 한꺼번에 요청해두면 여러 glyph 가 동시에 rasterize 됨.
+
+  glyph metrices 는 GlyphMetrics 에 필드별 배열로 저장되며, get() / find() / peek() 는 glyph 번호(dense index)를 반환하므로
+  getMetrics() 의 필드별 조회 함수로 필요한 값만 읽으면 됨.
+  glyph 번호는 그 glyph 가 캐시에서 제거되기 전까지 유효하며, 제거된 번호는 새로 추가되는 glyph 에 재사용됨.
+
+  FT_Face 는 생성자에서 받아서 계속 사용하므로, GlyphCache 를 다 사용하기 전까지 FT_Done_Face() 를 호출하면 안됨.
+*/
+class GlyphCache
+{
+public:
+  struct Stats
+  {
+    unsigned int hits;        // 캐시에 이미 있던 glyph 조회 횟수
+    unsigned int misses;      // 새로 rasterize 한 glyph 개수
+    unsigned int evictions;   // 비워서 재사용한 페이지 개수 (값이 바뀌면 이전에 가져간 glyph 의 uv 가 무효화되었을 수 있음)
+    unsigned int pages;       // 현재 생성된 아틀라스 페이지 개수
+    size_t residentBytes;     // 현재 아틀라스 페이지들이 차지하는 텍스쳐 메모리
+  };
+
+  // GlyphCache 클래스 생성자
+  GlyphCache(FT_Face face, int pageSize = 512, size_t memoryBudget = 4 * 512 * 512, int padding = 2,
+             GlyphRenderMode renderMode = GLYPH_RENDER_BITMAP);
+
+  // GlyphCache 클래스 소멸자
+  ~GlyphCache();
+
+  // 새 프레임 시작 (페이지 사용 시각 갱신 기준이 되는 프레임 번호 증가)
+  void beginFrame();
+
+  /**
+   * codepoint 에 대응되는 glyph 번호를 반환하며, 캐시에 없으면 rasterize 해서 아틀라스에 추가함.
+   * (glyph 를 rasterize 할 수 없거나 메모리 예산 안에서 공간을 확보하지 못하면 GlyphMetrics::NO_GLYPH 반환)
+   *
+   * 반환된 glyph 번호는 다음 get() 호출 전까지만 유효함. (get() 도중 페이지가 제거될 수 있음)
+   */
+  unsigned int get(unsigned int codepoint);
+
+  // 캐시에 이미 있는 glyph 번호만 반환 (없으면 rasterize 하지 않고 GlyphMetrics::NO_GLYPH 반환)
+  unsigned int find(unsigned int codepoint);
+
+  /**
+   * 캐시에 이미 있는 glyph 번호만 반환하되, 통계와 페이지 사용 시각을 갱신하지 않는 읽기 전용 조회
+   *
+   * GL 을 사용하지 않는 layout 단계(TextLayout)에서 사용하며, 그려질 페이지는 렌더링 단계에서 touchPage() 로 표시해야 함.
+   */
+  unsigned int peek(unsigned int codepoint) const { return table.find(codepoint); }
+
+  // glyph 번호로 metrices 를 조회하는 필드별 저장소
+  const GlyphMetrics &getMetrics() const { return metrics; }
+
+  // [first, last] 범위의 codepoint 들을 미리 rasterize
+  void preload(unsigned int first, unsigned int last);
+
+  // 캐시 키(codepoint 또는 glyphIndexKey()) 배열의 glyph 들을 미리 rasterize
+  void preload(const unsigned int *keys, size_t count);
+
+  /**
+   * [first, last] 범위의 codepoint 쌍들의 kerning 을 FT_Face 로부터 한 번에 추출 (추출된 쌍의 개수 반환)
+   *
+   * 범위 밖의 문자가 포함된 쌍은 kerning 이 적용되지 않으며, 다시 호출하면 새 범위로 교체됨.
+   */
+  size_t loadKerning(unsigned int first, unsigned int last);
+
+  // left 다음에 right 가 올 때 pen 위치에 더할 kerning (px 단위, layout 루프에서 인접한 문자 쌍마다 호출)
+  float getKerning(unsigned int left, unsigned int right) const { return kerning.lookup(left, right); }
+
+  /**
+   * glyph rasterize 를 worker 스레드들에게 맡김 (이후 get() 은 worker 들이 FreeType 을 호출하는 동안 완료된 결과만 업로드함)
+   *
+   * rasterizer 는 GlyphCache 보다 오래 살아있어야 하고 같은 GlyphRenderMode 로 생성되어야 하며,
+   * NULL 을 넘기면 다시 FT_Face 로 직접 rasterize 함.
+   */
+  void setRasterizer(GlyphRasterizer *rasterizer) { this->rasterizer = rasterizer; }
+
+  // UTF-8 문자열 [begin, end) 에서 캐시에 없는 문자들을 rasterizer 에 미리 요청 (rasterizer 가 없으면 아무것도 하지 않음)
+  void prefetch(const char *begin, const char *end);
+
+  // 캐시 키(codepoint 또는 glyphIndexKey()) 배열에서 캐시에 없는 glyph 들을 rasterizer 에 미리 요청 (shaping 결과용)
+  void prefetch(const unsigned int *keys, size_t count);
+
+  // 아틀라스 페이지의 텍스쳐 ID
+  unsigned int getPageTexture(unsigned int page) const { return pages[page].atlas->TextureID; }
+
+  /**
+   * 페이지를 현재 프레임에서 사용 중인 것으로 표시 (LRU 제거 대상에서 제외)
+   *
+   * glyph 를 매 프레임 find() 하지 않고 uv 를 보관해두고 재사용하는 쪽(TextMesh)에서 페이지 단위로 호출함.
+   * 그래도 페이지가 제거되었는지는 getStats().evictions 가 바뀌었는지로 확인할 수 있음.
+   */
+  void touchPage(unsigned int page) { pages[page].lastUsedFrame = frame; }
+
+  const Stats &getStats() const { return stats; }
+
+  /**
+   * 디스크 캐시 파일을 메모리 매핑해서 아틀라스 페이지와 glyph 들을 복원 (빈 캐시에서만 호출 가능)
+   *
+   * 파일이 없거나, 버전 / 키 / 페이지 설정이 현재 캐시와 다르거나, 파일이 손상되었다면 아무것도 하지 않고 false 반환.
+   */
+  bool loadFromDisk(const char *path, const GlyphCacheKey &key);
+
+  // 현재 아틀라스 페이지와 glyph 들을 디스크 캐시 파일로 저장
+  bool saveToDisk(const char *path, const GlyphCacheKey &key) const;
+
+  // 디스크에서 불러온 이후(또는 생성 이후) 새로 rasterize 되거나 제거된 glyph 가 있는지 여부
+  bool isDirty() const { return dirty; }
+
+private:
+  struct Page
+  {
+    GlyphAtlas *atlas;
+    unsigned long lastUsedFrame;
+    std::vector<unsigned int> codepoints; // 이 페이지에 저장된 glyph 들 (페이지 제거 시 캐시에서 함께 제거)
+  };
+
+  // codepoint 를 rasterize 해서 아틀라스에 추가
+  unsigned int load(unsigned int codepoint);
+
+  // rasterize 된 glyph bitmap 과 metrices 를 아틀라스와 조회 테이블에 추가
+  unsigned int insert(const RasterizedGlyph &glyph);
+
+  // codepoint 와 metrices 를 조회 테이블과 metrices 저장소에 추가
+  void addGlyph(unsigned int codepoint, const Character &character);
+
+  // 아직 요청되지 않은 codepoint 들을 rasterizer 에 요청
+  void request(const std::vector<unsigned int> &codepoints);
+
+  // rasterizer 가 완료한 glyph 들을 꺼내서 아틀라스에 업로드 (wait 가 true 면 요청한 glyph 가 모두 도착할 때까지 대기)
+  void receive(bool wait);
+
+  // glyph bitmap 을 저장할 페이지를 찾아서 배치 (필요하면 새 페이지 생성 또는 LRU 페이지 제거)
+  bool place(int width, int height, int pitch, const unsigned char *pixels, glm::vec4 &uv, unsigned int &page);
+
+  // 주어진 페이지의 glyph 들을 캐시에서 제거하고 페이지를 비움
+  void evict(unsigned int page);
+
+  FT_Face face;
+  GlyphRenderMode renderMode;
+  RasterizedGlyph scratch; // 동기 로드 경로에서 재사용하는 rasterize 결과 버퍼
+  int pageSize;
+  int channels;
+  int padding;
+  size_t maxPages;
+
+  GlyphTable table;
+  GlyphMetrics metrics;
+  KerningTable kerning;
+  std::vector<Page> pages;
+  std::vector<unsigned int> unpaged; // 공백 문자처럼 아틀라스 페이지에 저장되지 않은 glyph 들 (디스크 캐시 저장용)
+  bool dirty;
+  unsigned long frame;
+
+  GlyphRasterizer *rasterizer;
+  std::unordered_set<unsigned int> pending; // rasterizer 에 요청했지만 아직 결과를 받지 못한 codepoint 들
+
+  Stats stats;
+
+  // 복사 방지 (아틀라스 페이지 중복 해제 방지)
+  GlyphCache(const GlyphCache &);
+  GlyphCache &operator=(const GlyphCache &);
+};
+
+#endif // GLYPH_CACHE_HPP
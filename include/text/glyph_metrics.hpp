@@ -0,0 +1,81 @@
+#ifndef GLYPH_METRICS_HPP
+#define GLYPH_METRICS_HPP
+
+#include <glm/glm.hpp>        // glm 라이브러리
+#include <text/character.hpp> // Character 자료형, NO_PAGE
+#include <cstddef>            // size_t
+#include <vector>             // std::vector
+
+/**
+ * glyph 크기와 bearing (px 단위, 16-bit 정수)
+ *
+ * layout 루프가 glyph 마다 항상 네 값을 함께 읽으므로 하나의 8 byte 레코드로 묶어둠.
+ * (glyph bitmap 크기와 bearing 은 pixel size 가 수천 px 이 되어도 16-bit 범위를 넘지 않음)
+ */
+struct GlyphBox
+{
+  short sizeX;
+  short sizeY;
+  short bearingX;
+  short bearingY;
+};
+
+/*
+  GlyphMetrics 클래스
+
+  glyph 캐시에 있는 glyph 들의 metrices 를 필드별 연속 배열(structure-of-arrays)로 저장하는 저장소.
+
+  Character 는 uv, 페이지 번호, 크기, bearing, advance 를 한 구조체(40 byte)에 담고 있어서
+  조회 테이블의 slot 마다 통째로 들어가 있으면, layout 루프는 glyph 하나를 읽을 때마다
+  필요 없는 필드까지 포함된 큰 slot 들 사이를 건너뛰며 읽게 되고 테이블의 빈 slot 도 그만큼 메모리를 차지함.
+
+  GlyphMetrics 는 glyph 를 추가할 때 빈틈없는 glyph 번호(dense index)를 하나 할당하고,
+  그 번호를 index 로 사용하는 아래 배열들에 필드를 나눠서 저장함.
+    - boxes    : GlyphBox (16-bit 크기, bearing)
+    - advances : 26.6 고정소수점 advance (FreeType 의 1/64 px 값 그대로)
+    - uvs      : 아틀라스 uv 영역
+    - pages    : 아틀라스 페이지 번호
+  glyph 하나의 metrices 는 32 byte 이며, 조회 테이블(GlyphTable)에는 glyph 번호(4 byte)만 저장됨.
+
+  제거된 glyph 의 번호는 free list 에 모아두었다가 다음에 추가되는 glyph 에 재사용하므로 배열에 구멍이 계속 늘어나지 않음.
+*/
+class GlyphMetrics
+{
+public:
+  // glyph 가 없음을 나타내는 glyph 번호
+  static const unsigned int NO_GLYPH = 0xFFFFFFFFu;
+
+  // glyph 를 추가하고 glyph 번호 반환
+  unsigned int add(const Character &character);
+
+  // glyph 번호를 비워서 다음 add() 에서 재사용
+  void remove(unsigned int index);
+
+  // 저장된 모든 glyph 제거
+  void clear();
+
+  // glyph 번호의 metrices 를 Character 로 조립 (디스크 캐시 저장 등 hot path 가 아닌 곳에서 사용)
+  Character get(unsigned int index) const;
+
+  // 필드별 조회 (layout 루프용)
+  const GlyphBox &getBox(unsigned int index) const { return boxes[index]; }
+  int getAdvance(unsigned int index) const { return advances[index]; }
+  const glm::vec4 &getUV(unsigned int index) const { return uvs[index]; }
+  unsigned int getPage(unsigned int index) const { return pages[index]; }
+
+  // 저장된 glyph 개수
+  size_t size() const { return pages.size() - freeList.size(); }
+
+  // 배열들이 차지하는 메모리 (할당된 capacity 기준)
+  size_t getMemoryBytes() const;
+
+private:
+  std::vector<GlyphBox> boxes;
+  std::vector<int> advances;
+  std::vector<glm::vec4> uvs;
+  std::vector<unsigned int> pages;
+
+  std::vector<unsigned int> freeList; // 제거되어 재사용을 기다리는 glyph 번호들
+};
+
+#endif // GLYPH_METRICS_HPP
@@ -0,0 +1,148 @@
+#ifndef GLYPH_RASTERIZER_HPP
+#define GLYPH_RASTERIZER_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <utils/bounded_queue.hpp> // lock-free 결과 큐
+#include <atomic>                  // std::atomic
+#include <condition_variable>      // std::condition_variable
+#include <cstddef>                 // size_t
+#include <deque>                   // std::deque
+#include <mutex>                   // std::mutex
+#include <thread>                  // std::thread
+#include <vector>                  // std::vector
+
+/**
+ * glyph 를 아틀라스에 저장할 형태
+ *
+ * GLYPH_RENDER_BITMAP : FreeType 이 rasterize 한 anti-aliasing 된 coverage bitmap 을 그대로 저장 (TEXT_FEATURE_NONE 로 렌더링)
+ * GLYPH_RENDER_SDF    : coverage bitmap 으로부터 생성한 signed distance field 를 저장 (TEXT_FEATURE_SDF 로 렌더링)
+ *                       -> 한 가지 pixel size 로 rasterize 한 아틀라스 하나로 작은 크기부터 큰 크기까지 선명하게 렌더링할 수 있음.
+ * GLYPH_RENDER_MSDF   : 외곽선으로부터 생성한 multi-channel SDF 를 RGB 아틀라스에 저장 (TEXT_FEATURE_MSDF 로 렌더링)
+ *                       -> SDF 와 달리 크게 확대해도 glyph 모서리가 둥글게 뭉개지지 않음.
+ *
+ * 값은 디스크 캐시 키(GlyphCacheKey::renderMode)에 그대로 기록되므로 기존 값을 바꾸면 안됨.
+ */
+enum GlyphRenderMode
+{
+  GLYPH_RENDER_BITMAP = 0,
+  GLYPH_RENDER_SDF = 1,
+  GLYPH_RENDER_MSDF = 2
+};
+
+// 렌더 모드별 아틀라스 텍스쳐의 채널 개수 (MSDF 만 RGB 3채널)
+inline int glyphChannelCount(GlyphRenderMode renderMode)
+{
+  return renderMode == GLYPH_RENDER_MSDF ? 3 : 1;
+}
+
+/**
+ * glyph 캐시 키로 codepoint 대신 폰트 내부의 glyph index 를 사용할 때 붙이는 플래그
+ *
+ * shaping 단계(TextShaper)는 ligature 나 문맥에 따른 대체 glyph 처럼 codepoint 와 1:1 로 대응되지 않는 glyph index 를 반환하므로,
+ * 유니코드 범위(U+10FFFF) 밖인 최상위 비트를 세워서 같은 glyph 캐시 / rasterizer 에 codepoint 와 겹치지 않게 요청함.
+ */
+const unsigned int GLYPH_INDEX_FLAG = 0x80000000u;
+
+// glyph index 를 glyph 캐시 키로 변환
+inline unsigned int glyphIndexKey(unsigned int glyphIndex)
+{
+  return GLYPH_INDEX_FLAG | glyphIndex;
+}
+
+/**
+ * worker 스레드가 rasterize 한 glyph 하나의 결과
+ *
+ * GL 함수는 GL 컨텍스트가 바인딩된 스레드에서만 호출할 수 있으므로,
+ * worker 는 bitmap 과 metrices 만 만들어두고 아틀라스 업로드는 GL 스레드가 처리함.
+ */
+struct RasterizedGlyph
+{
+  unsigned int codepoint;            // codepoint 또는 glyphIndexKey() 로 만든 glyph index 키
+  bool failed;                       // FT_Load_Glyph() 실패 여부
+  int width;                         // bitmap 너비 (한 줄이 width x 채널 개수 byte 로 빈틈없이 저장됨)
+  int rows;                          // bitmap 높이
+  int left;                          // bitmap_left (Bearing.x)
+  int top;                           // bitmap_top (Bearing.y)
+  unsigned int advance;              // advance.x (1/64 px 단위)
+  std::vector<unsigned char> pixels; // width x rows x 채널 개수 크기의 8-bit bitmap
+};
+
+/**
+ * face 로 codepoint 의 glyph 를 renderMode 형태로 rasterize 해서 out 에 저장 (실패하면 false 반환)
+ *
+ * codepoint 에 GLYPH_INDEX_FLAG 가 설정되어 있으면 cmap 을 거치지 않고 나머지 비트를 glyph index 로 사용함.
+ * worker 스레드와 GlyphCache 의 동기 로드 경로가 똑같은 결과를 만들도록 공유하는 함수이며,
+ * SDF 모드에서는 거리가 퍼져나갈 여백만큼 bitmap 크기와 bearing 이 늘어남.
+ */
+bool rasterizeGlyph(FT_Face face, unsigned int codepoint, GlyphRenderMode renderMode, RasterizedGlyph &out);
+
+/*
+  GlyphRasterizer 클래스
+
+  glyph rasterize 작업을 여러 worker 스레드에 나눠서 처리하는 rasterization 단계.
+
+  FT_Face 는 스레드 안전하지 않기 때문에, 각 worker 스레드는 자신만의 FT_Library / FT_Face 를 생성해서 사용함.
+  단, 모든 worker 의 FT_Face 는 FT_New_Memory_Face() 로 같은 폰트 바이트를 읽기 전용으로 공유하므로 폰트 파일을 스레드마다 다시 읽지 않음.
+  rasterize 가 끝난 glyph 는 lock-free 큐(BoundedQueue)에 넣어두고,
+  GL 스레드는 poll() 로 결과를 꺼내서 아틀라스에 업로드함.
+
+  따라서 대량의 glyph 를 미리 로드하는 startup 시간과 처음 사용되는 glyph 들의 rasterize 지연 시간이
+  CPU 코어 개수에 비례해서 줄어듦.
+*/
+class GlyphRasterizer
+{
+public:
+  /**
+   * GlyphRasterizer 클래스 생성자 (threadCount 가 0 이면 하드웨어 스레드 개수만큼 worker 생성)
+   *
+   * fontData 는 폰트 파일 전체 바이트이며 (내장 리소스 또는 메모리 매핑), GlyphRasterizer 보다 오래 유지되어야 함.
+   */
+  GlyphRasterizer(const unsigned char *fontData, size_t fontSize, unsigned int pixelSize,
+                  GlyphRenderMode renderMode = GLYPH_RENDER_BITMAP, unsigned int threadCount = 0);
+
+  // GlyphRasterizer 클래스 소멸자 (남은 작업을 취소하고 worker 스레드 종료)
+  ~GlyphRasterizer();
+
+  // codepoint 의 rasterize 작업 요청
+  void request(unsigned int codepoint);
+
+  // 여러 codepoint 의 rasterize 작업을 한꺼번에 요청 (worker 들을 한 번에 깨움)
+  void request(const unsigned int *codepoints, size_t count);
+
+  /**
+   * rasterize 가 끝난 glyph 하나를 꺼냄 (없으면 기다리지 않고 NULL 반환)
+   *
+   * 꺼낸 결과는 호출한 쪽에서 사용 후 delete 해야 함.
+   */
+  RasterizedGlyph *poll();
+
+  unsigned int getThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+
+private:
+  // worker 스레드 본체
+  void workerMain();
+
+  const unsigned char *fontData;
+  size_t fontSize;
+  unsigned int pixelSize;
+  GlyphRenderMode renderMode;
+
+  std::vector<std::thread> workers;
+
+  // 요청된 작업 큐 (producer 는 GL 스레드 하나이고 worker 들이 대기해야 하므로 condition variable 과 함께 사용)
+  std::mutex jobMutex;
+  std::condition_variable jobReady;
+  std::deque<unsigned int> jobs;
+  std::atomic<bool> stopping;
+
+  // rasterize 결과 큐 (여러 worker 가 동시에 넣고 GL 스레드가 꺼냄)
+  BoundedQueue<RasterizedGlyph *> results;
+
+  // 복사 방지 (worker 스레드 중복 join 방지)
+  GlyphRasterizer(const GlyphRasterizer &);
+  GlyphRasterizer &operator=(const GlyphRasterizer &);
+};
+
+#endif // GLYPH_RASTERIZER_HPP
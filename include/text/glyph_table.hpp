@@ -0,0 +1,89 @@
+#ifndef GLYPH_TABLE_HPP
+#define GLYPH_TABLE_HPP
+
+#include <cstddef> // size_t
+#include <vector>  // std::vector
+
+/*
+  GlyphTable 클래스
+
+  codepoint -> glyph 번호(GlyphMetrics 의 dense index)를 O(1) 로 찾기 위한 glyph 테이블.
+
+  std::map<GLchar, Character> 는 red-black tree 이므로 glyph 를 하나 찾을 때마다
+  여러 노드를 따라가는 포인터 추적(pointer chasing)이 발생하고,
+  operator[] 로 조회하면 없는 문자에 대해 기본값 노드를 새로 삽입하기까지 함.
+
+  GlyphTable 은 대부분의 UI 텍스트가 속하는 ASCII/Latin-1 범위(U+0000 ~ U+00FF)는
+  codepoint 를 그대로 index 로 사용하는 배열에 저장하고,
+  나머지 유니코드 codepoint 는 linear probing 방식의 open-addressing 해시 테이블에 저장함.
+
+  조회 함수 find() 는 const 이며, 없는 codepoint 에 대해서는 NO_INDEX 를 반환할 뿐 테이블을 변경하지 않음.
+
+  glyph metrices 자체는 GlyphMetrics 에 필드별 배열로 저장되고 테이블에는 4 byte 번호만 들어가므로,
+  dense 배열은 1 KB 이고 해시 테이블 slot 도 (codepoint, 번호) 8 byte 임.
+*/
+class GlyphTable
+{
+public:
+  // codepoint 를 그대로 index 로 사용하는 dense 배열의 범위 (ASCII + Latin-1)
+  static const unsigned int DENSE_RANGE = 256;
+
+  // codepoint 가 테이블에 없음을 나타내는 glyph 번호 (GlyphMetrics::NO_GLYPH 와 같은 값)
+  static const unsigned int NO_INDEX = 0xFFFFFFFFu;
+
+  // GlyphTable 클래스 생성자
+  GlyphTable();
+
+  // codepoint 에 대응되는 glyph 번호를 추가 (이미 있으면 덮어씀)
+  void insert(unsigned int codepoint, unsigned int index);
+
+  // codepoint 에 대응되는 glyph 번호를 찾아서 반환 (없으면 NO_INDEX)
+  unsigned int find(unsigned int codepoint) const
+  {
+    if (codepoint < DENSE_RANGE)
+    {
+      return dense[codepoint];
+    }
+    return findSparse(codepoint);
+  }
+
+  // codepoint 에 대응되는 glyph 를 제거 (제거된 glyph 가 있으면 true 반환)
+  bool erase(unsigned int codepoint);
+
+  // 저장된 모든 glyph 제거
+  void clear();
+
+  // 저장된 glyph 개수
+  size_t size() const { return denseCount + sparseCount; }
+
+  // 테이블이 차지하는 메모리 (dense 배열 + 할당된 해시 테이블 slot)
+  size_t getMemoryBytes() const { return sizeof(dense) + slots.capacity() * sizeof(Slot); }
+
+private:
+  // 해시 테이블 slot 이 비어있음을 나타내는 key (유니코드 범위 밖의 값)
+  static const unsigned int EMPTY_KEY = 0xFFFFFFFFu;
+
+  struct Slot
+  {
+    unsigned int key;
+    unsigned int value;
+  };
+
+  // dense 배열 범위 밖의 codepoint 를 해시 테이블에서 찾음
+  unsigned int findSparse(unsigned int codepoint) const;
+
+  // codepoint 를 해시 테이블의 시작 slot index 로 변환
+  size_t slotIndex(unsigned int codepoint) const;
+
+  // 해시 테이블 크기를 newCapacity(2의 거듭제곱)로 늘리고 기존 항목들을 다시 배치
+  void rehash(size_t newCapacity);
+
+  unsigned int dense[DENSE_RANGE]; // 비어있는 codepoint 는 NO_INDEX
+  size_t denseCount;
+
+  std::vector<Slot> slots; // 크기는 항상 2의 거듭제곱 (index 계산 시 나머지 연산 대신 bit mask 사용)
+  size_t sparseCount;
+  unsigned int shift; // 32 - log2(slot 개수) -> slotIndex() 에서 해시값의 상위 bit 만 남기기 위한 shift 량
+};
+
+#endif // GLYPH_TABLE_HPP
@@ -0,0 +1,93 @@
+#ifndef KERNING_TABLE_HPP
+#define KERNING_TABLE_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <cstddef> // size_t
+#include <vector>  // std::vector
+
+/*
+  KerningTable 클래스
+
+  FT_Face 의 kerning 값을 미리 추출해서 (왼쪽 codepoint, 오른쪽 codepoint) 쌍으로 조회하는 hash table.
+
+  FT_Get_Kerning() 은 호출할 때마다 두 codepoint 의 glyph index 를 조회하고 'kern' 테이블을 탐색하므로
+  layout 루프에서 인접한 문자 쌍마다 호출하기에는 무거움.
+  그래서 face 와 pixel size 가 정해진 시점에 한 번만 kerning 이 있는 쌍들을 추출해서 px 단위 값으로 저장해두고,
+  layout 루프에서는 인접한 쌍마다 lookup() 한 번(대부분 한 번의 probe)으로 kerning 을 적용함.
+
+  hash table 은 open addressing(linear probing) 방식이며, 항상 절반 이상이 비어있도록 크기를 잡으므로
+  kerning 이 없는 쌍도 빈 슬롯을 만나는 즉시 0 을 반환함.
+
+  FreeType 은 GPOS 테이블의 kerning 은 읽지 않으므로, 'kern' 테이블이 없는 폰트(Antonio-Bold 등)에서는 테이블이 비어있음.
+*/
+class KerningTable
+{
+public:
+  // KerningTable 클래스 생성자
+  KerningTable();
+
+  /**
+   * face 의 현재 pixel size 로 [first, last] 범위 codepoint 쌍들의 kerning 추출 (추출된 쌍의 개수 반환)
+   *
+   * unfitted 가 true 면 pixel 격자에 맞추지 않은 kerning 을 사용하며,
+   * hinting 없이 rasterize 해서 확대/축소하는 SDF / MSDF glyph 에는 unfitted 값을 사용해야 함.
+   */
+  size_t build(FT_Face face, unsigned int first, unsigned int last, bool unfitted);
+
+  // 추출된 모든 쌍 제거
+  void clear();
+
+  // left 다음에 right 가 올 때 pen 위치에 더할 kerning (px 단위, 없으면 0)
+  float lookup(unsigned int left, unsigned int right) const
+  {
+    if (count == 0)
+    {
+      return 0.0f;
+    }
+
+    unsigned long long key = makeKey(left, right);
+    for (size_t i = hashKey(key) & mask;; i = (i + 1) & mask)
+    {
+      const Entry &entry = entries[i];
+      if (entry.key == key)
+      {
+        return entry.value;
+      }
+      if (entry.key == EMPTY_KEY)
+      {
+        return 0.0f;
+      }
+    }
+  }
+
+  size_t size() const { return count; }
+
+private:
+  struct Entry
+  {
+    unsigned long long key; // (left << 32) | right
+    float value;            // px 단위 kerning
+  };
+
+  // 유효한 codepoint 는 0x10FFFF 이하이므로, 상위 32 bit 가 모두 1 인 키는 빈 슬롯 표시로 사용 가능
+  static const unsigned long long EMPTY_KEY = ~0ull;
+
+  static unsigned long long makeKey(unsigned int left, unsigned int right)
+  {
+    return (static_cast<unsigned long long>(left) << 32) | right;
+  }
+
+  // 연속된 codepoint 쌍들이 인접한 슬롯에 몰리지 않도록 곱셈 hash (Fibonacci hashing) 로 섞음
+  static size_t hashKey(unsigned long long key)
+  {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+  }
+
+  std::vector<Entry> entries; // 크기는 항상 2의 거듭제곱
+  size_t mask;
+  size_t count;
+};
+
+#endif // KERNING_TABLE_HPP
@@ -0,0 +1,29 @@
+#ifndef MSDF_GENERATOR_HPP
+#define MSDF_GENERATOR_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <vector> // std::vector
+
+/**
+ * FreeType glyph 외곽선으로부터 multi-channel signed distance field(MSDF) bitmap 생성
+ *
+ * 하나의 거리값만 저장하는 SDF 는 텍셀 사이를 선형 보간하면서 glyph 의 뾰족한 모서리가 둥글게 뭉개지는데,
+ * MSDF 는 외곽선을 이루는 edge 들에 색(R, G, B 채널 조합)을 칠해서 모서리에서 만나는 두 edge 의 거리를 서로 다른 채널에 저장해두고,
+ * fragment shader 에서 세 채널의 중간값(median)을 외곽선까지의 거리로 사용해서 모서리를 날카롭게 복원함. (Viktor Chlumsky 의 msdfgen 방식)
+ *
+ * 1. FT_Outline_Decompose() 로 외곽선을 직선 / 2차 베지어 곡선 edge 들로 분해 (3차 곡선은 2차 곡선 여러 개로 근사)
+ * 2. 각 contour 의 모서리(corner)를 찾아서 모서리 사이의 edge 묶음마다 CYAN / MAGENTA / YELLOW 를 번갈아 칠함
+ * 3. 각 픽셀마다 채널별로 그 채널을 포함하는 가장 가까운 edge 까지의 signed pseudo-distance 를 계산
+ *
+ * outline 은 FT_Set_Pixel_Sizes() 로 크기가 지정된 상태에서 로드된 외곽선(26.6 pixel 좌표)이어야 하며,
+ * 결과는 사방에 spread 만큼의 여백을 포함한 width x height x 3 크기의 RGB bitmap 으로 저장되고,
+ * bitmap 좌상단의 glyph 원점 기준 위치를 left, top 에 기록함. (외곽선이 비어있으면 false 반환)
+ *
+ * 거리값 인코딩은 generateSdf() 와 같음. (외곽선 = 0.5, 안쪽으로 spread 만큼 들어가면 1.0)
+ */
+bool generateMsdf(FT_Outline *outline, int spread, std::vector<unsigned char> &msdf,
+                  int &width, int &height, int &left, int &top);
+
+#endif // MSDF_GENERATOR_HPP
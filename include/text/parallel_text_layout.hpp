@@ -0,0 +1,136 @@
+#ifndef PARALLEL_TEXT_LAYOUT_HPP
+#define PARALLEL_TEXT_LAYOUT_HPP
+
+#include <glm/glm.hpp>           // glm 라이브러리
+#include <text/glyph_cache.hpp>  // glyph metrices 및 아틀라스 페이지
+#include <text/text_batcher.hpp> // TextBatchKey, TextBatchMode, 정점 자료형
+#include <text/text_layout.hpp>  // GL 독립적인 layout 단계
+#include <text/text_shaper.hpp>  // HarfBuzz shaping 단계
+#include <text/text_view.hpp>    // 복사 없는 문자열 참조
+#include <utils/job_system.hpp>  // work-stealing job system
+#include <cstddef>               // size_t
+#include <vector>                // std::vector
+
+/**
+ * 한 프레임에 그릴 서로 독립적인 텍스트 블록 (라벨 하나)
+ *
+ * text 는 문자열을 복사하지 않고 가리키기만 하므로 build() 가 끝날 때까지 유효해야 하며, NULL 종료 문자열일 필요는 없음.
+ */
+struct TextBlock
+{
+  TextView text;
+  float x; // pen 원점
+  float y;
+  float scale;
+  glm::vec4 color;
+  unsigned int features; // TextFeature 비트 조합
+};
+
+/*
+  ParallelTextLayout 클래스
+
+  매 프레임 내용이 바뀌는 수백 개의 라벨을 GL 스레드에서 하나씩 layout 하는 대신,
+  텍스트 블록마다의 layout 과 정점 데이터 생성을 JobSystem 의 worker 들에게 나눠서 병렬로 처리함.
+
+  build() 는 아래 순서로 진행되며, GL 스레드가 직접 하는 일은 shaping(캐시 조회)과 처음 사용되는 glyph 의 업로드뿐임.
+    1. (GL 스레드) TextShaper 가 있으면 블록마다 shaping 된 run 을 가져옴 (FT_Face 는 스레드 안전하지 않음)
+    2. (worker 들) 블록마다 TextLayout 으로 layout 하고, glyph 가 모두 캐시에 있으면 바로 정점 데이터까지 생성
+    3. (GL 스레드) 캐시에 없던 glyph 들을 한꺼번에 preload() 하고, 해당 블록들만 2 를 다시 실행
+       (preload() 도중 페이지가 제거되었다면 이미 만든 정점 데이터의 uv 가 무효이므로 모든 블록을 다시 실행)
+
+  worker 는 GlyphCache 를 읽기만 하고(peek(), getPageTexture()), 정점 데이터는 worker 별 arena 버퍼에만 기록하므로
+  worker 끼리 lock 이나 공유 쓰기가 없음. arena 는 프레임마다 비우고 재사용하므로 steady state 에서는 메모리를 새로 할당하지 않음.
+
+  submit() 은 GL 스레드에서 블록 순서대로 arena 의 정점 데이터를 TextBatcher 에 이어붙이므로,
+  같은 batch key 안에서의 그리기 순서는 블록 순서와 같음.
+*/
+class ParallelTextLayout
+{
+public:
+  // 가장 최근 build() / submit() 의 통계
+  struct Stats
+  {
+    unsigned int blocks;    // layout 한 텍스트 블록 개수
+    unsigned int glyphs;    // 생성된 glyph 2D Quad 개수
+    unsigned int relayouts; // glyph 업로드 때문에 다시 layout 한 블록 개수
+    double layoutMs;        // build() 에 걸린 시간
+    double submitMs;        // submit() 에 걸린 시간
+  };
+
+  // ParallelTextLayout 클래스 생성자 (jobs, glyphs, shaper 는 ParallelTextLayout 보다 오래 살아있어야 함)
+  ParallelTextLayout(JobSystem &jobs, GlyphCache &glyphs, TextShaper *shaper = NULL);
+
+  // ParallelTextLayout 클래스 소멸자
+  ~ParallelTextLayout();
+
+  // 텍스트 블록들의 layout 과 mode 형식의 정점 데이터 생성을 병렬로 처리 (GL 스레드에서 호출)
+  void build(const TextBlock *blocks, size_t count, TextBatchMode mode);
+
+  // build() 결과를 블록 순서대로 TextBatcher 에 제출 (batcher 의 TextBatchMode 는 build() 에 넘긴 mode 와 같아야 함)
+  void submit(TextBatcher &batcher);
+
+  const Stats &getStats() const { return stats; }
+
+private:
+  // 같은 batch key 로 연속된 glyph 구간 (arena 의 정점 배열 내 위치, 정점 또는 인스턴스 단위)
+  struct Segment
+  {
+    TextBatchKey key;
+    unsigned int page;
+    size_t first;
+    size_t count;
+  };
+
+  // worker 하나가 한 프레임 동안 기록하는 정점 데이터
+  struct Arena
+  {
+    std::vector<TextVertex> vertices;
+    std::vector<TextInstance> instances;
+    std::vector<Segment> segments;
+    char padding[64]; // 인접한 arena 의 vector 헤더가 같은 캐시 라인에 놓여서 worker 끼리 false sharing 이 일어나지 않도록 떨어트림
+  };
+
+  // 블록 하나의 결과가 기록된 arena 와 segment 범위
+  struct BlockResult
+  {
+    unsigned int worker;
+    size_t firstSegment;
+    size_t segmentCount;
+    bool built; // 정점 데이터까지 생성되었는지 여부
+  };
+
+  // JobSystem 작업 함수 : context 는 ParallelTextLayout, index 는 jobBlocks 내 위치
+  static void layoutJob(void *context, size_t index, unsigned int worker);
+
+  // 블록 하나를 layout 하고, 완성되었다면(또는 force 면) worker 의 arena 에 정점 데이터 생성
+  void layoutBlock(size_t block, unsigned int worker, bool force);
+
+  // 모든 arena 비우기
+  void resetArenas();
+
+  JobSystem &jobs;
+  GlyphCache &glyphs;
+  TextShaper *shaper;
+
+  // 현재 build() 의 입력
+  const TextBlock *blocks;
+  TextBatchMode mode;
+  bool force; // 다시 layout 하는 단계 -> 아직 업로드하지 못한 glyph 가 있어도 나머지 glyph 로 정점 데이터를 생성
+
+  // 블록별 상태 (프레임마다 재사용)
+  std::vector<ShapedRun> runs;
+  std::vector<TextLayout> layouts;
+  std::vector<BlockResult> results;
+  std::vector<size_t> jobBlocks; // 이번 parallelFor() 에서 처리할 블록 번호
+  std::vector<unsigned int> missing;
+
+  std::vector<Arena *> arenas; // worker 번호로 접근
+
+  Stats stats;
+
+  // 복사 방지
+  ParallelTextLayout(const ParallelTextLayout &);
+  ParallelTextLayout &operator=(const ParallelTextLayout &);
+};
+
+#endif // PARALLEL_TEXT_LAYOUT_HPP
@@ -0,0 +1,61 @@
+#ifndef QUAD_KERNEL_HPP
+#define QUAD_KERNEL_HPP
+
+#include <text/text_batcher.hpp> // TextBatchMode, TextVertex, TextInstance
+#include <cstddef>               // size_t
+
+/**
+ * glyph 2D Quad 생성 커널의 입력 (structure-of-arrays)
+ *
+ * glyph 마다 필드 하나씩을 연속된 float 배열로 저장하므로, 커널은 한 번의 load 로 glyph 4개(SSE2) 또는 8개(AVX2)의 같은 필드를 읽음.
+ * bearing / size 는 scale 을 곱하기 전의 px 단위 값이며 (Character::Bearing, Character::Size), 원점은 glyph 원점(pen 위치 + shaping offset)임.
+ */
+struct QuadSource
+{
+  const float *originX;
+  const float *originY;
+  const float *bearingX;
+  const float *bearingY;
+  const float *sizeX;
+  const float *sizeY;
+  const float *u0; // 아틀라스 uv 영역 (u0, v0, u1, v1)
+  const float *v0;
+  const float *u1;
+  const float *v1;
+};
+
+/**
+ * 2D Quad 생성 커널 구현
+ *
+ * QUAD_KERNEL_SSE2 : glyph 4개씩 처리 (x86-64 에서는 항상 사용 가능)
+ * QUAD_KERNEL_AVX2 : glyph 8개씩 처리 (실행 중인 CPU 와 OS 가 AVX 레지스터를 지원할 때만 선택됨)
+ * 나머지 glyph 와 x86 이 아닌 CPU(Apple Silicon 등)는 QUAD_KERNEL_SCALAR 로 처리하며, 세 구현의 결과는 bit 단위로 같음.
+ */
+enum QuadKernel
+{
+  QUAD_KERNEL_SCALAR,
+  QUAD_KERNEL_SSE2,
+  QUAD_KERNEL_AVX2
+};
+
+// 현재 CPU 에서 사용할 수 있는 가장 넓은 커널
+QuadKernel detectQuadKernel();
+
+// 커널 이름 (로그 출력용)
+const char *quadKernelName(QuadKernel kernel);
+
+/**
+ * source 의 [first, first + count) 번째 glyph 들의 2D Quad 를 mode 형식으로 out 에 기록
+ *
+ * 각 glyph 의 좌하단 위치와 크기를 appendTextQuad() 와 같은 식으로 계산해서
+ * TEXT_BATCH_VERTICES 면 TextVertex 6개, TEXT_BATCH_INSTANCED 면 TextInstance 하나를 빈틈없이 이어서 기록함.
+ * out 은 그만큼의 공간이 확보된 버퍼(정점 배열 또는 매핑된 업로드 버퍼)여야 함.
+ */
+void generateQuads(const QuadSource &source, size_t first, size_t count, float scale, const glm::vec4 &color,
+                   TextBatchMode mode, void *out);
+
+// 커널을 직접 지정하는 버전 (CPU 가 지원하지 않는 커널을 지정하면 지원되는 가장 넓은 커널로 낮춰서 실행)
+void generateQuads(QuadKernel kernel, const QuadSource &source, size_t first, size_t count, float scale,
+                   const glm::vec4 &color, TextBatchMode mode, void *out);
+
+#endif // QUAD_KERNEL_HPP
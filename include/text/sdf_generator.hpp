@@ -0,0 +1,22 @@
+#ifndef SDF_GENERATOR_HPP
+#define SDF_GENERATOR_HPP
+
+#include <vector> // std::vector
+
+/**
+ * 8-bit coverage bitmap 으로부터 signed distance field(SDF) bitmap 생성
+ *
+ * 각 픽셀에 glyph 외곽선까지의 거리를 저장해두면, 텍스쳐를 확대/축소해서 샘플링하더라도
+ * 거리값은 선형 보간되므로 fragment shader 에서 외곽선(0.5)을 기준으로 선명한 coverage 를 다시 계산할 수 있음.
+ *
+ * 결과 bitmap 은 bitmap 바깥으로 거리가 퍼져나갈 여백(spread)을 사방에 포함하므로
+ * (width + 2 * spread) x (height + 2 * spread) 크기이며,
+ * 외곽선 위는 0.5, glyph 안쪽으로 spread 만큼 들어가면 1.0, 바깥쪽으로 spread 만큼 나가면 0.0 에 대응되는 값이 저장됨.
+ *
+ * 거리 계산은 Felzenszwalb & Huttenlocher 의 선형 시간 Euclidean distance transform 을 사용하며,
+ * anti-aliasing 된 가장자리 픽셀의 coverage 값을 sub-pixel 거리로 환산해서 초기값으로 사용함. (Mapbox TinySDF 방식)
+ */
+void generateSdf(const unsigned char *coverage, int width, int height, int pitch, int spread,
+                 std::vector<unsigned char> &sdf);
+
+#endif // SDF_GENERATOR_HPP
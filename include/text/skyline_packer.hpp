@@ -0,0 +1,64 @@
+#ifndef SKYLINE_PACKER_HPP
+#define SKYLINE_PACKER_HPP
+
+#include <cstddef> // size_t
+#include <vector>  // std::vector
+
+/*
+  SkylinePacker 클래스
+
+  glyph atlas 텍스쳐 안에 각 glyph bitmap 이 차지할 사각형 영역을 배치해주는
+  skyline(bottom-left) 방식의 rectangle packer.
+
+  아틀라스 상단부터 채워져 내려오는 영역의 경계선(= skyline)을
+  (x, y, width) 형태의 수평 선분 목록으로 관리하고,
+  새 사각형이 들어올 때마다 가장 낮은 위치(= y + height 가 최소인 위치)에 배치함.
+
+  OpenGL 과 무관한 순수 CPU 자료구조이므로, GL 컨텍스트 없이도 사용 가능함.
+*/
+class SkylinePacker
+{
+public:
+  // skyline 을 구성하는 수평 선분 하나
+  struct Node
+  {
+    int x;
+    int y;
+    int width;
+  };
+
+  // SkylinePacker 클래스 생성자
+  SkylinePacker(int width, int height);
+
+  // 주어진 크기의 사각형을 배치할 위치를 찾아 outX, outY 에 기록 (공간이 부족하면 false 반환)
+  bool pack(int width, int height, int &outX, int &outY);
+
+  // 모든 배치 정보를 지우고 빈 상태로 되돌림
+  void reset();
+
+  // 지금까지 배치된 사각형들이 차지하는 면적 (아틀라스 점유율 계산용)
+  long long getUsedArea() const { return usedArea; }
+
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+  // 현재 skyline 상태 (디스크 캐시에 아틀라스를 저장할 때, 이후 glyph 를 이어서 배치할 수 있도록 함께 저장)
+  const std::vector<Node> &getSkyline() const { return skyline; }
+
+  // 저장해 둔 skyline 상태로 되돌림
+  void restore(const std::vector<Node> &nodes, long long area);
+
+private:
+  // index 번째 선분부터 사각형을 놓았을 때의 y 좌표 계산 (놓을 수 없으면 -1 반환)
+  int fit(size_t index, int rectWidth, int rectHeight) const;
+
+  // index 위치에 새 선분을 추가하고, 새 선분에 가려지는 기존 선분들을 잘라내거나 병합
+  void addLevel(size_t index, int x, int y, int rectWidth, int rectHeight);
+
+  int width;
+  int height;
+  long long usedArea;
+  std::vector<Node> skyline;
+};
+
+#endif // SKYLINE_PACKER_HPP
@@ -0,0 +1,100 @@
+#ifndef STREAM_BUFFER_HPP
+#define STREAM_BUFFER_HPP
+
+#include <glad/glad.h> // OpenGL 함수를 초기화하기 위한 헤더
+#include <cstddef>     // size_t
+
+/**
+ * StreamBuffer 가 매 프레임 CPU 데이터를 GPU 버퍼에 써넣는 방식
+ */
+enum StreamBufferStrategy
+{
+  STREAM_BUFFER_PERSISTENT,     // glBufferStorage() 로 한 번만 persistent mapping 해두고 계속 직접 기록 (GL 4.4 / GL_ARB_buffer_storage)
+  STREAM_BUFFER_UNSYNCHRONIZED, // 매 프레임 현재 region 만 GL_MAP_UNSYNCHRONIZED_BIT 로 매핑해서 기록
+  STREAM_BUFFER_ORPHAN          // 매 프레임 glBufferData(NULL) 로 버퍼 메모리를 새로 할당(orphaning)한 뒤 매핑해서 기록
+};
+
+/*
+  StreamBuffer 클래스
+
+  매 프레임 내용이 바뀌는 정점 데이터를 GPU 가 직접 읽을 수 있는 메모리에 써넣기 위한 ring buffer.
+
+  버퍼를 regionCount 개의 프레임 단위 region 으로 나누고, 프레임마다 다음 region 에 데이터를 기록함.
+  각 region 을 사용하는 draw call 뒤에는 glFenceSync() 로 fence 를 걸어두고,
+  ring 을 한 바퀴 돌아 같은 region 을 다시 쓰기 전에 해당 fence 만 확인하므로,
+  glBufferSubData() 처럼 아직 GPU 가 읽고 있는 버퍼를 덮어쓰려다 암묵적으로 동기화(stall)되는 일이 없음.
+
+  fence 를 기다린 시간은 통계로 노출하므로, 이 값이 0 보다 커지면 region 개수나 크기가 부족하다는 뜻임.
+
+  사용 순서 : map() -> (데이터 기록) -> unmap() -> (draw call) -> fence()
+*/
+class StreamBuffer
+{
+public:
+  struct Stats
+  {
+    double lastFenceWaitMs;  // 가장 최근 map() 에서 fence 를 기다린 시간
+    double totalFenceWaitMs; // 생성 이후 fence 를 기다린 누적 시간
+    unsigned int stalls;     // fence 가 아직 signal 되지 않아 실제로 기다려야 했던 횟수
+    unsigned int reallocations;
+  };
+
+  unsigned int ID; // GPU 버퍼 객체의 참조 ID
+
+  /**
+   * StreamBuffer 클래스 생성자
+   *
+   * STREAM_BUFFER_PERSISTENT 를 요청했더라도 현재 컨텍스트가 buffer storage 를 지원하지 않으면
+   * STREAM_BUFFER_UNSYNCHRONIZED 로 대체함. (실제 사용 중인 방식은 getStrategy() 로 확인)
+   */
+  StreamBuffer(GLenum target, size_t regionSize, int regionCount = 3,
+               StreamBufferStrategy strategy = STREAM_BUFFER_PERSISTENT);
+
+  // StreamBuffer 클래스 소멸자
+  ~StreamBuffer();
+
+  /**
+   * 현재 region 에서 size byte 를 기록할 수 있는 포인터를 반환하고,
+   * 해당 데이터가 버퍼 내에서 시작하는 위치를 offset 에 기록함.
+   *
+   * size 가 region 크기보다 크면 버퍼를 더 크게 재할당하며, 이 경우 ID 가 바뀔 수 있으므로
+   * vertex attribute 는 map() 이후에 바인딩해야 함.
+   */
+  void *map(size_t size, size_t &offset);
+
+  // map() 으로 기록한 데이터를 GPU 에 반영
+  void unmap();
+
+  // 현재 region 을 사용하는 draw call 이후에 호출하여 fence 를 걸고 다음 region 으로 넘어감
+  void fence();
+
+  StreamBufferStrategy getStrategy() const { return strategy; }
+  const Stats &getStats() const { return stats; }
+
+private:
+  // 주어진 region 크기로 GPU 버퍼 메모리 할당
+  void allocate(size_t newRegionSize);
+
+  // 할당된 GPU 버퍼 메모리 및 fence 해제
+  void release();
+
+  // 주어진 region 의 fence 가 signal 될 때까지 대기
+  void waitRegion(int region);
+
+  GLenum target;
+  size_t regionSize;
+  int regionCount;
+  int currentRegion;
+  StreamBufferStrategy strategy;
+
+  unsigned char *persistentPtr; // STREAM_BUFFER_PERSISTENT 모드에서 버퍼 전체를 매핑해 둔 포인터
+  GLsync fences[8];             // region 별 fence (최대 8개 region 까지 지원)
+
+  Stats stats;
+
+  // 복사 방지 (GL 객체 중복 해제 방지)
+  StreamBuffer(const StreamBuffer &);
+  StreamBuffer &operator=(const StreamBuffer &);
+};
+
+#endif // STREAM_BUFFER_HPP
@@ -0,0 +1,318 @@
+#ifndef TEXT_BATCHER_HPP
+#define TEXT_BATCHER_HPP
+
+#include <glad/glad.h>            // OpenGL 함수를 초기화하기 위한 헤더
+#include <glm/glm.hpp>            // glm 라이브러리
+#include <shader/shader.hpp>      // Shader 클래스
+#include <shader/shader_library.hpp> // 쉐이더 permutation 관리
+#include <text/stream_buffer.hpp> // glyph 데이터 스트리밍용 ring buffer
+#include <cstddef>                // size_t
+#include <string>                 // std::string
+#include <vector>                 // std::vector
+
+/**
+ * TextBatcher 가 VBO 에 업로드하는 glyph 2D Quad 의 정점 자료형
+ *
+ * 문자열마다 uniform 으로 전송하던 텍스트 색상을 정점 데이터로 옮겨서,
+ * 색상이 서로 다른 문자열들도 하나의 draw call 로 묶어서 그릴 수 있도록 함.
+ */
+struct TextVertex
+{
+  float Vertex[4];          // position(xy) + uv(zw) -> text.vs 의 vertex attribute 와 동일한 구성
+  unsigned char Color[4];   // 정규화된 8-bit RGBA 텍스트 색상
+};
+
+/**
+ * 인스턴싱 모드에서 glyph 하나당 업로드하는 per-instance 데이터
+ *
+ * 정점 6개(= 6 x 20 bytes)를 매번 채워 넣는 대신, 정적인 unit quad 하나를 모든 glyph 가 공유하고
+ * glyph 마다 (위치, 크기, uv 영역, 색상) 36 bytes 만 업로드하면 text.vs 의 INSTANCED variant 가 unit quad 를 glyph 크기로 펼쳐줌.
+ */
+struct TextInstance
+{
+  float Rect[4];          // 2D Quad 좌하단 위치(xy) + 크기(zw)
+  float UV[4];            // 아틀라스 uv 영역 (u0, v0, u1, v1)
+  unsigned char Color[4]; // 정규화된 8-bit RGBA 텍스트 색상
+};
+
+/**
+ * glyph 2D Quad 를 GPU 로 전달하는 방식
+ */
+enum TextBatchMode
+{
+  TEXT_BATCH_VERTICES, // glyph 마다 정점 6개를 업로드하고 glDrawArrays() 로 렌더링 (text.vs)
+  TEXT_BATCH_INSTANCED // glyph 마다 TextInstance 하나를 업로드하고 glDrawArraysInstanced() 로 렌더링 (text.vs 의 INSTANCED variant)
+};
+
+/**
+ * 텍스트 쉐이더의 기능 플래그 (비트 조합으로 batch key 에 지정)
+ *
+ * 조합마다 해당 기능의 define 만 주입한 쉐이더 permutation 을 사용하므로,
+ * 효과가 없는 텍스트는 분기나 사용하지 않는 uniform 이 없는 가장 단순한 쉐이더로 그려짐.
+ * OUTLINE / SHADOW 는 distance field 가 있어야 계산할 수 있으므로 SDF 또는 MSDF 와 함께 지정해야 하며, 단독으로 지정하면 무시됨.
+ */
+enum TextFeature
+{
+  TEXT_FEATURE_NONE = 0,    // grayscale bitmap 아틀라스
+  TEXT_FEATURE_SDF = 1,     // signed distance field 아틀라스 (GLYPH_RENDER_SDF)
+  TEXT_FEATURE_MSDF = 2,    // multi-channel SDF 아틀라스 (GLYPH_RENDER_MSDF)
+  TEXT_FEATURE_OUTLINE = 4, // 외곽선 테두리 (TextBatcher::setOutline())
+  TEXT_FEATURE_SHADOW = 8   // 그림자 (TextBatcher::setShadow())
+};
+
+// 기능 플래그 조합의 개수 (TextFeature 비트 개수 = 4)
+const unsigned int TEXT_FEATURE_COMBINATIONS = 16;
+
+/**
+ * 동일한 draw call 로 묶일 수 있는지 판단하는 기준 (쉐이더 기능 조합, 아틀라스 텍스쳐, blending 상태)
+ */
+enum TextBlendMode
+{
+  TEXT_BLEND_ALPHA,   // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+  TEXT_BLEND_ADDITIVE // glBlendFunc(GL_SRC_ALPHA, GL_ONE)
+};
+
+struct TextBatchKey
+{
+  unsigned int features; // TextFeature 비트 조합
+  unsigned int texture;
+  TextBlendMode blend;
+
+  bool operator==(const TextBatchKey &other) const
+  {
+    return features == other.features && texture == other.texture && blend == other.blend;
+  }
+
+  bool operator<(const TextBatchKey &other) const
+  {
+    if (features != other.features)
+      return features < other.features;
+    if (blend != other.blend)
+      return blend < other.blend;
+    return texture < other.texture;
+  }
+};
+
+/**
+ * glyph 2D Quad 하나를 mode 에 맞는 형태로 정점 배열에 추가 (TEXT_BATCH_VERTICES 면 vertices 에 정점 6개, TEXT_BATCH_INSTANCED 면 instances 에 하나)
+ *
+ * TextBatcher 의 매 프레임 batch 와 TextMesh 의 retained 정점 데이터가 같은 형식을 사용하도록 공유하는 함수
+ */
+void appendTextQuad(TextBatchMode mode, float x, float y, float w, float h, const glm::vec4 &uv, const glm::vec4 &color,
+                    std::vector<TextVertex> &vertices, std::vector<TextInstance> &instances);
+
+class GlyphCache;
+class TextLayout;
+class TextMesh;
+
+/*
+  TextBatcher 클래스
+
+  한 프레임 동안 submitQuad() / submitLayout() 으로 제출된 모든 glyph 2D Quad 를 모아두었다가,
+  프레임 마지막에 flush() 를 호출하면 (쉐이더, blending 상태, 아틀라스 텍스쳐) 순으로 정렬하여
+  같은 batch key 를 갖는 glyph 들을 한 번의 draw call 로 렌더링함.
+
+  따라서 draw call 횟수는 문자열 개수가 아니라 서로 다른 batch key(대부분 아틀라스 페이지) 개수에 비례함.
+
+  TEXT_BATCH_INSTANCED 모드에서는 batch key 마다 glDrawArraysInstanced() 한 번으로 렌더링함.
+
+  쉐이더는 batch key 의 기능 플래그 조합마다 ShaderLibrary 에서 permutation 을 찾아서 사용하며,
+  INSTANCED define 은 TextBatchMode 에 따라 TextBatcher 가 직접 추가함.
+  처음 사용되는 조합은 flush() 도중 컴파일을 기다리게 되므로, 사용할 조합은 시작 시점에 preloadVariant() 로 미리 제출해 두는 것이 좋음.
+
+  내용이 바뀌지 않는 문자열은 매 프레임 submitQuad() 로 다시 제출하는 대신 TextMesh 로 만들어두고 submitMesh() 로 제출하면,
+  layout 과 업로드 없이 TextMesh 가 보관한 정점 데이터를 그대로 그리기만 함.
+
+  렌더링 순서
+    - 매 프레임 제출된 glyph 와 TextMesh 의 segment 는 하나의 draw 목록에서 batch key 순으로 정렬되어 그려짐.
+      (TextMesh 를 그리느라 이미 적용한 쉐이더, blending 상태, 아틀라스 텍스쳐를 다시 바꾸지 않음)
+    - 같은 batch key 안에서는 submitQuad() / submitLayout() 등으로 제출된 glyph 들이 제출 순서대로 먼저 그려지고,
+      그 다음 TextMesh 들이 submitMesh() 순서대로 그려짐.
+    - 같은 버퍼에서 바로 이어지는 같은 batch key 의 구간들은 한 번의 draw call 로 합쳐지지만,
+      TextMesh 는 각자 버퍼 객체를 가지므로 TextMesh 마다 batch key 당 draw call 이 한 번씩 발생함.
+  서로 다른 batch key 사이의 렌더링 순서는 제출 순서가 아닌 정렬 순서를 따르므로,
+  겹쳐서 그려지는 텍스트 사이의 앞뒤 관계가 중요하다면 같은 batch key 를 사용해야 함.
+*/
+class TextBatcher
+{
+public:
+  // flush() 한 번(= 한 프레임)에 대한 통계
+  struct Stats
+  {
+    unsigned int glyphs;        // 렌더링된 glyph 2D Quad 개수
+    unsigned int drawCalls;     // 발생한 draw call 횟수
+    unsigned int uploadedBytes; // VBO 에 업로드된 정점(또는 per-instance) 데이터 크기
+    double fenceWaitMs;         // StreamBuffer 의 region 이 비워지기를 기다린 시간 (0 보다 크면 ring buffer 가 부족하다는 뜻)
+    unsigned int meshes;        // 그려진 TextMesh 개수
+    unsigned int meshRebuilds;  // 그 중 내용이나 아틀라스가 바뀌어서 다시 layout 된 TextMesh 개수
+  };
+
+  /**
+   * TextBatcher 클래스 생성자
+   *
+   * vertexPath / fragmentPath 는 기능 define 으로 permutation 을 만들 텍스트 쉐이더 소스이며 (text.vs, text.fs),
+   * 쉐이더 permutation 들은 shaders 에 등록되므로 shaders 는 TextBatcher 보다 오래 살아있어야 함.
+   */
+  TextBatcher(ShaderLibrary &shaders, const GLchar *vertexPath, const GLchar *fragmentPath,
+              TextBatchMode mode = TEXT_BATCH_VERTICES, StreamBufferStrategy strategy = STREAM_BUFFER_PERSISTENT);
+
+  // TextBatcher 클래스 소멸자
+  ~TextBatcher();
+
+  /**
+   * 좌하단 위치 (x, y), 크기 (w, h), 아틀라스 uv 영역 (u0, v0, u1, v1), 색상을 가진
+   * glyph 2D Quad 하나를 주어진 batch key 의 정점 배열에 추가함.
+   */
+  void submitQuad(const TextBatchKey &key, float x, float y, float w, float h, const glm::vec4 &uv, const glm::vec4 &color);
+
+  /**
+   * TextLayout 의 positioned glyph 들을 주어진 기능 플래그와 색상의 2D Quad 로 제출하고, 사용된 아틀라스 페이지들을 LRU 제거 대상에서 제외시킴.
+   *
+   * layout 이후 glyph 캐시의 페이지가 제거되어 uv 가 무효화되었다면 아무것도 제출하지 않고 false 반환 (다시 layout 해야 함)
+   */
+  bool submitLayout(const TextLayout &layout, GlyphCache &glyphs, unsigned int features, const glm::vec4 &color);
+
+  /**
+   * appendTextQuad() 로 미리 만들어 둔 glyph 데이터를 주어진 batch key 의 정점 배열 끝에 그대로 이어붙임
+   *
+   * 다른 스레드에서 병렬로 생성한 정점 데이터(ParallelTextLayout)를 GL 스레드에서 합칠 때 사용하며,
+   * TextBatchMode 에 맞는 쪽만 받아들임. (TEXT_BATCH_VERTICES 면 submitVertices(), TEXT_BATCH_INSTANCED 면 submitInstances())
+   */
+  void submitVertices(const TextBatchKey &key, const TextVertex *vertices, size_t count);
+  void submitInstances(const TextBatchKey &key, const TextInstance *instances, size_t count);
+
+  /**
+   * 이번 프레임에 TextMesh 를 그리도록 제출
+   *
+   * TextMesh 의 내용이 바뀌었거나 참조하던 아틀라스 페이지가 제거되었다면 이 때 다시 layout 하며,
+   * 그렇지 않으면 TextMesh 가 사용하는 아틀라스 페이지들을 LRU 제거 대상에서 제외시키기만 함.
+   * TextMesh 는 flush() 가 끝날 때까지 살아있어야 함.
+   */
+  void submitMesh(TextMesh &mesh);
+
+  // 지금까지 제출된 glyph 들과 TextMesh 들을 batch key 순으로 렌더링하고, 다음 프레임을 위해 비움 (렌더링 순서는 클래스 설명 참고)
+  void flush();
+
+  // 기능 플래그 조합의 쉐이더 permutation 을 미리 컴파일 제출 (결과 확인은 처음 사용될 때까지 미룸)
+  void preloadVariant(unsigned int features);
+
+  // 모든 permutation 이 공유하는 uniform 값 (다음 flush() 부터 적용)
+  void setProjection(const glm::mat4 &projection) { this->projection = projection; }
+
+  // TEXT_FEATURE_OUTLINE 테두리 색상과 두께 (두께는 distance field 거리값 단위, 0 ~ 0.5)
+  void setOutline(const glm::vec4 &color, float width)
+  {
+    outlineColor = color;
+    outlineWidth = width;
+  }
+
+  // TEXT_FEATURE_SHADOW 그림자 색상과 위치 (아틀라스 texel 단위, distance field 의 spread 를 넘어가면 그림자가 잘림)
+  void setShadow(const glm::vec4 &color, const glm::vec2 &offset)
+  {
+    shadowColor = color;
+    shadowOffset = offset;
+  }
+
+  TextBatchMode getMode() const { return mode; }
+
+  // 가장 최근 flush() 의 통계
+  const Stats &getStats() const { return stats; }
+
+  // glyph 데이터 스트리밍에 사용하는 ring buffer (누적 fence 대기 시간, 실제 사용 중인 매핑 방식 등 확인용)
+  const StreamBuffer &getStreamBuffer() const { return stream; }
+
+private:
+  // batch key 하나에 대응되는 정점 배열 (모드에 따라 둘 중 하나만 사용)
+  struct Bucket
+  {
+    TextBatchKey key;
+    std::vector<TextVertex> vertices;
+    std::vector<TextInstance> instances;
+
+    // 이번 프레임에 제출된 glyph 개수
+    size_t glyphCount() const { return vertices.size() / 6 + instances.size(); }
+  };
+
+  // 주어진 batch key 에 대응되는 Bucket 을 찾거나 새로 만듦
+  Bucket &findBucket(const TextBatchKey &key);
+
+  // 기능 플래그 조합 하나에 대응되는 쉐이더 permutation 과 미리 조회해 둔 uniform 핸들
+  struct Variant
+  {
+    Shader *shader; // 아직 사용된 적 없으면 NULL
+    UniformHandle projection;
+    UniformHandle text;
+    UniformHandle outlineColor;
+    UniformHandle outlineWidth;
+    UniformHandle shadowColor;
+    UniformHandle shadowOffset;
+  };
+
+  // 효과 플래그를 실제로 적용 가능한 조합으로 정리 (distance field 가 없으면 OUTLINE / SHADOW 제거)
+  static unsigned int normalizeFeatures(unsigned int features);
+
+  // 기능 플래그 조합에 대응되는 define 목록
+  std::vector<std::string> featureDefines(unsigned int features) const;
+
+  // 기능 플래그 조합의 쉐이더 permutation 을 찾아서 uniform 을 적용하고 활성화
+  void useVariant(unsigned int features);
+
+  // batch key 의 blending 상태 적용
+  void applyBlend(TextBlendMode blend);
+
+  // 버퍼 객체 내의 주어진 위치를 가리키도록 glyph 데이터 vertex attribute 를 지정
+  void bindAttributes(unsigned int buffer, size_t offset);
+
+  // draw call 하나로 그릴 수 있는 glyph 구간 (Bucket 이 업로드된 StreamBuffer 구간 또는 TextMesh 의 segment)
+  struct Draw
+  {
+    TextBatchKey key;
+    unsigned int buffer; // 정점 데이터가 있는 버퍼 객체
+    size_t offset;       // 버퍼 내 attribute 시작 위치 (byte)
+    GLint first;         // offset 기준 시작 정점 (또는 인스턴스)
+    GLsizei count;
+    size_t sequence;     // draw 목록에 추가된 순서 (같은 batch key 안에서 추가 순서를 유지하기 위한 정렬 기준)
+
+    bool operator<(const Draw &other) const
+    {
+      if (!(key == other.key))
+        return key < other.key;
+      return sequence < other.sequence;
+    }
+  };
+
+  // draw 목록을 batch key 순으로 정렬해서 렌더링 (같은 버퍼에서 이어지는 구간은 한 번의 draw call 로 합침)
+  void drawSorted();
+
+  TextBatchMode mode;
+  ShaderLibrary &shaders;
+  std::string vertexPath;
+  std::string fragmentPath;
+  Variant variants[TEXT_FEATURE_COMBINATIONS];
+
+  glm::mat4 projection;
+  glm::vec4 outlineColor;
+  float outlineWidth;
+  glm::vec4 shadowColor;
+  glm::vec2 shadowOffset;
+
+  StreamBuffer stream;  // 매 프레임 glyph 데이터를 기록하는 ring buffer
+  unsigned int VAO;
+  unsigned int quadVBO; // 인스턴싱 모드에서 모든 glyph 가 공유하는 정적 unit quad
+
+  // 프레임이 바뀌어도 Bucket 과 정점 배열을 재사용해서 steady state 에서는 메모리 재할당이 일어나지 않도록 함.
+  std::vector<Bucket> buckets;
+  size_t lastBucket; // 연속된 glyph 는 대부분 같은 batch key 를 가지므로, 직전에 사용한 Bucket 을 먼저 확인함.
+  std::vector<size_t> order;
+  std::vector<TextMesh *> meshes; // 이번 프레임에 제출된 TextMesh 들
+  std::vector<Draw> draws;        // 이번 flush() 에서 그릴 구간들
+  unsigned int pendingRebuilds;   // 이번 프레임에 submitMesh() 에서 다시 layout 된 TextMesh 개수 (flush() 에서 stats 로 옮김)
+
+  Stats stats;
+
+  // 복사 방지 (GL 객체 중복 해제 방지)
+  TextBatcher(const TextBatcher &);
+  TextBatcher &operator=(const TextBatcher &);
+};
+
+#endif // TEXT_BATCHER_HPP
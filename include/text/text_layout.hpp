@@ -0,0 +1,148 @@
+#ifndef TEXT_LAYOUT_HPP
+#define TEXT_LAYOUT_HPP
+
+#include <glm/glm.hpp>              // glm 라이브러리
+#include <text/glyph_cache.hpp>     // glyph metrices 읽기 전용 조회 (peek)
+#include <text/quad_kernel.hpp>     // SIMD 2D Quad 생성 커널
+#include <text/text_shaper.hpp>     // ShapedRun
+#include <text/text_view.hpp>       // TextView
+#include <cstddef>                  // size_t
+#include <vector>                   // std::vector
+
+/**
+ * layout 이 끝난 glyph 하나
+ *
+ * 위치와 크기는 screen space(px) 기준 2D Quad 이며, uv 는 layout 시점의 아틀라스 페이지 내 영역임.
+ * (TextLayout 내부에는 필드별 배열로 저장되어 있으며, TextLayout::getGlyph() 가 glyph 하나씩 조립해서 반환함)
+ */
+struct PositionedGlyph
+{
+  unsigned int key;  // glyph 캐시 키 (codepoint 또는 glyphIndexKey())
+  unsigned int page; // glyph 가 저장된 아틀라스 페이지 번호
+  float x;           // 2D Quad 좌하단 위치
+  float y;
+  float w;           // 2D Quad 크기
+  float h;
+  glm::vec4 uv;      // 아틀라스 uv 영역 (u0, v0, u1, v1)
+};
+
+/*
+  TextLayout 클래스
+
+  (문자열, 폰트, 크기, 원점)을 받아서 positioned glyph 배열로 만드는 GL 독립적인 layout 단계.
+
+  예전 main.cpp 의 RenderText() 는 glyph 조회, bearing / advance / scale 계산, 2D Quad 제출이 한 루프에 섞여 있어서
+  GL 스레드가 아니면 텍스트를 측정하거나 layout 할 수 없었음.
+  TextLayout 은 glyph 캐시의 metrices 를 읽기만 하고(GlyphCache::peek()) GL 함수나 FreeType 을 호출하지 않으므로,
+  layout 결과를 캐싱하거나, 그리기 전에 크기만 측정하거나, GL 스레드 밖에서 계산할 수 있음.
+  결과는 TextBatcher::submitLayout() 또는 TextMesh 가 2D Quad 로 변환해서 그림.
+
+  glyph 캐시에 아직 없는 glyph 는 getMissing() 에 모아두므로, GL 스레드에서 GlyphCache::preload() 로 올린 뒤 다시 layout 하면 됨.
+  layout 결과의 uv 는 getEvictions() 가 현재 GlyphCache::Stats::evictions 와 같을 때만 유효함.
+
+  결과는 glyph 원점, bearing, size, uv 를 필드별 연속 배열(structure-of-arrays)로 보관하며,
+  appendQuads() 가 SIMD 커널(generateQuads())로 glyph 4 ~ 8 개씩 2D Quad 위치를 계산해서 정점 데이터로 기록함.
+  공백 문자처럼 bitmap 이 없는 glyph 는 pen 위치만 옮기므로 저장하지 않음.
+
+  layout() 을 반복 호출해도 내부 배열을 재사용하므로 steady state 에서는 메모리를 새로 할당하지 않음.
+*/
+class TextLayout
+{
+public:
+  // TextLayout 클래스 생성자
+  TextLayout();
+
+  /**
+   * shaping 된 glyph run 을 pen 원점 (x, y) 부터 scale 배율로 layout
+   *
+   * advance / offset 에 ligature 와 GPOS kerning 이 이미 반영되어 있으며,
+   * glyph 캐시에 없는 glyph 도 advance 는 알고 있으므로 뒤따르는 glyph 들의 위치는 그대로 유지됨.
+   */
+  void layout(const ShapedRun &run, const GlyphCache &glyphs, float x, float y, float scale);
+
+  /**
+   * UTF-8 문자열을 codepoint 단위로 pen 원점 (x, y) 부터 scale 배율로 layout (GlyphCache 의 kerning 테이블 적용)
+   *
+   * glyph 캐시에 없는 문자는 advance 를 알 수 없으므로 건너뜀.
+   * 앞부분의 ASCII 구간은 skipAscii() 로 16 ~ 32 byte 씩 한꺼번에 확인해서 디코딩 없이 처리함.
+   */
+  void layout(const char *text, size_t length, const GlyphCache &glyphs, float x, float y, float scale);
+  void layout(TextView text, const GlyphCache &glyphs, float x, float y, float scale)
+  {
+    layout(text.data, text.length, glyphs, x, y, scale);
+  }
+
+  // layout 결과 비우기
+  void clear();
+
+  // 그려질 glyph 개수
+  size_t getGlyphCount() const { return keys.size(); }
+
+  // i 번째 glyph 의 glyph 캐시 키, 아틀라스 페이지
+  unsigned int getKey(size_t i) const { return keys[i]; }
+  unsigned int getPage(size_t i) const { return pages[i]; }
+
+  // i 번째 glyph 의 2D Quad (scalar 로 하나씩 계산하므로 측정, 디버깅용 -> 정점 데이터는 appendQuads() 사용)
+  PositionedGlyph getGlyph(size_t i) const;
+
+  // first 번째 glyph 부터 같은 아틀라스 페이지가 이어지는 구간의 끝 (같은 batch key 로 한꺼번에 기록할 수 있는 범위)
+  size_t getPageRunEnd(size_t first) const;
+
+  /**
+   * [first, first + count) 번째 glyph 들의 2D Quad 를 mode 형식으로 vertices 또는 instances 끝에 추가
+   *
+   * 배열을 한 번만 늘린 뒤 SIMD 커널이 늘어난 영역에 바로 기록하므로 glyph 마다 push_back 하지 않음.
+   */
+  void appendQuads(size_t first, size_t count, const glm::vec4 &color, TextBatchMode mode,
+                   std::vector<TextVertex> &vertices, std::vector<TextInstance> &instances) const;
+
+  // SIMD 커널 입력 (필드별 배열)
+  QuadSource getQuadSource() const;
+  float getScale() const { return scale; }
+
+  // layout 시점에 glyph 캐시에 없었던 glyph 키들 (중복 없음)
+  const std::vector<unsigned int> &getMissing() const { return missing; }
+  bool isComplete() const { return missing.empty(); }
+
+  // 마지막 glyph 다음의 pen 위치 (문자열 폭 = getPenX() - 원점 x)
+  float getPenX() const { return penX; }
+
+  // 모든 2D Quad 를 감싸는 영역 (minX, minY, maxX, maxY) -> 그릴 glyph 가 없으면 원점 위치의 빈 영역
+  const glm::vec4 &getBounds() const { return bounds; }
+
+  // layout 시점의 GlyphCache::Stats::evictions (값이 달라졌다면 uv 가 무효화되었을 수 있으므로 다시 layout 해야 함)
+  unsigned int getEvictions() const { return evictions; }
+
+private:
+  // layout 시작 시 결과 초기화
+  void begin(const GlyphCache &glyphs, float x, float y, float scale);
+  void begin(float x, float y, float scale);
+
+  // pen 원점 (originX, originY) 에 glyph 번호 glyph 추가
+  void place(unsigned int key, const GlyphMetrics &metrics, unsigned int glyph, float originX, float originY);
+
+  // glyph 캐시에 없는 glyph 키 기록
+  void addMissing(unsigned int key);
+
+  // glyph 별 필드 배열 (structure-of-arrays, 모두 같은 길이)
+  std::vector<unsigned int> keys;
+  std::vector<unsigned int> pages;
+  std::vector<float> originX;
+  std::vector<float> originY;
+  std::vector<float> bearingX;
+  std::vector<float> bearingY;
+  std::vector<float> sizeX;
+  std::vector<float> sizeY;
+  std::vector<float> u0;
+  std::vector<float> v0;
+  std::vector<float> u1;
+  std::vector<float> v1;
+  float scale;
+
+  std::vector<unsigned int> missing;
+  float penX;
+  glm::vec4 bounds;
+  unsigned int evictions;
+};
+
+#endif // TEXT_LAYOUT_HPP
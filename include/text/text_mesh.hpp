@@ -0,0 +1,115 @@
+#ifndef TEXT_MESH_HPP
+#define TEXT_MESH_HPP
+
+#include <glad/glad.h>           // OpenGL 함수를 초기화하기 위한 헤더
+#include <glm/glm.hpp>           // glm 라이브러리
+#include <text/glyph_cache.hpp>  // glyph metrices 및 아틀라스 페이지
+#include <text/text_batcher.hpp> // TextBatchKey, TextBatchMode, 정점 자료형
+#include <text/text_layout.hpp>  // GL 독립적인 layout 단계
+#include <text/text_shaper.hpp>  // HarfBuzz shaping 단계
+#include <text/text_view.hpp>    // TextView
+#include <string>                // std::string
+#include <vector>                // std::vector
+
+/*
+  TextMesh 클래스
+
+  내용이 거의 바뀌지 않는 문자열(HUD 라벨 등)을 위한 retained-mode 텍스트.
+
+  매 프레임 glyph 를 조회해서 2D Quad 를 계산하고 업로드하는 대신,
+  문자열의 정점 데이터를 한 번만 layout 해서 TextMesh 자신의 버퍼 객체(GL_STATIC_DRAW)에 올려두고 매 프레임 그대로 그림.
+
+  정점 데이터는 아래 경우에만 다시 layout 되며, 그 외의 프레임에서 드는 CPU 비용은
+  segment(batch key 가 같은 glyph 구간)마다 GL 상태 변경과 draw call 정도뿐임.
+    - setText(), setFont(), setShaper(), setPosition(), setScale(), setColor(), setFeatures() 로 값이 실제로 바뀐 경우
+    - 참조하던 아틀라스 페이지가 glyph 캐시에서 제거된 경우 (GlyphCache::Stats::evictions 로 확인)
+      (메모리 예산이 부족해서 추가하지 못한 glyph 도 이때 다시 요청함)
+    - 제출한 TextBatcher 의 TextBatchMode 가 바뀐 경우 (정점 형식이 다름)
+
+  setShaper() 로 TextShaper 를 연결하면 codepoint 단위 대신 shaping 된 glyph run 으로 layout 하므로
+  ligature 와 GPOS kerning 등이 적용됨. (TextShaper 는 glyphs 와 같은 FT_Face 로 생성되어야 함)
+
+  TextMesh 는 TextBatcher::submitMesh() 로 제출해서 그리며, 제출될 때마다 사용 중인 아틀라스 페이지를 LRU 제거 대상에서 제외시킴.
+  GL 객체를 생성하므로 GL 컨텍스트가 만들어진 이후에 생성해야 함.
+*/
+class TextMesh
+{
+public:
+  // batch key 가 같은 연속된 glyph 구간 (정점 또는 인스턴스 단위)
+  struct Segment
+  {
+    TextBatchKey key;
+    GLint first;
+    GLsizei count;
+  };
+
+  // TextMesh 클래스 생성자 (glyphs 는 TextMesh 보다 오래 살아있어야 함)
+  TextMesh(GlyphCache *glyphs = NULL);
+
+  // TextMesh 클래스 소멸자
+  ~TextMesh();
+
+  // layout 입력값 설정 (값이 바뀐 경우에만 다음 제출 때 다시 layout 함)
+  void setFont(GlyphCache *glyphs);
+  void setShaper(TextShaper *shaper); // NULL 이면 shaping 없이 codepoint 단위로 layout
+  void setText(TextView text); // 내용이 같으면 복사하지 않으며, 바뀐 경우에도 기존 버퍼 capacity 안이면 할당 없음
+  void setPosition(float x, float y);
+  void setScale(float scale);
+  void setColor(const glm::vec4 &color);
+  void setFeatures(unsigned int features); // TextFeature 비트 조합
+
+  const std::string &getText() const { return text; }
+
+  // 마지막 update() 의 layout 결과 (문자열 폭, 2D Quad 영역 측정용)
+  const TextLayout &getLayout() const { return layout; }
+
+  /**
+   * 필요한 경우에만 다시 layout 해서 버퍼 객체에 업로드 (다시 layout 했으면 true 반환)
+   *
+   * TextBatcher::submitMesh() 에서 호출하며, 메모리 예산이 부족해서 추가하지 못한 glyph 가 있다면
+   * glyph 캐시의 페이지가 제거되어 공간이 생겼을 때(evictions 가 바뀌었을 때) 다음 호출에서 다시 시도함.
+   */
+  bool update(TextBatchMode mode);
+
+  // 사용 중인 아틀라스 페이지들을 현재 프레임에서 사용 중인 것으로 표시
+  void touchPages();
+
+  // 렌더링에 필요한 정보 (TextBatcher 에서 사용)
+  const std::vector<Segment> &getSegments() const { return segments; }
+  unsigned int getBuffer() const { return VBO; }
+  unsigned int getGlyphCount() const { return glyphCount; }
+
+private:
+  // shaper 유무에 따라 현재 입력값으로 layout 계산
+  void layoutText();
+
+  GlyphCache *glyphs;
+  TextShaper *shaper;
+  std::string text;
+  float x;
+  float y;
+  float scale;
+  glm::vec4 color;
+  unsigned int features;
+
+  bool dirty;              // layout 입력값이 바뀌었음
+  bool built;              // 한 번이라도 layout 되었는지 여부
+  TextBatchMode builtMode; // 현재 정점 데이터의 형식
+  unsigned int evictions;  // layout 시점의 GlyphCache::Stats::evictions
+
+  std::vector<unsigned int> failed; // 메모리 예산이 부족해서 glyph 캐시에 추가하지 못한 glyph 키 (정렬됨)
+  unsigned int failedEvictions;     // failed 를 기록한 시점의 GlyphCache::Stats::evictions
+  TextLayout layout;       // 정점 데이터를 만든 layout 결과 (다시 layout 할 때 배열을 재사용)
+
+  unsigned int VBO;
+  size_t capacity; // 버퍼 객체에 할당된 크기 (byte)
+  std::vector<Segment> segments;
+  std::vector<unsigned int> pages; // segment 들이 참조하는 아틀라스 페이지 번호
+  unsigned int glyphCount;
+
+  // 복사 방지 (GL 객체 중복 해제 방지)
+  TextMesh(const TextMesh &);
+  TextMesh &operator=(const TextMesh &);
+};
+
+#endif // TEXT_MESH_HPP
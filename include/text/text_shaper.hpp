@@ -0,0 +1,143 @@
+#ifndef TEXT_SHAPER_HPP
+#define TEXT_SHAPER_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <hb.h>                      // HarfBuzz shaping
+#include <text/glyph_rasterizer.hpp> // GlyphRenderMode
+#include <text/text_view.hpp>        // TextView
+#include <cstddef>                   // size_t
+#include <list>                      // std::list
+#include <string>                    // std::string
+#include <unordered_map>             // std::unordered_map
+#include <vector>                    // std::vector
+
+/**
+ * shaping 결과 glyph 하나
+ *
+ * 위치값은 모두 FreeType 과 같은 1/64 px 단위(26.6 고정소수점)이며, pen 위치 기준으로
+ * (xOffset, yOffset) 만큼 떨어진 곳에 glyph 원점을 두고 그린 뒤 pen 을 (xAdvance, yAdvance) 만큼 이동시키면 됨.
+ */
+struct ShapedGlyph
+{
+  unsigned int glyphIndex; // 폰트 내부 glyph index (glyph 캐시에는 glyphIndexKey() 로 변환해서 요청)
+  unsigned int cluster;    // 이 glyph 가 만들어진 원본 UTF-8 문자열의 byte offset
+  int xAdvance;
+  int yAdvance;
+  int xOffset;
+  int yOffset;
+};
+
+// 문자열 하나를 shaping 한 결과 (glyph 들은 그려질 순서, 즉 시각적인 왼쪽 -> 오른쪽 순서로 저장됨)
+struct ShapedRun
+{
+  std::vector<ShapedGlyph> glyphs;
+  int advance; // 모든 glyph 의 xAdvance 합 (1/64 px 단위)
+};
+
+/*
+  TextShaper 클래스
+
+  HarfBuzz 로 UTF-8 문자열을 glyph run 으로 변환하는 shaping 단계와, 그 결과를 재사용하는 LRU 캐시.
+
+  codepoint 를 하나씩 cmap 으로 glyph 에 대응시키고 Advance 와 'kern' 테이블만 적용하는 방식으로는
+  ligature(fi, fl), GPOS kerning, mark 위치 지정, 아랍어처럼 문맥에 따라 모양이 바뀌는 문자 등을 처리할 수 없음.
+  hb_shape() 는 이것들을 모두 처리하지만 문자열마다 호출하기에는 비용이 크기 때문에,
+  (문자열 해시, 폰트, pixel size, OpenType feature 조합)을 키로 shaping 결과를 캐싱해서
+  매 프레임 같은 문자열을 다시 제출하면 첫 프레임 이후로는 shaping 을 건너뜀.
+
+  캐시는 최대 capacity 개의 run 을 저장하며, 넘치면 가장 오랫동안 조회되지 않은 run 부터 제거함.
+  해시 충돌로 다른 문자열의 run 을 반환하지 않도록, 캐시 적중 시 저장해둔 원본 문자열과 한 번 더 비교함.
+
+  hb_font 는 FT_Face 를 참조만 하므로(hb_ft_font_create) FT_Done_Face() 전에 shape() 호출을 끝내야 하며,
+  FT_Face 를 사용하는 다른 코드(GlyphCache 의 동기 rasterize 경로)와 같은 스레드에서만 사용해야 함.
+*/
+class TextShaper
+{
+public:
+  struct Stats
+  {
+    unsigned int hits;      // 캐시에 있던 run 을 재사용한 횟수
+    unsigned int misses;    // hb_shape() 를 호출한 횟수
+    unsigned int evictions; // capacity 를 넘어서 제거된 run 개수
+  };
+
+  /**
+   * TextShaper 클래스 생성자
+   *
+   * renderMode 는 glyph 캐시와 같은 값을 넘겨야 하며, bitmap 모드에서만 hinting 된 advance 를 사용함.
+   * (SDF / MSDF glyph 는 hinting 없이 rasterize 해서 확대/축소하므로 advance 도 pixel 격자에 맞추지 않음)
+   */
+  TextShaper(FT_Face face, GlyphRenderMode renderMode = GLYPH_RENDER_BITMAP, size_t capacity = 256);
+
+  // TextShaper 클래스 소멸자
+  ~TextShaper();
+
+  /**
+   * 이후 shape() 에 적용할 OpenType feature 설정 (설정 값을 해석할 수 없으면 false 반환하고 기존 설정 유지)
+   *
+   * hb_feature_from_string() 형식의 feature 들을 쉼표로 구분해서 지정함. (예: "-liga,smcp,kern=0")
+   * feature 조합도 캐시 키에 포함되므로 설정을 바꿔도 이전 설정의 run 들은 그대로 재사용 가능함.
+   */
+  bool setFeatures(const std::string &features);
+
+  /**
+   * UTF-8 문자열을 shaping 한 run 을 반환하며, 캐시에 같은 조건의 run 이 있으면 shaping 없이 그대로 반환함.
+   *
+   * 반환된 참조는 다음 shape() 호출 전까지만 유효함.
+   */
+  const ShapedRun &shape(const char *text, size_t length);
+  const ShapedRun &shape(TextView text) { return shape(text.data, text.length); }
+
+  // 캐시된 모든 run 제거
+  void clear();
+
+  const Stats &getStats() const { return stats; }
+  size_t size() const { return runs.size(); }
+
+private:
+  // 캐시 키 (문자열 내용은 해시로만 비교하고, 적중 시 Entry::text 로 한 번 더 확인함)
+  struct ShapeKey
+  {
+    unsigned long long textHash;
+    const void *font;       // FT_Face
+    unsigned int pixelSize; // FT_Face 의 현재 pixel size
+    unsigned long long featuresHash;
+
+    bool operator==(const ShapeKey &other) const
+    {
+      return textHash == other.textHash && font == other.font && pixelSize == other.pixelSize &&
+             featuresHash == other.featuresHash;
+    }
+  };
+
+  struct Entry
+  {
+    ShapeKey key;
+    unsigned long long hash; // runIndex 에서 사용하는 키
+    std::string text;
+    ShapedRun run;
+  };
+
+  FT_Face face;
+  hb_font_t *font;
+  hb_buffer_t *buffer; // shaping 마다 재사용하는 HarfBuzz 버퍼
+  unsigned int pixelSize;
+
+  std::vector<hb_feature_t> features;
+  unsigned long long featuresHash;
+
+  // 앞쪽일수록 최근에 조회된 run (list 노드는 이동해도 iterator 가 유지되므로 index 가 가리키는 위치가 바뀌지 않음)
+  std::list<Entry> runs;
+  std::unordered_map<unsigned long long, std::list<Entry>::iterator> runIndex;
+  size_t capacity;
+
+  Stats stats;
+
+  // 복사 방지 (HarfBuzz 객체 중복 해제 방지)
+  TextShaper(const TextShaper &);
+  TextShaper &operator=(const TextShaper &);
+};
+
+#endif // TEXT_SHAPER_HPP
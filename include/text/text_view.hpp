@@ -0,0 +1,32 @@
+#ifndef TEXT_VIEW_HPP
+#define TEXT_VIEW_HPP
+
+#include <cstddef> // size_t
+#include <cstring> // std::strlen
+#include <string>  // std::string
+
+/**
+ * 문자열을 복사하지 않고 가리키기만 하는 (포인터, 길이) 쌍 (C++17 의 std::string_view 대용)
+ *
+ * 문자열 리터럴, const char *, std::string 에서 암묵적으로 만들어지므로
+ * 텍스트 제출 함수가 std::string 을 값으로 받을 때처럼 호출할 때마다 힙 할당과 복사가 일어나지 않음.
+ * NULL 종료 문자열일 필요가 없으므로 스택 버퍼나 더 긴 문자열의 일부도 그대로 넘길 수 있음.
+ *
+ * 가리키는 문자열은 TextView 를 사용하는 동안 유효해야 함.
+ */
+struct TextView
+{
+  const char *data;
+  size_t length;
+
+  TextView() : data(""), length(0) {}
+  TextView(const char *text) : data(text), length(std::strlen(text)) {}
+  TextView(const char *text, size_t length) : data(text), length(length) {}
+  TextView(const std::string &text) : data(text.data()), length(text.size()) {}
+
+  const char *begin() const { return data; }
+  const char *end() const { return data + length; }
+  bool empty() const { return length == 0; }
+};
+
+#endif // TEXT_VIEW_HPP
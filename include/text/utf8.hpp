@@ -0,0 +1,155 @@
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+#include <cstring> // std::memcpy
+
+// ASCII 구간 검사에 사용할 SIMD 명령어 집합 (SSE2 는 x86-64 의 기본 명령어 집합이므로 컴파일 옵션 없이 사용 가능)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTF8_HAS_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+/**
+ * UTF-8 로 인코딩된 문자열에서 codepoint 하나를 디코딩하고, it 를 다음 문자의 시작 위치로 옮김.
+ *
+ * UTF-8 은 codepoint 크기에 따라 1 ~ 4 byte 를 사용하며, 첫 byte 의 상위 bit 로 전체 byte 수를 알 수 있음.
+ *   0xxxxxxx                            -> 1 byte (ASCII)
+ *   110xxxxx 10xxxxxx                   -> 2 byte
+ *   1110xxxx 10xxxxxx 10xxxxxx          -> 3 byte
+ *   11110xxx 10xxxxxx 10xxxxxx 10xxxxxx -> 4 byte
+ *
+ * 잘못된 byte 열을 만나면 U+FFFD(replacement character)를 반환하고 1 byte 만 건너뜀.
+ */
+inline unsigned int decodeUtf8(const char *&it, const char *end)
+{
+  const unsigned int REPLACEMENT = 0xFFFD;
+  unsigned char lead = static_cast<unsigned char>(*it++);
+
+  if (lead < 0x80)
+  {
+    return lead;
+  }
+
+  int length;
+  unsigned int codepoint;
+  unsigned int minimum;
+  if ((lead & 0xE0) == 0xC0)
+  {
+    length = 1;
+    codepoint = lead & 0x1F;
+    minimum = 0x80;
+  }
+  else if ((lead & 0xF0) == 0xE0)
+  {
+    length = 2;
+    codepoint = lead & 0x0F;
+    minimum = 0x800;
+  }
+  else if ((lead & 0xF8) == 0xF0)
+  {
+    length = 3;
+    codepoint = lead & 0x07;
+    minimum = 0x10000;
+  }
+  else
+  {
+    return REPLACEMENT;
+  }
+
+  if (end - it < length)
+  {
+    return REPLACEMENT;
+  }
+
+  const char *cursor = it;
+  for (int i = 0; i < length; i++)
+  {
+    unsigned char continuation = static_cast<unsigned char>(*cursor++);
+    if ((continuation & 0xC0) != 0x80)
+    {
+      return REPLACEMENT;
+    }
+    codepoint = (codepoint << 6) | (continuation & 0x3F);
+  }
+
+  // overlong 인코딩, surrogate 영역, 유니코드 범위 밖의 값은 잘못된 입력으로 처리
+  if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+  {
+    return REPLACEMENT;
+  }
+
+  it = cursor;
+  return codepoint;
+}
+
+#ifdef UTF8_HAS_SSE2
+// 0 이 아닌 mask 에서 가장 낮은 set bit 의 위치
+inline int lowestBit(unsigned int mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+/**
+ * [it, end) 에서 ASCII byte(0x00 ~ 0x7F)가 이어지는 구간을 건너뛰고, 처음으로 ASCII 가 아닌 byte 의 위치를 반환 (모두 ASCII 면 end)
+ *
+ * ASCII 문자는 UTF-8 에서 그대로 1 byte 이므로, 이 구간의 byte 들은 decodeUtf8() 을 거치지 않고 바로 codepoint 로 사용할 수 있음.
+ * ASCII 가 아닌 byte 는 최상위 bit 가 1 이므로, SSE2 로 32 byte(16 byte 레지스터 2개)씩 읽어서
+ * 각 byte 의 최상위 bit 를 모은 mask(_mm_movemask_epi8)가 0 인지만 확인하면 됨.
+ * SSE2 가 없는 CPU 에서는 8 byte 정수 하나에 0x80 mask 를 씌우는 방식으로 8 byte 씩 확인함.
+ */
+inline const char *skipAscii(const char *it, const char *end)
+{
+#ifdef UTF8_HAS_SSE2
+  while (end - it >= 32)
+  {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it + 16));
+    if (_mm_movemask_epi8(_mm_or_si128(low, high)) != 0)
+    {
+      unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(low)) |
+                          (static_cast<unsigned int>(_mm_movemask_epi8(high)) << 16);
+      return it + lowestBit(mask);
+    }
+    it += 32;
+  }
+  if (end - it >= 16)
+  {
+    unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(it))));
+    if (mask != 0)
+    {
+      return it + lowestBit(mask);
+    }
+    it += 16;
+  }
+#else
+  while (end - it >= 8)
+  {
+    unsigned long long word;
+    std::memcpy(&word, it, sizeof(word));
+    if ((word & 0x8080808080808080ull) != 0)
+    {
+      break;
+    }
+    it += 8;
+  }
+#endif
+
+  // 남은 byte 들 (16 byte 미만) 과 ASCII 가 아닌 byte 가 포함된 8 byte 안에서의 위치
+  while (it != end && static_cast<unsigned char>(*it) < 0x80)
+  {
+    ++it;
+  }
+  return it;
+}
+
+#endif // UTF8_HPP
@@ -0,0 +1,128 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>  // std::atomic
+#include <cstddef> // size_t
+
+/*
+  BoundedQueue 클래스 템플릿
+
+  고정 크기 ring buffer 기반의 lock-free multi-producer / multi-consumer 큐. (Dmitry Vyukov 의 bounded MPMC queue)
+
+  각 slot 마다 sequence 번호를 두고, producer 와 consumer 는 자신이 가져갈 위치를 compare-and-swap 으로 예약한 뒤
+  sequence 번호를 갱신해서 상대편에게 해당 slot 이 채워졌는지(또는 비워졌는지)를 알려줌.
+  따라서 mutex 없이도 여러 스레드가 동시에 push() / pop() 할 수 있으며, 실행 중에 메모리 할당이 일어나지 않음.
+
+  capacity 는 2의 거듭제곱이어야 하며, 큐가 가득 차 있으면 push() 는 기다리지 않고 false 를 반환함.
+*/
+template <typename T>
+class BoundedQueue
+{
+public:
+  // BoundedQueue 클래스 생성자
+  explicit BoundedQueue(size_t capacity)
+      : cells(new Cell[capacity]), mask(capacity - 1)
+  {
+    for (size_t i = 0; i < capacity; i++)
+    {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos.store(0, std::memory_order_relaxed);
+  }
+
+  // BoundedQueue 클래스 소멸자
+  ~BoundedQueue()
+  {
+    delete[] cells;
+  }
+
+  // 큐 끝에 value 추가 (큐가 가득 차 있으면 false 반환)
+  bool push(const T &value)
+  {
+    Cell *cell;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell = &cells[pos & mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      long long diff = static_cast<long long>(sequence) - static_cast<long long>(pos);
+      if (diff == 0)
+      {
+        // 비어있는 slot -> 다른 producer 보다 먼저 위치를 예약했다면 기록
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        // 아직 consumer 가 비우지 않은 slot -> 큐가 가득 참
+        return false;
+      }
+      else
+      {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->data = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 큐 앞에서 value 를 꺼냄 (큐가 비어 있으면 false 반환)
+  bool pop(T &value)
+  {
+    Cell *cell;
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+      cell = &cells[pos & mask];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      long long diff = static_cast<long long>(sequence) - static_cast<long long>(pos + 1);
+      if (diff == 0)
+      {
+        // 채워진 slot -> 다른 consumer 보다 먼저 위치를 예약했다면 꺼냄
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        // 아직 producer 가 채우지 않은 slot -> 큐가 비어 있음
+        return false;
+      }
+      else
+      {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    value = cell->data;
+    // 한 바퀴 뒤의 producer 가 이 slot 을 다시 사용할 수 있도록 sequence 를 capacity 만큼 앞으로 옮김
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  Cell *cells;
+  size_t mask;
+
+  // producer 와 consumer 가 서로의 cache line 을 무효화하지 않도록(false sharing 방지) 64 byte 단위로 떨어트려 배치
+  alignas(64) std::atomic<size_t> enqueuePos;
+  alignas(64) std::atomic<size_t> dequeuePos;
+
+  // 복사 방지
+  BoundedQueue(const BoundedQueue &);
+  BoundedQueue &operator=(const BoundedQueue &);
+};
+
+#endif // BOUNDED_QUEUE_HPP
@@ -0,0 +1,26 @@
+#ifndef GL_EXTENSIONS_HPP
+#define GL_EXTENSIONS_HPP
+
+#include <glad/glad.h> // OpenGL 함수를 초기화하기 위한 헤더
+
+/**
+ * 현재 OpenGL 컨텍스트가 주어진 이름의 확장(extension)을 지원하는지 검사
+ *
+ * core profile 에서는 glGetString(GL_EXTENSIONS) 를 사용할 수 없으므로,
+ * glGetStringi() 로 확장 이름을 하나씩 순회하며 비교함.
+ * (glad 로더에 포함되지 않은 ARB, KHR 확장들을 런타임에 확인할 때 사용)
+ */
+bool hasGLExtension(const char *name);
+
+/**
+ * core 기능으로 승격된 ARB 확장의 함수 포인터를 로드
+ *
+ * glad 로더는 컨텍스트 버전이 해당 core 버전 이상일 때만 함수 포인터를 로드하므로,
+ * 3.3 컨텍스트에서는 드라이버가 확장을 지원하더라도 포인터가 NULL 로 남아있음.
+ * gladLoadGLLoader() 직후 같은 loader 로 호출하면, 지원되는 확장의 함수(core 와 같은 이름)를 glad 함수 포인터에 채워넣음.
+ *   - GL_ARB_get_program_binary (GL 4.1) : glGetProgramBinary, glProgramBinary, glProgramParameteri
+ *   - GL_ARB_buffer_storage (GL 4.4) : glBufferStorage
+ */
+void loadGLExtensions(GLADloadproc loader);
+
+#endif // GL_EXTENSIONS_HPP
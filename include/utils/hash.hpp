@@ -0,0 +1,26 @@
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef> // size_t
+
+/**
+ * 64-bit FNV-1a 해시
+ *
+ * byte 하나씩 XOR 후 FNV prime 을 곱하는 단순한 비암호학적 해시로,
+ * 폰트 파일이나 쉐이더 소스처럼 캐시 키로 사용할 데이터가 바뀌었는지 확인하는 용도로 사용함.
+ *
+ * seed 에 이전 해시값을 넘기면 여러 데이터 조각을 이어서 하나의 해시로 만들 수 있음.
+ */
+inline unsigned long long hashBytes(const void *data, size_t size, unsigned long long seed = 14695981039346656037ull)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  unsigned long long hash = seed;
+  for (size_t i = 0; i < size; i++)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+#endif // HASH_HPP
@@ -0,0 +1,102 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // size_t
+#include <deque>              // std::deque
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+/**
+ * 작업 하나를 실행하는 함수
+ *
+ * context 는 parallelFor() 에 넘긴 포인터, index 는 [0, count) 범위의 작업 번호이며,
+ * worker 는 작업을 실행하는 스레드의 번호 ([0, getWorkerCount()) 범위) 이므로 스레드별 arena 버퍼를 고르는 데 사용함.
+ */
+typedef void (*JobFunction)(void *context, size_t index, unsigned int worker);
+
+/*
+  JobSystem 클래스
+
+  서로 독립적인 작업 여러 개(텍스트 블록 layout 등)를 worker 스레드들에 나눠서 실행하는 work-stealing job system.
+
+  worker 마다 자신만의 deque 를 가지며, parallelFor() 는 작업 번호들을 연속된 구간으로 나눠서 각 deque 에 채워 넣음.
+  worker 는 자신의 deque 뒤쪽에서 작업을 꺼내고(최근에 넣은 작업 -> 캐시 지역성), 비었으면 다른 worker 의 deque 앞쪽에서 훔쳐옴(steal).
+  따라서 작업마다 비용이 달라서(긴 문자열 / 짧은 문자열) 한 worker 에 일이 몰려도 먼저 끝난 worker 들이 남은 작업을 나눠 가짐.
+
+  parallelFor() 를 호출한 스레드도 마지막 worker 번호로 작업에 참여하므로 스레드가 놀지 않으며,
+  모든 작업이 끝날 때까지 반환하지 않음. 작업 함수 안에서 다시 parallelFor() 를 호출하면 안되고,
+  parallelFor() 는 한 번에 한 스레드(GL 스레드)에서만 호출해야 함.
+
+  deque 는 worker 별 mutex 로 보호하지만, 작업 하나를 꺼낼 때만 잠깐 잠그고 worker 끼리는 서로 다른 mutex 를 사용하므로
+  steal 이 일어날 때를 제외하면 경합이 없음.
+*/
+class JobSystem
+{
+public:
+  struct Stats
+  {
+    unsigned long long jobs;   // 실행된 작업 개수
+    unsigned long long steals; // 다른 worker 의 deque 에서 훔쳐서 실행한 작업 개수
+  };
+
+  // JobSystem 클래스 생성자 (threadCount 가 0 이면 호출 스레드를 포함해서 하드웨어 스레드 개수만큼 worker 사용)
+  explicit JobSystem(unsigned int threadCount = 0);
+
+  // JobSystem 클래스 소멸자 (worker 스레드 종료)
+  ~JobSystem();
+
+  // function(context, index, worker) 를 [0, count) 범위의 index 마다 한 번씩 병렬로 실행하고 모두 끝날 때까지 대기
+  void parallelFor(JobFunction function, void *context, size_t count);
+
+  // 작업을 실행하는 스레드 개수 (호출 스레드 포함) -> 스레드별 arena 버퍼 개수
+  unsigned int getWorkerCount() const { return static_cast<unsigned int>(queues.size()); }
+
+  Stats getStats() const
+  {
+    Stats stats = {jobCount.load(std::memory_order_relaxed), stealCount.load(std::memory_order_relaxed)};
+    return stats;
+  }
+
+private:
+  // worker 하나의 작업 deque
+  struct WorkQueue
+  {
+    std::mutex mutex;
+    std::deque<size_t> jobs;
+  };
+
+  // worker 스레드 본체
+  void workerMain(unsigned int worker);
+
+  // 자신의 deque 또는 다른 worker 의 deque 에서 작업을 하나씩 꺼내서 더 이상 꺼낼 작업이 없을 때까지 실행
+  void drain(unsigned int worker);
+
+  // worker 의 deque 에서 작업 하나를 꺼냄 (steal 이면 앞쪽, 아니면 뒤쪽)
+  bool pop(unsigned int worker, bool steal, size_t &index);
+
+  std::vector<std::thread> threads;
+  std::vector<WorkQueue *> queues; // 마지막 deque 는 parallelFor() 호출 스레드의 것
+
+  // 현재 parallelFor() 의 작업
+  JobFunction function;
+  void *context;
+  std::atomic<size_t> remaining; // 아직 끝나지 않은 작업 개수
+
+  // 새 작업이 채워졌음을 worker 들에게 알리는 세대 번호
+  std::mutex wakeMutex;
+  std::condition_variable wake;
+  unsigned long long generation;
+  bool stopping;
+
+  std::atomic<unsigned long long> jobCount;
+  std::atomic<unsigned long long> stealCount;
+
+  // 복사 방지 (worker 스레드 중복 join 방지)
+  JobSystem(const JobSystem &);
+  JobSystem &operator=(const JobSystem &);
+};
+
+#endif // JOB_SYSTEM_HPP
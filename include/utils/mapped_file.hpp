@@ -0,0 +1,48 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef> // size_t
+
+/*
+  MappedFile 클래스
+
+  파일 전체를 읽기 전용으로 메모리 매핑(mmap / MapViewOfFile)하는 클래스.
+
+  std::ifstream 으로 파일을 읽으면 커널의 page cache 에서 사용자 메모리로 한 번 더 복사가 일어나지만,
+  메모리 매핑을 사용하면 page cache 의 페이지를 그대로 프로세스 주소 공간에 연결하므로
+  필요한 부분만 접근 시점에 읽어들이고(lazy loading) 추가적인 복사도 발생하지 않음.
+*/
+class MappedFile
+{
+public:
+  // MappedFile 클래스 생성자
+  MappedFile();
+
+  // MappedFile 클래스 소멸자
+  ~MappedFile();
+
+  // 주어진 경로의 파일을 읽기 전용으로 매핑 (실패하면 false 반환)
+  bool open(const char *path);
+
+  // 매핑 해제
+  void close();
+
+  bool isOpen() const { return bytes != NULL; }
+  const unsigned char *data() const { return bytes; }
+  size_t size() const { return length; }
+
+private:
+  const unsigned char *bytes;
+  size_t length;
+
+#ifdef _WIN32
+  void *file;    // 파일 HANDLE
+  void *mapping; // 파일 매핑 HANDLE
+#endif
+
+  // 복사 방지 (매핑 중복 해제 방지)
+  MappedFile(const MappedFile &);
+  MappedFile &operator=(const MappedFile &);
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,73 @@
+#ifndef RESOURCE_HPP
+#define RESOURCE_HPP
+
+#include <utils/mapped_file.hpp> // 디스크 override / 내장되지 않은 파일 매핑
+#include <cstddef>               // size_t
+
+/**
+ * 빌드 시 실행파일에 내장된 리소스 하나 (CMake 의 embed_resources() 가 생성하는 테이블의 항목)
+ *
+ * path 는 소스 트리 기준 상대경로 ("resources/shaders/text.vs" 등)이며,
+ * data 는 size 바이트 뒤에 0 이 하나 더 붙어 있으므로 텍스트 리소스는 C 문자열로도 사용 가능함.
+ */
+struct EmbeddedResource
+{
+  const char *path;
+  const unsigned char *data;
+  size_t size;
+};
+
+// 실행파일에 내장된 리소스 테이블 (빌드 디렉토리의 generated/<target>_resources.cpp 에 정의됨)
+extern const EmbeddedResource EMBEDDED_RESOURCES[];
+extern const size_t EMBEDDED_RESOURCE_COUNT;
+
+/*
+  Resource 클래스
+
+  쉐이더 소스나 폰트처럼 프로그램이 사용하는 리소스 파일의 바이트를 가져오는 클래스.
+
+  실행파일에 내장된 리소스는 파일 시스템을 전혀 거치지 않고 내장 배열을 그대로 가리키므로,
+  작업 디렉토리와 상관없이 실행할 수 있고 컨테이너 cold start 에서도 파일 읽기가 발생하지 않음.
+
+  개발 중에는 환경 변수 TEXT_RENDERING_RESOURCE_DIR 에 리소스 디렉토리(보통 소스 트리 루트)를 지정하면
+  그 디렉토리에 있는 파일을 내장 리소스보다 먼저 사용하므로, 쉐이더를 고칠 때마다 다시 빌드하지 않아도 됨.
+  내장되지 않은 경로는 기존처럼 작업 디렉토리 기준 파일을 메모리 매핑해서 사용함.
+*/
+class Resource
+{
+public:
+  // 디스크 override 디렉토리를 지정하는 환경 변수 이름
+  static const char *const RESOURCE_OVERRIDE_ENV;
+
+  // Resource 클래스 생성자
+  Resource();
+
+  // Resource 클래스 소멸자
+  ~Resource();
+
+  // 주어진 경로의 리소스를 찾음 (override 디렉토리 -> 내장 리소스 -> 작업 디렉토리 순, 모두 없으면 false 반환)
+  bool open(const char *path);
+
+  // 리소스 해제 (디스크에서 매핑한 경우에만 매핑 해제)
+  void close();
+
+  bool isOpen() const { return bytes != NULL; }
+  bool isEmbedded() const { return embedded; }
+  const unsigned char *data() const { return bytes; }
+  size_t size() const { return length; }
+
+  // 실행파일에 내장된 리소스 조회 (없으면 NULL)
+  static const EmbeddedResource *findEmbedded(const char *path);
+
+private:
+  MappedFile file;
+  const unsigned char *bytes;
+  size_t length;
+  bool embedded;
+
+  // 복사 방지 (매핑 중복 해제 방지)
+  Resource(const Resource &);
+  Resource &operator=(const Resource &);
+};
+
+#endif // RESOURCE_HPP
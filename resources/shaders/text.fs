@@ -1,20 +1,99 @@
 #version 330 core
 
+/**
+ * feature define (TextBatcher 가 batch 마다 필요한 define 만 #version 바로 아래에 주입해서 permutation 을 만듦)
+ *
+ * SDF     : 아틀라스에 signed distance field 가 저장되어 있음 (외곽선 = 0.5)
+ * MSDF    : 아틀라스 RGB 채널에 multi-channel SDF 가 저장되어 있음 (세 채널의 중간값이 거리)
+ * OUTLINE : glyph 외곽선 바깥쪽으로 outlineWidth 만큼 outlineColor 테두리를 그림 (SDF / MSDF 전용)
+ * SHADOW  : glyph 뒤에 shadowOffset 만큼 떨어진 그림자를 그림 (SDF / MSDF 전용)
+ *
+ * define 이 하나도 없는 기본 variant 는 grayscale bitmap 의 coverage 만 샘플링하므로,
+ * 효과가 필요 없는 텍스트는 사용하지 않는 효과의 분기나 uniform 비용을 전혀 지불하지 않음.
+ */
+
 in vec2 TexCoords;
+in vec4 TextColor;
 
 // 색상 출력변수 선언
 out vec4 color;
 
-// 각 glyph 가 렌더링된 grayscale bitmap 텍스쳐
+// 각 glyph 가 렌더링된 아틀라스 텍스쳐
 uniform sampler2D text;
 
-// 각 glyph 를 렌더링할 텍스트 색상 변수 선언
-uniform vec3 textColor;
+#ifdef OUTLINE
+uniform vec4 outlineColor;
+uniform float outlineWidth; // 테두리 두께 (거리값 단위, 0 ~ 0.5 -> 0.5 면 distance field 의 spread 전체)
+#endif
+
+#ifdef SHADOW
+uniform vec4 shadowColor;
+uniform vec2 shadowOffset; // 그림자 위치 (아틀라스 texel 단위, distance field 의 spread 를 넘으면 잘림)
+#endif
+
+#if defined(MSDF)
+// 세 값 중 중간값 계산
+float median(float r, float g, float b) {
+  return max(min(r, g), min(max(r, g), b));
+}
+
+// 세 채널의 중간값을 외곽선까지의 거리로 사용
+// -> 모서리에서 만나는 두 edge 의 거리는 서로 다른 채널에 기록되어 있어서, 선형 보간하더라도 모서리가 뭉개지지 않음.
+float sampleDistance(vec2 uv) {
+  vec3 sampled = texture(text, uv).rgb;
+  return median(sampled.r, sampled.g, sampled.b);
+}
+#elif defined(SDF)
+float sampleDistance(vec2 uv) {
+  return texture(text, uv).r;
+}
+#endif
+
+#if defined(SDF) || defined(MSDF)
+// 거리값 dist 가 threshold 를 기준으로 1 픽셀 폭에 걸쳐 anti-aliasing 된 coverage 계산
+float coverage(float dist, float threshold, float pixelDistance) {
+  return clamp((dist - threshold) / pixelDistance + 0.5, 0.0, 1.0);
+}
+
+// 반투명한 두 색상을 top 이 위에 오도록 합성 (glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) 에 넘길 straight alpha 로 반환)
+vec4 over(vec4 top, vec4 bottom) {
+  float alpha = top.a + bottom.a * (1.0 - top.a);
+  vec3 rgb = top.rgb * top.a + bottom.rgb * bottom.a * (1.0 - top.a);
+  return vec4(alpha > 0.0 ? rgb / alpha : vec3(0.0), alpha);
+}
+#endif
 
 void main() {
+#if defined(SDF) || defined(MSDF)
+  float dist = sampleDistance(TexCoords);
+
+  /**
+   * 화면상의 픽셀 하나가 거리값으로 얼마만큼에 해당하는지 screen-space 미분으로 계산
+   *
+   * glyph 를 크게 그릴수록 픽셀당 거리 변화량이 작아지고, 작게 그릴수록 커지므로
+   * 이 값만큼의 폭으로 외곽선을 anti-aliasing 하면 렌더링 크기에 상관없이 항상 1 픽셀 폭의 선명한 가장자리가 만들어짐.
+   */
+  float pixelDistance = max(length(vec2(dFdx(dist), dFdy(dist))), 1e-5);
+
+  vec4 result = vec4(TextColor.rgb, TextColor.a * coverage(dist, 0.5, pixelDistance));
+
+#ifdef OUTLINE
+  // 외곽선 기준값을 바깥쪽으로 옮긴 coverage 로 테두리를 그리고 그 위에 glyph 를 합성
+  result = over(result, vec4(outlineColor.rgb, outlineColor.a * coverage(dist, 0.5 - outlineWidth, pixelDistance)));
+#endif
+
+#ifdef SHADOW
+  // 그림자는 glyph 를 shadowOffset 만큼 옮겨서 샘플링한 coverage 로 그리고 가장 아래에 합성
+  float shadowDistance = sampleDistance(TexCoords - shadowOffset / vec2(textureSize(text, 0)));
+  result = over(result, vec4(shadowColor.rgb, shadowColor.a * coverage(shadowDistance, 0.5, pixelDistance)));
+#endif
+
+  color = result;
+#else
   // grayscale bitmap 텍스쳐로부터 2D Quad 에 적용할 glyph 의 alpha 값 샘플링
   vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
 
-  // 입력된 텍스트 색상값과 곱하여 최종 glyph 색상 변수 출력
-  color = vec4(textColor, 1.0) * sampled;
+  // 정점 데이터로 전달받은 텍스트 색상값과 곱하여 최종 glyph 색상 변수 출력
+  color = TextColor * sampled;
+#endif
 }
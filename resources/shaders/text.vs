@@ -1,18 +1,50 @@
 #version 330 core
 
+/**
+ * feature define (TextBatcher 가 batch 마다 필요한 define 만 #version 바로 아래에 주입해서 permutation 을 만듦)
+ *
+ * INSTANCED : glyph 마다 정점 6개 대신 per-instance 데이터 하나를 전달받아 정적 unit quad 를 glyph 크기로 펼침
+ */
+
+#ifdef INSTANCED
+// 모든 glyph 가 공유하는 정적 unit quad 의 모서리 좌표 (0 ~ 1 범위)
+layout(location = 0) in vec2 corner;
+
+// 아래 attribute 들은 glVertexAttribDivisor(index, 1) 로 설정되어 glyph(= 인스턴스)마다 한 번씩 갱신됨.
+layout(location = 1) in vec4 glyphRect; // 2D Quad 좌하단 위치(xy) + 크기(zw)
+layout(location = 2) in vec4 glyphUV;   // 아틀라스 uv 영역 (u0, v0, u1, v1)
+layout(location = 3) in vec4 color;     // 텍스트 색상
+#else
 // 이 예제에서는 정점 pos, uv 데이터를 단일 attribute 에 담아서 전달받을 것임.
 // -> why? glyph 를 렌더링할 2D Quad 의 정점 위치는 vec2 만으로도 충분히 정의 가능하므로, vec4 에 pos, uv 를 한꺼번에 담을 수 있음.
 layout(location = 0) in vec4 vertex;
 
+// 텍스트 색상 -> 여러 문자열을 하나의 draw call 로 묶을 수 있도록 uniform 대신 정점 데이터로 전달받음.
+layout(location = 1) in vec4 color;
+#endif
+
 // uv 보간 출력 변수 선언
 out vec2 TexCoords;
 
+// 텍스트 색상 출력 변수 선언
+out vec4 TextColor;
+
 // orthogonal 투영행렬 변수 선언
 uniform mat4 projection;
 
 void main() {
+#ifdef INSTANCED
+  // unit quad 모서리 좌표를 glyph 위치와 크기로 펼쳐서 screen space 정점 pos 계산
+  vec2 pos = glyphRect.xy + corner * glyphRect.zw;
+  gl_Position = projection * vec4(pos, 0.0, 1.0);
+
+  // FreeType bitmap 은 첫 줄이 glyph 최상단이므로, 2D Quad 하단(corner.y = 0)에는 v1, 상단(corner.y = 1)에는 v0 를 대응시킴.
+  TexCoords = vec2(mix(glyphUV.x, glyphUV.z, corner.x), mix(glyphUV.w, glyphUV.y, corner.y));
+#else
   // text rendering 시 카메라를 사용하지 않으므로 정점 pos 에 투영행렬을 바로 곱해서 변환함.
   // 이때, 정점 pos(= vertex.xy) 는 screen space 기준으로 정의된 좌표값이며, orthogonal 투영행렬은 screen space 좌표값을 그대로 사용 가능하도록 계산된 상태임.
   gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
   TexCoords = vertex.zw;
+#endif
+  TextColor = color;
 }
@@ -9,10 +9,25 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <shader/shader.hpp>
-
+#include <shader/shader_library.hpp>
+#include <text/character.hpp>
+#include <text/font_loader.hpp>
+#include <text/glyph_cache.hpp>
+#include <text/glyph_rasterizer.hpp>
+#include <text/parallel_text_layout.hpp>
+#include <text/text_batcher.hpp>
+#include <text/text_mesh.hpp>
+#include <text/text_shaper.hpp>
+#include <text/text_view.hpp>
+#include <utils/gl_extensions.hpp>
+#include <utils/hash.hpp>
+#include <utils/job_system.hpp>
+
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <string>
-#include <map>
+#include <vector>
 
 /** 콜백함수 전방 선언 */
 
@@ -22,30 +37,74 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height);
 // GLFW 윈도우 키 입력 콜백함수
 void processInput(GLFWwindow *window);
 
-// 주어진 std::string 문자열을 주어진 위치, 크기, 색상으로 렌더링하는 콜백함수
-void RenderText(Shader &shader, std::string text, float x, float y, float scale, glm::vec3 color);
+/** 폰트 리소스 경로 선언 (폰트와 쉐이더는 실행파일에 내장되어 있음 -> utils/resource.hpp 참고) */
+const char *FONT_PATH = "resources/fonts/Antonio-Bold.ttf";
+
+// glyph 아틀라스 디스크 캐시 파일 경로 (기본값은 실행파일 옆 -> CMake 의 GLYPH_CACHE_PATH 로 변경 가능)
+#ifndef GLYPH_CACHE_PATH
+#define GLYPH_CACHE_PATH "Antonio-Bold-48.glyphcache"
+#endif
+
+// 링킹된 쉐이더 프로그램 바이너리 캐시 디렉토리 (기본값은 실행파일 옆의 shader_cache -> CMake 의 SHADER_CACHE_DIR 로 변경 가능)
+#ifndef SHADER_CACHE_DIR
+#define SHADER_CACHE_DIR "shader_cache"
+#endif
+
+/**
+ * glyph 를 아틀라스에 저장할 형태 선언
+ *
+ * SDF 로 저장하면 48px 로 rasterize 한 아틀라스 하나만으로 작은 크기부터 큰 크기까지 선명하게 렌더링할 수 있으므로,
+ * 텍스트의 scale 마다 추가로 rasterize 한 아틀라스를 둘 필요가 없음.
+ *
+ * 다만 Antonio-Bold 처럼 모서리가 날카로운 폰트는 SDF 를 크게 확대하면 모서리가 둥글게 뭉개지므로,
+ * 모서리 양쪽 edge 의 거리를 서로 다른 채널에 저장하는 MSDF 를 사용함.
+ */
+const GlyphRenderMode GLYPH_RENDER_MODE = GLYPH_RENDER_MSDF;
+
+// 아틀라스 형태에 맞는 텍스트 쉐이더 기능 플래그 (bitmap 이면 TEXT_FEATURE_NONE)
+const unsigned int GLYPH_FEATURES = GLYPH_RENDER_MODE == GLYPH_RENDER_MSDF  ? TEXT_FEATURE_MSDF
+                                    : GLYPH_RENDER_MODE == GLYPH_RENDER_SDF ? TEXT_FEATURE_SDF
+                                                                            : TEXT_FEATURE_NONE;
 
 /** 스크린 해상도 선언 */
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
-/** FreeType 라이브러리로 로드한 glyph metrices(각 글꼴의 크기, 위치, baseline 등)를 파싱할 자료형 정의 */
-struct Character
+/**
+ * main() 이 어느 경로로 반환되더라도 리소스가 올바른 순서로 해제되도록 하는 guard 들
+ *
+ * 지역 변수는 선언의 역순으로 소멸되므로 GlfwSession -> FontLoader -> FreeTypeSession -> GL 객체들 순서로 선언하면,
+ * 에러로 중간에 return 하더라도 GL 객체들 -> FT_Face / FT_Library -> 폰트 바이트 -> OpenGL 컨텍스트(glfwTerminate()) 순서로 해제됨.
+ */
+struct GlfwSession
 {
-  unsigned int TextureID; // FreeType 내부에서 렌더링된 각 glyph 의 텍스쳐 버퍼 ID
-  glm::ivec2 Size;        // glyph 크기
-  glm::ivec2 Bearing;     // glyph 원점에서 x축, y축 방향으로 각각 떨어진 offset
-  unsigned int Advance;   // 현재 glyph 원점에서 다음 glyph 원점까지의 거리 (1/64px 단위로 정의되어 있으므로, 값 사용 시 1px 단위로 변환해야 함.)
+  ~GlfwSession() { glfwTerminate(); }
 };
-std::map<GLchar, Character> Characters;
 
-// 각 glyph 의 grayscale bitmap 을 적용할 2D Quad 의 VAO, VBO 객체 ID 변수 전역 선언 -> RenderText() 콜백함수 내에서 참조해야 하기 때문.
-unsigned int VAO, VBO;
+struct FreeTypeSession
+{
+  FT_Library library;
+  FT_Face face;
+
+  FreeTypeSession() : library(NULL), face(NULL) {}
+  ~FreeTypeSession()
+  {
+    if (face)
+    {
+      FT_Done_Face(face);
+    }
+    if (library)
+    {
+      FT_Done_FreeType(library);
+    }
+  }
+};
 
 int main()
 {
-  // GLFW 초기화 및 윈도우 설정 구성
+  // GLFW 초기화 및 윈도우 설정 구성 (main() 이 반환될 때 glfwSession 소멸자에서 GLFW 종료 및 메모리 반납)
   glfwInit();
+  GlfwSession glfwSession;
   glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
   glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
   glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -61,7 +120,6 @@ int main()
   if (window == NULL)
   {
     std::cout << "Failed to create GLFW window" << std::endl;
-    glfwTerminate();
     return -1;
   }
 
@@ -76,6 +134,9 @@ int main()
     return -1;
   }
 
+  // 컨텍스트 버전(3.3)보다 높은 core 기능이 ARB 확장으로 지원되면 해당 함수 포인터도 로드 (glBufferStorage, glGetProgramBinary 등)
+  loadGLExtensions((GLADloadproc)glfwGetProcAddress);
+
   /** OpenGL 전역 상태 설정 */
 
   // 2D Quad 를 2D View 로(= orthogonal 투영으로 상단에서) 렌더링할 것이므로 불필요한 은면 제거
@@ -85,38 +146,69 @@ int main()
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-  /** Text Rendering 쉐이더 생성 및 투영행렬 계산 */
+  /**
+   * FreeType 라이브러리, 폰트 바이트, FT_Face 는 아래 scope 밖에 선언하고 scope 안에서 초기화함.
+   *
+   * GlyphCache, TextShaper(hb_font) 가 FT_Face 를 참조하고 GlyphRasterizer 가 폰트 바이트를 참조하므로,
+   * 이들이 모두 소멸된 뒤(scope 가 닫힌 뒤)에 freeType 소멸자에서 FT_Face 와 FT_Library 를 해제함.
+   */
+  FontLoader fontLoader;
+  FreeTypeSession freeType;
+  FT_Library &ft = freeType.library;
+  FT_Face &face = freeType.face;
 
-  // 쉐이더 객체 생성 및 바인딩
-  Shader shader("resources/shaders/text.vs", "resources/shaders/text.fs");
-  shader.use();
+  /**
+   * GL 리소스를 소유하는 객체들(쉐이더 라이브러리, TextBatcher, glyph 캐시의 아틀라스 텍스쳐, TextMesh 버퍼 객체 등)은
+   * 이 scope 안에서만 살아있도록 해서, glfwTerminate() 로 OpenGL 컨텍스트가 파괴되기 전에 소멸자의 glDelete* 가 호출되도록 함.
+   * (scope 안의 에러 경로에서 return 하더라도 이 객체들이 먼저 소멸된 뒤에 위의 guard 들이 해제됨)
+   */
+  {
+    /**
+     * 쉐이더 라이브러리 및 TextBatcher 생성
+     *
+     * 텍스트 쉐이더는 text.vs / text.fs 하나뿐이며, TextBatcher 가 batch key 의 기능 플래그마다
+     * 필요한 define(INSTANCED, SDF, MSDF, OUTLINE, SHADOW)만 주입한 permutation 을 쉐이더 라이브러리에 등록해서 사용함.
+     *
+     * preloadVariant() 는 컴파일 명령만 제출하고 결과는 처음 그려질 때 확인하므로, 드라이버가 쉐이더들을 병렬로 컴파일하는 동안
+     * 아래의 FreeType 초기화와 glyph 로드를 함께 진행할 수 있음.
+     * (링킹된 프로그램 바이너리는 SHADER_CACHE_DIR 에 캐싱해두고 다음 실행부터는 GLSL 컴파일을 건너뜀
+     *  -> GL 4.1 또는 GL_ARB_get_program_binary 확장이 없는 드라이버에서는 캐시 없이 매번 컴파일함)
+     */
+    ShaderLibrary shaderLibrary((GLADloadproc)glfwGetProcAddress, SHADER_CACHE_DIR);
 
-  // orthogonal 투영행렬 계산 및 쉐이더에 전송
-  // orthogonal 투영행렬의 left, right, top, bottom 을 아래와 같이 정의하면, vertex position 을 screen space 좌표계로 정의하여 사용할 수 있음.
-  // -> 텍스트 위치(= 2D Quad 위치)는 아무래도 screen space 좌표계로 정의하는 게 더 직관적이니까!
-  glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), 0.0f, static_cast<float>(SCR_HEIGHT));
-  shader.setMat4("projection", projection);
+    // 정적 unit quad 하나를 공유하고 glyph 당 (위치, 크기, uv 영역, 색상)만 업로드하는 인스턴싱 모드 사용
+    // (2D Quad 의 VAO, VBO 객체는 TextBatcher 내부에서 관리)
+    TextBatcher textBatcher(shaderLibrary, "resources/shaders/text.vs", "resources/shaders/text.fs", TEXT_BATCH_INSTANCED);
+    textBatcher.preloadVariant(GLYPH_FEATURES);
+    textBatcher.preloadVariant(GLYPH_FEATURES | TEXT_FEATURE_SHADOW);
 
-  /** FreeType 라이브러리 초기화 */
-  FT_Library ft;
-  if (FT_Init_FreeType(&ft))
-  {
-    // FreeType 라이브러리 초기화 실패 -> FreeType 함수들은 에러 발생 시 0 이 아닌 값을 반환.
-    std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
-    return -1;
-  }
+    // glyph 준비(FreeType 초기화 ~ 자주 쓰는 glyph 로드)에 걸린 시간을 측정해서 디스크 캐시 적용 여부에 따른 startup 시간 비교
+    double glyphStartupBegin = glfwGetTime();
 
-  /** FT_Face 인터페이스로 .ttf 파일 로드 */
-  FT_Face face;
-  if (FT_New_Face(ft, "resources/fonts/Antonio-Bold.ttf", 0, &face))
-  {
-    // .ttf 파일 로드 실패
-    std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
-    return -1;
-  }
-  else
-  {
-    // .ttf 파일 로드 성공 시 작업들 처리
+    /** FreeType 라이브러리 초기화 */
+    if (FT_Init_FreeType(&ft))
+    {
+      // FreeType 라이브러리 초기화 실패 -> FreeType 함수들은 에러 발생 시 0 이 아닌 값을 반환.
+      std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+      return -1;
+    }
+
+    /**
+     * FT_Face 인터페이스로 .ttf 폰트 로드
+     *
+     * FontLoader 는 폰트 파일을 한 번만 읽기 전용으로 매핑(내장 폰트라면 실행파일에 내장된 바이트를 그대로 사용)하고,
+     * FT_New_Memory_Face() 로 그 바이트를 참조하는 FT_Face 를 만듦.
+     * 아래의 GlyphRasterizer worker 들도 같은 바이트를 공유하고, 다른 렌더러 프로세스들과도 page cache 의 같은 물리 페이지를 공유함.
+     * (FreeType 은 폰트 바이트를 복사하지 않고 계속 참조하므로, fontLoader 는 FT_Face 와 GlyphRasterizer 보다 오래 살아있어야 함)
+     */
+    const Resource *font = fontLoader.load(FONT_PATH);
+    face = font ? fontLoader.openFace(ft, FONT_PATH) : NULL;
+    if (!face)
+    {
+      // .ttf 폰트 로드 실패
+      std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+      return -1;
+    }
 
     // .ttf 파일로부터 렌더링할 glyph 들의 pixel size 설정 -> height 값만 설정하고 width 는 각 glyph 형태에 따라 동적으로 계산하도록 0 으로 지정
     FT_Set_Pixel_Sizes(face, 0, 48);
@@ -124,90 +216,168 @@ int main()
     // glyph 가 렌더링된 grayscale bitmap 의 텍스쳐 데이터 정렬 단위 변경 (하단 필기 참고)
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-    // 128 개의 ASCII 문자들의 glyph 들을 8-bit grayscale bitmap 텍스쳐 버퍼에 렌더링
-    for (unsigned char c = 0; c < 128; c++)
+    /**
+     * 멀티스레드 glyph rasterizer 생성
+     *
+     * 하드웨어 스레드 개수만큼 worker 를 만들고, 각 worker 가 자신만의 FT_Library / FT_Face 로 glyph 를 rasterize 함.
+     * GL 스레드는 완료된 bitmap 을 아틀라스에 업로드하기만 하므로, 많은 glyph 를 한꺼번에 로드할수록 코어 개수만큼 빨라짐.
+     * (glyph 캐시가 참조하므로 glyph 캐시보다 먼저 생성해서 나중에 소멸되도록 함)
+     */
+    GlyphRasterizer glyphRasterizer(font->data(), font->size(), 48, GLYPH_RENDER_MODE);
+
+    /**
+     * on-demand glyph 캐시 생성
+     *
+     * ASCII 128 개만 미리 rasterize 하고 FT_Face 를 바로 해제하면 그 외의 문자는 렌더링할 수 없고,
+     * 반대로 유니코드 전체를 미리 rasterize 하면 메모리가 감당할 수 없을 만큼 커짐.
+     *
+     * 따라서 FT_Face 를 살려둔 채로 문자가 처음 요청될 때 rasterize 해서 512x512 아틀라스 페이지에 추가하고,
+     * 페이지 메모리 합계가 예산(여기서는 페이지 4장 = 1MB)을 넘어서면 가장 오래 사용되지 않은 페이지를 재사용함.
+     */
+    GlyphCache glyphCache(face, 512, 4 * 512 * 512 * glyphChannelCount(GLYPH_RENDER_MODE), 2, GLYPH_RENDER_MODE);
+    glyphCache.setRasterizer(&glyphRasterizer);
+
+    /**
+     * HarfBuzz shaping 단계 생성
+     *
+     * 문자열을 codepoint 마다 glyph 하나로 대응시키는 대신 hb_shape() 로 ligature, GPOS kerning 등이 적용된 glyph run 을 만들고,
+     * glyph 캐시에는 codepoint 대신 glyph index 키(glyphIndexKey())로 요청함.
+     * 같은 문자열의 shaping 결과는 LRU 캐시에 보관되므로 매 프레임 다시 제출되는 문자열은 첫 프레임 이후로 shaping 을 건너뜀.
+     */
+    TextShaper textShaper(face, GLYPH_RENDER_MODE);
+
+    /**
+     * 디스크 캐시 적용
+     *
+     * 이전 실행에서 저장해 둔 캐시 파일이 같은 폰트 파일, pixel size, render mode 로 만들어졌다면
+     * 파일을 메모리 매핑해서 아틀라스 페이지를 그대로 업로드하므로, 캐시에 있는 glyph 는 FreeType 으로 다시 rasterize 하지 않음.
+     */
+    GlyphCacheKey glyphCacheKey = {hashBytes(font->data(), font->size()), 48, GLYPH_RENDER_MODE};
+    bool warmStartup = glyphCache.loadFromDisk(GLYPH_CACHE_PATH, glyphCacheKey);
+
+    // 자주 사용되는 printable ASCII 문자들은 첫 프레임에서 rasterize 가 몰리지 않도록 미리 로드 (디스크 캐시에 있는 glyph 는 건너뜀)
+    // -> TextMesh 들은 shaping 해서 그리므로 shaping 결과로 나올 기본 glyph index 키로,
+    //    매 프레임 바뀌는 HUD 라벨은 shaping 없이 codepoint 단위로 그리므로 codepoint 키로도 로드함.
+    std::vector<unsigned int> printableGlyphs;
+    for (unsigned int codepoint = 32; codepoint <= 126; codepoint++)
     {
-      if (FT_Load_Char(face, c, FT_LOAD_RENDER))
-      {
-        // 각 ASCII 문자에 해당하는 glyph 로드 실패
-        std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
-        continue;
-      }
-
-      // 각 glyph grayscale bitmap 텍스쳐 생성 및 bitmap 데이터 복사
-      unsigned int texture;
-      glGenTextures(1, &texture);
-      glBindTexture(GL_TEXTURE_2D, texture);
-      glTexImage2D(
-          GL_TEXTURE_2D,
-          0,
-          GL_RED,
-          face->glyph->bitmap.width,
-          face->glyph->bitmap.rows, // bitmap 버퍼 줄 수 = bitmap 버퍼 height
-          0,
-          GL_RED,
-          GL_UNSIGNED_BYTE,
-          face->glyph->bitmap.buffer);
-
-      // 텍스쳐 파라미터 설정
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-      // 로드된 glyph metrices 를 커스텀 자료형으로 파싱
-      Character character = {
-          texture,
-          glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-          glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-          static_cast<unsigned int>(face->glyph->advance.x)};
-      // std::map 컨테이너는 std::pair 를 node 로 삼아 key-value 쌍을 추가함. (참고로, std::map 은 red-black tree 기반의 컨테이너)
-      Characters.insert(std::pair<char, Character>(c, character));
+      printableGlyphs.push_back(glyphIndexKey(FT_Get_Char_Index(face, codepoint)));
     }
+    glyphCache.preload(&printableGlyphs[0], printableGlyphs.size());
+    glyphCache.preload(32, 126);
 
-    // 각 glyph 들의 텍스쳐 생성 완료 후 텍스쳐 바인딩 해제
-    glBindTexture(GL_TEXTURE_2D, 0);
-  }
+    // 같은 범위의 문자 쌍 kerning 을 미리 추출 (Antonio-Bold 처럼 'kern' 테이블이 없는 폰트는 0 쌍)
+    size_t kerningPairs = glyphCache.loadKerning(32, 126);
 
-  // FreeType 라이브러리 사용 완료 후 리소스 메모리 반납
-  FT_Done_Face(face);
-  FT_Done_FreeType(ft);
-
-  /** 2D Quad 의 VAO, VBO 객체 생성 및 설정 */
-  glGenVertexArrays(1, &VAO);
-  glGenBuffers(1, &VBO);
-  glBindVertexArray(VAO);
-  glBindBuffer(GL_ARRAY_BUFFER, VBO);
-  // 2D Quad 는 각 glyph metrices 에 따라 매 프레임마다 정점 데이터가 자주 변경되므로, GL_DYNAMIC_DRAW 모드로 정점 데이터 버퍼의 메모리를 예약함.
-  glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
-
-  /** rendering loop */
-  while (!glfwWindowShouldClose(window))
-  {
-    processInput(window);
+    std::cout << "Glyph startup (" << (warmStartup ? "warm" : "cold") << "): "
+              << (glfwGetTime() - glyphStartupBegin) * 1000.0 << " ms, " << kerningPairs << " kerning pairs" << std::endl;
 
-    // 버퍼 초기화
-    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // 리소스 리포트 : 폰트 바이트는 프로세스 간에 공유되는 매핑이므로 프로세스별 private 메모리는 아틀라스 텍스쳐 정도만 남음
+    const FontLoader::Report &fontReport = fontLoader.getReport();
+    std::cout << "Resources: " << fontReport.fonts << " font(s), "
+              << fontReport.mappedBytes / 1024 << " KB mapped + " << fontReport.embeddedBytes / 1024 << " KB embedded (shared), "
+              << glyphCache.getStats().residentBytes / 1024 << " KB glyph atlas" << std::endl;
 
-    // 주어진 std::string 컨테이너 문자열을 2D Quad 에 렌더링하는 함수 호출
-    RenderText(shader, "This is sample text", 25.0f, 25.0f, 1.0f, glm::vec3(0.5f, 0.8f, 0.2f));
-    RenderText(shader, "(C) LearnOpenGL.com", 540.0f, 570.0f, 0.5f, glm::vec3(0.3f, 0.7f, 0.9f));
+    // orthogonal 투영행렬 계산 및 TextBatcher 에 전달 (모든 쉐이더 permutation 에 적용됨)
+    // orthogonal 투영행렬의 left, right, top, bottom 을 아래와 같이 정의하면, vertex position 을 screen space 좌표계로 정의하여 사용할 수 있음.
+    // -> 텍스트 위치(= 2D Quad 위치)는 아무래도 screen space 좌표계로 정의하는 게 더 직관적이니까!
+    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(SCR_WIDTH), 0.0f, static_cast<float>(SCR_HEIGHT));
+    textBatcher.setProjection(projection);
 
-    // Back 버퍼에 렌더링된 최종 이미지를 Front 버퍼에 교체 -> blinking 현상 방지
-    glfwSwapBuffers(window);
+    /**
+     * 내용이 바뀌지 않는 문자열들은 TextMesh 로 한 번만 layout 해서 버퍼 객체에 올려둠
+     *
+     * 매 프레임 같은 문자열의 glyph 를 다시 조회하고 2D Quad 를 계산해서 업로드하는 대신,
+     * 렌더링 루프에서는 submitMesh() 로 제출만 하면 TextBatcher 가 보관된 정점 데이터를 그대로 그림.
+     * (큰 텍스트에만 그림자를 추가 -> 그림자가 없는 텍스트는 SHADOW define 이 없는 permutation 으로 그려짐)
+     */
+    TextMesh sampleText(&glyphCache);
+    sampleText.setShaper(&textShaper);
+    sampleText.setText("This is sample text");
+    sampleText.setPosition(25.0f, 25.0f);
+    sampleText.setColor(glm::vec4(0.5f, 0.8f, 0.2f, 1.0f));
+    sampleText.setFeatures(GLYPH_FEATURES | TEXT_FEATURE_SHADOW);
+
+    TextMesh copyrightText(&glyphCache);
+    copyrightText.setShaper(&textShaper);
+    copyrightText.setText("(C) LearnOpenGL.com");
+    copyrightText.setPosition(540.0f, 570.0f);
+    copyrightText.setScale(0.5f);
+    copyrightText.setColor(glm::vec4(0.3f, 0.7f, 0.9f, 1.0f));
+    copyrightText.setFeatures(GLYPH_FEATURES);
 
-    // 키보드, 마우스 입력 이벤트 발생 검사 후 등록된 콜백함수 호출 + 이벤트 발생에 따른 GLFWwindow 상태 업데이트
-    glfwPollEvents();
-  }
+    /**
+     * 매 프레임 내용이 바뀌는 라벨들(여기서는 프레임 통계 HUD)은 ParallelTextLayout 으로 제출
+     *
+     * 라벨마다의 layout 과 정점 데이터 생성을 work-stealing JobSystem 의 worker 들이 병렬로 처리하고,
+     * GL 스레드는 처음 사용되는 glyph 의 업로드와 결과를 TextBatcher 에 이어붙이는 일만 함.
+     * (라벨이 수백 개로 늘어나도 layout 단계는 코어 개수에 비례해서 빨라짐)
+     *
+     * HUD 라벨은 숫자가 바뀌면서 매 프레임 처음 보는 문자열이 되므로, TextShaper 에 넘기면 매번 캐시 miss 로 hb_shape() 와 할당이 일어나고
+     * 다시 사용될 TextMesh 들의 shaping 결과까지 LRU 캐시에서 밀어냄. 따라서 shaper 없이(NULL) codepoint 단위로 layout 함.
+     * (ligature 나 GPOS kerning 이 필요 없는 ASCII 숫자 / 단위 문자열이며, 'kern' 테이블 kerning 은 codepoint 경로에서도 적용됨)
+     */
+    JobSystem jobSystem;
+    ParallelTextLayout hudLayout(jobSystem, glyphCache, NULL);
+    double lastFrameTime = glfwGetTime();
+
+    /** rendering loop */
+    while (!glfwWindowShouldClose(window))
+    {
+      processInput(window);
+
+      // glyph 캐시의 페이지 사용 시각(LRU) 갱신 기준이 되는 프레임 번호 증가
+      glyphCache.beginFrame();
+
+      // 아직 사용되지 않은 쉐이더들 중 드라이버가 컴파일을 끝낸 쉐이더의 결과를 기다림 없이 확인
+      shaderLibrary.poll();
+
+      // 버퍼 초기화
+      glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+      // 고정된 문자열들은 layout 없이 보관된 정점 데이터로 그리도록 제출 (매 프레임 바뀌는 문자열은 아래의 hudLayout 으로 제출)
+      textBatcher.submitMesh(sampleText);
+      textBatcher.submitMesh(copyrightText);
+
+      // 프레임 통계 HUD (직전 프레임의 flush() 통계를 표시하며, 문자열은 스택 버퍼에 만들어서 매 프레임 할당하지 않음)
+      // -> snprintf() 가 반환한 길이로 TextView 를 만들어서 strlen() 으로 다시 길이를 세지 않음 (버퍼가 모자라면 잘린 길이 사용)
+      double now = glfwGetTime();
+      char frameLine[64];
+      char batchLine[64];
+      int frameLength = std::snprintf(frameLine, sizeof(frameLine), "%.1f ms / frame", (now - lastFrameTime) * 1000.0);
+      int batchLength = std::snprintf(batchLine, sizeof(batchLine), "%u glyphs, %u draw calls", textBatcher.getStats().glyphs, textBatcher.getStats().drawCalls);
+      lastFrameTime = now;
+
+      TextBlock hudBlocks[] = {
+          {TextView(frameLine, std::min<size_t>(frameLength, sizeof(frameLine) - 1)), 25.0f, 570.0f, 0.35f, glm::vec4(0.9f, 0.9f, 0.9f, 1.0f), GLYPH_FEATURES},
+          {TextView(batchLine, std::min<size_t>(batchLength, sizeof(batchLine) - 1)), 25.0f, 552.0f, 0.35f, glm::vec4(0.9f, 0.9f, 0.9f, 1.0f), GLYPH_FEATURES},
+      };
+      hudLayout.build(hudBlocks, sizeof(hudBlocks) / sizeof(hudBlocks[0]), textBatcher.getMode());
+      hudLayout.submit(textBatcher);
+
+      // 이번 프레임에 제출된 모든 문자열을 (쉐이더 기능 조합, blending 상태, 아틀라스 텍스쳐) 별로 묶어서 한꺼번에 렌더링
+      // -> 렌더링 결과 draw call 횟수 등은 textBatcher.getStats() 로 확인 가능.
+      textBatcher.flush();
+
+      // Back 버퍼에 렌더링된 최종 이미지를 Front 버퍼에 교체 -> blinking 현상 방지
+      glfwSwapBuffers(window);
+
+      // 키보드, 마우스 입력 이벤트 발생 검사 후 등록된 콜백함수 호출 + 이벤트 발생에 따른 GLFWwindow 상태 업데이트
+      glfwPollEvents();
+    }
+
+    // 이번 실행에서 새로 링킹된 쉐이더 프로그램의 바이너리 저장 (프레임 도중 poll() 에서는 저장하지 않고 종료 시점으로 미뤄둠)
+    shaderLibrary.saveBinaries();
 
-  // GLFW 종료 및 메모리 반납
-  glfwTerminate();
+    // 이번 실행에서 새로 rasterize 된 glyph 가 있다면 다음 실행을 위해 디스크 캐시 갱신
+    if (glyphCache.isDirty())
+    {
+      glyphCache.saveToDisk(GLYPH_CACHE_PATH, glyphCacheKey);
+    }
+  }
 
+  // FreeType 리소스와 GLFW 는 위 scope 의 GL 객체들이 모두 소멸된 뒤에 freeType, glfwSession 소멸자에서 해제됨
   return 0;
 }
 
@@ -229,102 +399,6 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
   glViewport(0, 0, width, height);
 }
 
-// 주어진 std::string 문자열을 주어진 위치, 크기, 색상으로 렌더링하는 콜백함수
-void RenderText(Shader &shader, std::string text, float x, float y, float scale, glm::vec3 color)
-{
-  // 주어진 Shader 객체 바인딩 및 색상값 전송
-  shader.use();
-  shader.setVec3("textColor", color);
-
-  // grayscale bitmap 텍스쳐(glyph 텍스쳐)를 바인딩할 texture unit 활성화 및 전송
-  glActiveTexture(0);
-  // 예제코드 원본에서는 0번 texture unit(기본값) 이다보니 쉐이더 전송 코드는 생략한 것으로 보임. (but, 가독성 및 확장성을 위해 명시적으로 초기화 권장)
-  shader.setInt("text", 0);
-
-  // glyph 텍스쳐를 적용할 2D Quad 정점 데이터 VAO 객체 바인딩
-  glBindVertexArray(VAO);
-
-  /** 주어진 문자열 컨테이너 std::string 을 순회하며 각 문자에 대응되는 glyph 를 2D Quad 에 렌더링  */
-  // std::string 컨테이너를 순회하는 '읽기 전용' 이터레이터 선언
-  std::string::const_iterator c;
-  /**
-   * 읽기 전용 이터레이터 c 에는 연속 메모리 블록으로 저장되는 std::string 컨테이너 내부의
-   * 각 char 타입의 문자들이 저장된 메모리 블록 주소값이 담겨 있음.
-   *
-   * 따라서, *c (= de-referencing)을 통해 해당 메모리에 저장된 실제 char 타입 문자에 접근 가능.
-   *
-   * 이때, for 문 내에서 c++ 연산자를 사용하면 현재 가리키고 있는 메모리 주소로부터
-   * 포인터가 가리키는 데이터 타입(= char)의 크기(= 1 byte)만큼 더해서 다음 메모리 블록에 저장된
-   * char 타입 문자를 가리키는 주소값을 얻을 수 있음.
-   *
-   * -> 즉, 연속 메모리 블록 형태로 저장된 std::string 컨테이너의 각 char 타입 값을
-   * 하나씩 순차적으로 접근할 수 있도록 for 문을 구성한 것.
-   */
-  for (c = text.begin(); c != text.end(); c++)
-  {
-    // 현재 순회 중인 char 타입 문자에 대응되는 glyph metrices 를 가져옴
-    Character ch = Characters[*c];
-
-    // 현재 문자를 렌더링할 glyph 의 위치(= 2D Quad 의 좌하단 정점의 좌표값) 계산
-    /**
-     * 참고로, 로컬 변수 x, y 에는 현재 glyph 원점(origin)이 저장되어 있음.
-     * (LearnOpenGL Glyph Metrics 이미지 참고)
-     *
-     * 여기에 Bearing 값을 더해 glyph 를 원점에서 얼만큼 떨어트릴 지 결정함.
-     * 이때, g, j, p, j 처럼 glyph 일부가 baseline(즉, glyph 원점이 포함된 수평선) 하단에 내려오는 글꼴의 경우,
-     * Bearing.y 값이 Size.y 값보다 작게 계산되고,
-     *
-     * X, Z, Y 처럼 glyph 가 정확히 baseline 위에 안착하는 글꼴의 경우 Bearing.y == Size.y 로 계산되어
-     * 글꼴에 따라 glyph 위치값(= 2D Quad 의 좌하단 정점의 좌표)을 baseline 밑으로 내리도록 계산함.
-     */
-    float xpos = x + ch.Bearing.x * scale;
-    float ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
-
-    // 현재 문자를 렌더링할 glyph 의 크기(= 2D Quad 의 width, height) 계산
-    float w = ch.Size.x * scale;
-    float h = ch.Size.y * scale;
-
-    // glyph 의 위치(= 2D Quad 좌하단 정점)와 크기(= 2D Quad 의 width, height)를 가지고 2D Quad 정점 데이터 계산
-    float vertices[6][4] = {
-        // position      // uv
-        {xpos, ypos + h, 0.0f, 0.0f},
-        {xpos, ypos, 0.0f, 1.0f},
-        {xpos + w, ypos, 1.0f, 1.0f},
-        {xpos, ypos + h, 0.0f, 0.0f},
-        {xpos + w, ypos, 1.0f, 1.0f},
-        {xpos + w, ypos + h, 1.0f, 0.0f},
-    };
-
-    // 2D Quad 에 적용할 grayscale bitmap 텍스쳐 버퍼 바인딩
-    glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-
-    // 재계산된 2D Quad 정점 데이터를 VBO 객체에 덮어쓰기
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // 2D Quad draw call
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    /**
-     * 현재 glyph 원점에서 Advance 만큼 떨어진 다음 glyph 원점의 x 좌표값 계산
-     *
-     * 이 때, FreeType 라이브러리의 Advance 값은 1/64 px 단위로 계산되기 때문에,
-     * 이것을 1px 단위로 변환해서 사용해야 함.
-     *
-     * 이를 위해 1/2^6(= 1/64)제곱값을 구해서 Advance 에 곱할 수도 있으나,
-     * >> 6, 즉, right bit shift 연산을 6번 수행하면 1/2 를 6제곱하는 것과 동일함.
-     *
-     * 심지어, bit shift 연산이 거듭제곱보다 더 빠르기 때문에, 성능 최적화에 유리함.
-     */
-    x += (ch.Advance >> 6) * scale;
-  }
-
-  // std::string 컨테이너에 저장된 모든 문자열 렌더링 완료 후, 텍스쳐 및 VAO 객체 바인딩 해제
-  glBindVertexArray(0);
-  glBindTexture(GL_TEXTURE_2D, 0);
-}
-
 /**
  * glPixelStorei(GL_UNPACK_ALIGNMENT, 1)
  *
@@ -1,147 +1,409 @@
 #include "shader/shader.hpp"
 
+#include "utils/hash.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/resource.hpp"
+
+#include <algorithm> // std::sort, std::count
+#include <cstdio>    // std::sprintf
+#include <cstring>   // std::strcmp, std::memcpy
+
+namespace
+{
+  /**
+   * 쉐이더 소스의 #version 줄 바로 아래에 define 들을 주입
+   *
+   * #version 은 반드시 소스의 첫 번째 지시문이어야 하므로 소스 맨 앞에 붙일 수 없음.
+   * 주입한 줄 수만큼 컴파일 에러의 줄 번호가 밀리지 않도록 마지막에 #line 으로 원래 줄 번호를 되돌려 줌.
+   */
+  void injectDefines(std::string &code, const std::vector<std::string> &defines)
+  {
+    if (defines.empty())
+    {
+      return;
+    }
+
+    size_t insertAt = 0;
+    int nextLine = 1;
+    size_t version = code.find("#version");
+    if (version != std::string::npos)
+    {
+      size_t lineEnd = code.find('\n', version);
+      insertAt = (lineEnd == std::string::npos) ? code.size() : lineEnd + 1;
+      nextLine = 1 + (int)std::count(code.begin(), code.begin() + insertAt, '\n');
+    }
+
+    std::string injected;
+    if (insertAt > 0 && code[insertAt - 1] != '\n')
+    {
+      injected += '\n';
+    }
+    for (size_t i = 0; i < defines.size(); i++)
+    {
+      injected += "#define " + defines[i] + "\n";
+    }
+
+    char line[32];
+    std::sprintf(line, "#line %d\n", nextLine);
+    injected += line;
+
+    code.insert(insertAt, injected);
+  }
+}
+
 // Shader 클래스 생성자
-Shader::Shader(const GLchar *vertexPath, const GLchar *fragmentPath)
+Shader::Shader(const GLchar *vertexPath, const GLchar *fragmentPath, const std::vector<std::string> &defines,
+               const char *binaryCacheDir, bool deferred)
+    : ID(0), vertexShader(0), fragmentShader(0), fromBinary(false), finished(false), binaryUnsaved(false), sourceHash(0), driverHash(0)
 {
-  // 쉐이더 코드를 std::string 타입으로 파싱하여 저장할 변수 선언
-  std::string vertexCode;
-  std::string fragmentCode;
+  /**
+   * 쉐이더 소스 로드
+   *
+   * 실행파일에 내장된 쉐이더는 파일 시스템을 거치지 않고 내장 배열에서 바로 복사하며,
+   * 개발용 override 디렉토리나 내장되지 않은 경로의 쉐이더는 파일을 메모리 매핑해서 읽음. (Resource 클래스 참고)
+   */
+  Resource vShaderResource;
+  Resource fShaderResource;
+  if (vShaderResource.open(vertexPath) && fShaderResource.open(fragmentPath))
+  {
+    vertexCode.assign(reinterpret_cast<const char *>(vShaderResource.data()), vShaderResource.size());
+    fragmentCode.assign(reinterpret_cast<const char *>(fShaderResource.data()), fShaderResource.size());
+  }
+  else
+  {
+    std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << (vShaderResource.isOpen() ? fragmentPath : vertexPath) << std::endl;
+  }
+
+  // 요청된 기능의 define 주입 (해시 계산 전에 주입해야 variant 마다 캐시 키가 달라짐)
+  injectDefines(vertexCode, defines);
+  injectDefines(fragmentCode, defines);
+
+  /**
+   * 프로그램 바이너리는 GL 4.1 core 또는 GL_ARB_get_program_binary 확장이 필요함.
+   * 3.3 컨텍스트에서도 확장이 있으면 loadGLExtensions() 가 함수 포인터를 채워두므로 포인터만 확인하며,
+   * 함수가 없거나 드라이버가 지원하는 바이너리 포맷이 하나도 없으면 캐시를 사용하지 않음.
+   */
+  GLint binaryFormats = 0;
+  if (binaryCacheDir && glad_glGetProgramBinary && glad_glProgramBinary && glad_glProgramParameteri)
+  {
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+  }
+
+  if (binaryFormats > 0)
+  {
+    /** 프로그램 바이너리 캐시 키 계산 */
+    // 두 쉐이더 소스 사이에 구분자를 넣어서 소스 경계만 다른 경우에도 해시가 달라지도록 함
+    sourceHash = hashBytes(vertexCode.data(), vertexCode.size());
+    sourceHash = hashBytes("\0", 1, sourceHash);
+    sourceHash = hashBytes(fragmentCode.data(), fragmentCode.size(), sourceHash);
 
-  // std::ifstream을 사용하여 파일 읽기
-  std::ifstream vShaderFile;
-  std::ifstream fShaderFile;
+    driverHash = hashBytes(NULL, 0); // 빈 데이터의 해시 = FNV offset basis 에서 시작
+    const GLenum driverStrings[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    for (int i = 0; i < 3; i++)
+    {
+      const char *value = reinterpret_cast<const char *>(glGetString(driverStrings[i]));
+      if (value)
+      {
+        driverHash = hashBytes(value, std::strlen(value) + 1, driverHash);
+      }
+    }
 
-  // 파일 열기와 예외 처리
-  vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-  fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    // 쉐이더 variant 마다 캐시 파일이 겹치지 않도록 소스 해시를 파일 이름으로 사용
+    char fileName[32];
+    std::sprintf(fileName, "/%016llx.glprogram", sourceHash);
+    cachePath = std::string(binaryCacheDir) + fileName;
+
+    fromBinary = loadProgramBinary();
+  }
 
-  try
+  // 캐시가 없거나 사용할 수 없으면 소스 컴파일 (캐시를 사용 중이라면 finish() 에서 다음 실행을 위해 바이너리 저장)
+  if (!fromBinary)
   {
-    // 파일 열기
-    vShaderFile.open(vertexPath);
-    fShaderFile.open(fragmentPath);
+    compileProgram(!cachePath.empty());
+  }
 
-    // 파일 스트림을 문자열로 읽기
-    std::stringstream vShaderStream, fShaderStream;
-    vShaderStream << vShaderFile.rdbuf();
-    fShaderStream << fShaderFile.rdbuf();
+  // 바로 결과를 확인하는 경우는 로딩 시점이므로 바이너리도 바로 저장 (deferred 면 saveBinary() 를 호출할 때까지 미룸)
+  if (!deferred)
+  {
+    finish();
+    saveBinary();
+  }
+}
 
-    // 파일 스트림 닫기
-    vShaderFile.close();
-    fShaderFile.close();
+// 컴파일 / 링킹 결과를 확인하고 프로그램을 사용 가능한 상태로 만듦
+void Shader::finish()
+{
+  if (finished)
+  {
+    return;
+  }
+  finished = true;
 
-    // 문자열로 파싱
-    vertexCode = vShaderStream.str();
-    fragmentCode = fShaderStream.str();
+  // 드라이버가 업데이트되었는데 버전 문자열은 같은 경우처럼 바이너리가 거부될 수 있으므로, 링킹 결과를 확인해서 실패하면 소스 컴파일로 대체
+  if (fromBinary)
+  {
+    GLint success = 0;
+    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+      glDeleteProgram(ID);
+      fromBinary = false;
+      compileProgram(true);
+    }
   }
-  catch (std::ifstream::failure &e)
+
+  if (!fromBinary)
   {
-    std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << e.what() << std::endl;
+    checkCompileErrors(vertexShader, "VERTEX");
+    checkCompileErrors(fragmentShader, "FRAGMENT");
+    checkCompileErrors(ID, "PROGRAM");
+
+    // 쉐이더 객체 삭제
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    vertexShader = 0;
+    fragmentShader = 0;
+
+    // glGetProgramBinary() 와 파일 쓰기는 느리므로, 프레임 도중 poll() / use() 에서 finish() 되더라도 여기서 저장하지 않고 saveBinary() 로 미룸
+    binaryUnsaved = !cachePath.empty();
   }
 
+  // 더 이상 소스 컴파일로 대체할 일이 없으므로 소스 문자열 메모리 반납
+  std::string().swap(vertexCode);
+  std::string().swap(fragmentCode);
+
+  buildUniformTable();
+}
+
+// 버텍스 / 프래그먼트 쉐이더 소스의 컴파일 및 프로그램 링킹 명령 제출
+void Shader::compileProgram(bool retrievable)
+{
   // C 스타일 문자열로 변환
   const char *vShaderCode = vertexCode.c_str();
   const char *fShaderCode = fragmentCode.c_str();
 
-  // 쉐이더 객체 생성 및 컴파일
-  unsigned int vertex, fragment;
-
   // 버텍스 쉐이더 생성 및 컴파일
-  vertex = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(vertex, 1, &vShaderCode, NULL);
-  glCompileShader(vertex);
-  checkCompileErrors(vertex, "VERTEX");
+  vertexShader = glCreateShader(GL_VERTEX_SHADER);
+  glShaderSource(vertexShader, 1, &vShaderCode, NULL);
+  glCompileShader(vertexShader);
 
   // 프래그먼트 쉐이더 생성 및 컴파일
-  fragment = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(fragment, 1, &fShaderCode, NULL);
-  glCompileShader(fragment);
-  checkCompileErrors(fragment, "FRAGMENT");
+  fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+  glShaderSource(fragmentShader, 1, &fShaderCode, NULL);
+  glCompileShader(fragmentShader);
 
   // 쉐이더 프로그램 객체 생성 및 쉐이더 객체 연결
   ID = glCreateProgram();
-  glAttachShader(ID, vertex);
-  glAttachShader(ID, fragment);
+  if (retrievable)
+  {
+    // 링킹 전에 힌트를 줘야 드라이버가 glGetProgramBinary() 로 꺼낼 수 있는 형태의 바이너리를 보관해 둠
+    glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glAttachShader(ID, vertexShader);
+  glAttachShader(ID, fragmentShader);
   glLinkProgram(ID);
-  checkCompileErrors(ID, "PROGRAM");
 
-  // 쉐이더 객체 삭제
-  glDeleteShader(vertex);
-  glDeleteShader(fragment);
+  // 컴파일 / 링킹 결과는 여기서 바로 조회하지 않고 finish() 에서 확인함 (바로 조회하면 드라이버 컴파일이 끝날 때까지 멈추게 됨)
 }
 
-// Shader 클래스 소멸자
-Shader::~Shader()
+namespace
 {
-  // 쉐이더 프로그램 객체 메모리 반납
-  glDeleteProgram(ID);
-}
+  /**
+   * 프로그램 바이너리 캐시 파일 형식
+   *
+   * [ProgramBinaryHeader][드라이버가 반환한 바이너리 x length]
+   * 파일 형식이 바뀌면 PROGRAM_BINARY_VERSION 을 올려서 예전 캐시 파일이 무시되도록 해야 함.
+   */
+  const char PROGRAM_BINARY_MAGIC[4] = {'G', 'L', 'P', 'B'};
+  const unsigned int PROGRAM_BINARY_VERSION = 1;
 
-// ShaderProgram 객체 활성화
-void Shader::use()
-{
-  glUseProgram(ID);
+  struct ProgramBinaryHeader
+  {
+    char magic[4];
+    unsigned int version;
+    unsigned long long sourceHash;
+    unsigned long long driverHash;
+    unsigned int binaryFormat;
+    unsigned int length;
+  };
 }
 
-// 유니폼 변수 관련 유틸리티
-void Shader::setBool(const std::string &name, bool value) const
+// 프로그램 바이너리 캐시 파일로부터 프로그램 복원
+bool Shader::loadProgramBinary()
 {
-  glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
-}
+  MappedFile file;
+  if (!file.open(cachePath.c_str()) || file.size() < sizeof(ProgramBinaryHeader))
+  {
+    return false;
+  }
 
-void Shader::setInt(const std::string &name, int value) const
-{
-  glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
-}
+  ProgramBinaryHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC)) != 0 ||
+      header.version != PROGRAM_BINARY_VERSION ||
+      header.sourceHash != sourceHash ||
+      header.driverHash != driverHash ||
+      file.size() - sizeof(header) < header.length)
+  {
+    return false;
+  }
 
-void Shader::setFloat(const std::string &name, float value) const
-{
-  glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+  // 링킹 결과는 finish() 에서 확인함
+  ID = glCreateProgram();
+  glProgramBinary(ID, header.binaryFormat, file.data() + sizeof(header), static_cast<GLsizei>(header.length));
+  return true;
 }
 
-void Shader::setVec2(const std::string &name, const glm::vec2 &value) const
+// 링킹된 프로그램의 바이너리를 캐시 파일로 저장
+void Shader::saveProgramBinary() const
 {
-  glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-}
+  GLint success = 0;
+  GLint length = 0;
+  glGetProgramiv(ID, GL_LINK_STATUS, &success);
+  glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (!success || length <= 0)
+  {
+    return;
+  }
 
-void Shader::setVec2(const std::string &name, float x, float y) const
-{
-  glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
-}
+  std::vector<char> binary(length);
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(ID, length, NULL, &binaryFormat, &binary[0]);
 
-void Shader::setVec3(const std::string &name, const glm::vec3 &value) const
-{
-  glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-}
+  ProgramBinaryHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, PROGRAM_BINARY_MAGIC, sizeof(PROGRAM_BINARY_MAGIC));
+  header.version = PROGRAM_BINARY_VERSION;
+  header.sourceHash = sourceHash;
+  header.driverHash = driverHash;
+  header.binaryFormat = binaryFormat;
+  header.length = static_cast<unsigned int>(length);
 
-void Shader::setVec3(const std::string &name, float x, float y, float z) const
-{
-  glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+  std::ofstream out(cachePath.c_str(), std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "ERROR::SHADER::PROGRAM_BINARY_NOT_SUCCESSFULLY_WRITTEN" << std::endl;
+    return;
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(&binary[0], length);
 }
 
-void Shader::setVec4(const std::string &name, const glm::vec4 &value) const
+// finish() 에서 미뤄둔 프로그램 바이너리 캐시 저장
+void Shader::saveBinary()
 {
-  glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+  if (!binaryUnsaved)
+  {
+    return;
+  }
+  binaryUnsaved = false;
+  saveProgramBinary();
 }
 
-void Shader::setVec4(const std::string &name, float x, float y, float z, float w) const
+// Shader 클래스 소멸자
+Shader::~Shader()
 {
-  glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+  // 아직 저장하지 않은 바이너리가 있다면 프로그램을 삭제하기 전에 저장
+  saveBinary();
+
+  // 쉐이더 프로그램 객체 메모리 반납
+  glDeleteProgram(ID);
 }
 
-void Shader::setMat2(const std::string &name, const glm::mat2 &mat) const
+// ShaderProgram 객체 활성화
+void Shader::use()
 {
-  glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+  finish();
+  glUseProgram(ID);
 }
 
-void Shader::setMat3(const std::string &name, const glm::mat3 &mat) const
+// 이름으로 uniform 핸들 조회
+UniformHandle Shader::getUniform(const char *name) const
 {
-  glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+  // uniform 테이블은 이름순으로 정렬되어 있으므로 이진 탐색 (문자열 복사 없이 strcmp 로만 비교)
+  size_t first = 0;
+  size_t last = uniforms.size();
+  while (first < last)
+  {
+    size_t middle = first + (last - first) / 2;
+    int order = std::strcmp(uniforms[middle].name.c_str(), name);
+    if (order == 0)
+    {
+      return uniforms[middle].handle;
+    }
+    if (order < 0)
+    {
+      first = middle + 1;
+    }
+    else
+    {
+      last = middle;
+    }
+  }
+
+  UniformHandle missing = {-1, GL_NONE};
+  return missing;
 }
 
-void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const
+// 링킹된 프로그램의 active uniform 들을 조회해서 이름순으로 정렬된 uniform 테이블 생성
+void Shader::buildUniformTable()
 {
-  glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+  uniforms.clear();
+
+  GLint count = 0;
+  GLint maxLength = 0;
+  glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+  if (count <= 0 || maxLength <= 0)
+  {
+    return;
+  }
+
+  std::vector<char> name(maxLength);
+  for (GLint i = 0; i < count; i++)
+  {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type = GL_NONE;
+    glGetActiveUniform(ID, static_cast<GLuint>(i), maxLength, &length, &size, &type, &name[0]);
+
+    // uniform block 멤버처럼 location 이 없는 uniform 은 glUniform*() 으로 갱신할 수 없으므로 제외
+    GLint location = glGetUniformLocation(ID, &name[0]);
+    if (location < 0)
+    {
+      continue;
+    }
+
+    UniformInfo info;
+    info.name.assign(&name[0], length);
+    info.handle.location = location;
+    info.handle.type = type;
+    if (info.name.size() <= 3 || info.name.compare(info.name.size() - 3, 3, "[0]") != 0)
+    {
+      uniforms.push_back(info);
+      continue;
+    }
+
+    /**
+     * 배열 uniform 은 "[0]" 이 붙은 이름 하나만 active uniform 으로 조회되므로
+     * "[0]" 을 제거한 이름(첫 번째 원소)과 "name[0]" ~ "name[size - 1]" 원소별 이름을 모두 테이블에 등록함.
+     *
+     * 원소별 location 이 연속된다는 보장은 GL 3.3 명세에 없으므로 base + i 로 계산하지 않고 링킹 시점에 하나씩 조회해 둠.
+     */
+    std::string base = info.name.substr(0, info.name.size() - 3);
+    info.name = base;
+    uniforms.push_back(info);
+    for (GLint element = 0; element < size; element++)
+    {
+      char index[16];
+      std::sprintf(index, "[%d]", element);
+      info.name = base + index;
+      info.handle.location = element == 0 ? location : glGetUniformLocation(ID, info.name.c_str());
+      uniforms.push_back(info);
+    }
+  }
+
+  std::sort(uniforms.begin(), uniforms.end());
 }
 
 // 쉐이더 객체 및 쉐이더 프로그램 객체의 컴파일 및 링킹 에러 대응
@@ -0,0 +1,161 @@
+#include "shader/shader_library.hpp"
+
+#include "utils/gl_extensions.hpp"
+
+#include <algorithm> // std::find, std::sort
+
+/**
+ * GL_KHR_parallel_shader_compile 확장 상수 및 함수 타입
+ *
+ * glad 로더에 포함되지 않은 확장이므로 직접 정의하고, 함수 포인터는 런타임에 loader 로 불러옴.
+ * (GL_ARB_parallel_shader_compile 도 같은 값과 같은 형태의 함수를 사용함)
+ */
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+typedef void(APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+// ShaderLibrary 클래스 생성자
+ShaderLibrary::ShaderLibrary(GLADloadproc loader, const char *binaryCacheDir)
+    : binaryCacheDir(binaryCacheDir ? binaryCacheDir : ""), parallel(false)
+{
+  const char *functionName = NULL;
+  if (hasGLExtension("GL_KHR_parallel_shader_compile"))
+  {
+    functionName = "glMaxShaderCompilerThreadsKHR";
+  }
+  else if (hasGLExtension("GL_ARB_parallel_shader_compile"))
+  {
+    functionName = "glMaxShaderCompilerThreadsARB";
+  }
+
+  if (functionName && loader)
+  {
+    PFNGLMAXSHADERCOMPILERTHREADSKHRPROC maxShaderCompilerThreads =
+        reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(loader(functionName));
+    if (maxShaderCompilerThreads)
+    {
+      // 0xFFFFFFFF 는 컴파일 스레드 개수를 드라이버가 판단하는 최대값으로 정하도록 함
+      maxShaderCompilerThreads(0xFFFFFFFFu);
+      parallel = true;
+    }
+  }
+}
+
+// ShaderLibrary 클래스 소멸자
+ShaderLibrary::~ShaderLibrary()
+{
+  for (std::map<std::string, Shader *>::iterator it = shaders.begin(); it != shaders.end(); ++it)
+  {
+    delete it->second;
+  }
+}
+
+// 쉐이더 프로그램의 컴파일 / 링킹을 제출하고 이름으로 등록
+Shader *ShaderLibrary::add(const std::string &name, const GLchar *vertexPath, const GLchar *fragmentPath,
+                           const std::vector<std::string> &defines)
+{
+  std::map<std::string, Shader *>::iterator it = shaders.find(name);
+  if (it != shaders.end())
+  {
+    return it->second;
+  }
+
+  // 결과 확인을 미뤄서(deferred) 다음 프로그램의 제출이 이전 프로그램의 컴파일 완료를 기다리지 않도록 함
+  Shader *shader = new Shader(vertexPath, fragmentPath, defines, binaryCacheDir.empty() ? NULL : binaryCacheDir.c_str(), true);
+  shaders[name] = shader;
+  pending.push_back(shader);
+  return shader;
+}
+
+// 이름으로 등록된 Shader 반환
+Shader *ShaderLibrary::get(const std::string &name)
+{
+  std::map<std::string, Shader *>::iterator it = shaders.find(name);
+  if (it == shaders.end())
+  {
+    std::cout << "ERROR::SHADER_LIBRARY::SHADER_NOT_FOUND: " << name << std::endl;
+    return NULL;
+  }
+
+  Shader *shader = it->second;
+  if (!shader->isFinished())
+  {
+    // 처음 사용되는 시점에만 컴파일 완료를 기다림
+    shader->finish();
+    pending.erase(std::find(pending.begin(), pending.end(), shader));
+  }
+  return shader;
+}
+
+// permutation 의 등록 이름 생성
+std::string ShaderLibrary::variantName(const GLchar *vertexPath, const GLchar *fragmentPath, std::vector<std::string> defines)
+{
+  std::sort(defines.begin(), defines.end());
+
+  std::string name = std::string(vertexPath) + "|" + fragmentPath + "|";
+  for (size_t i = 0; i < defines.size(); i++)
+  {
+    if (i > 0)
+    {
+      name += ",";
+    }
+    name += defines[i];
+  }
+  return name;
+}
+
+// define 조합만 다르게 주입한 permutation 을 등록
+Shader *ShaderLibrary::addVariant(const GLchar *vertexPath, const GLchar *fragmentPath, const std::vector<std::string> &defines)
+{
+  return add(variantName(vertexPath, fragmentPath, defines), vertexPath, fragmentPath, defines);
+}
+
+// define 조합에 해당하는 permutation 반환 (등록되지 않았다면 등록 후 finish())
+Shader *ShaderLibrary::getVariant(const GLchar *vertexPath, const GLchar *fragmentPath, const std::vector<std::string> &defines)
+{
+  std::string name = variantName(vertexPath, fragmentPath, defines);
+  add(name, vertexPath, fragmentPath, defines);
+  return get(name);
+}
+
+// 드라이버가 컴파일을 끝낸 프로그램들만 finish() 함
+void ShaderLibrary::poll()
+{
+  size_t remaining = 0;
+  for (size_t i = 0; i < pending.size(); i++)
+  {
+    // Shader::use() 로 이미 finish() 된 프로그램은 목록에서 제거만 함
+    if (pending[i]->isFinished())
+    {
+      continue;
+    }
+
+    // GL_COMPLETION_STATUS_KHR 조회는 GL_LINK_STATUS 와 달리 컴파일이 끝나지 않았어도 기다리지 않고 바로 GL_FALSE 를 반환함
+    GLint completed = GL_FALSE;
+    if (parallel)
+    {
+      glGetProgramiv(pending[i]->ID, GL_COMPLETION_STATUS_KHR, &completed);
+    }
+
+    if (completed)
+    {
+      pending[i]->finish();
+    }
+    else
+    {
+      pending[remaining++] = pending[i];
+    }
+  }
+  pending.resize(remaining);
+}
+
+// 아직 저장하지 않은 프로그램 바이너리를 캐시 디렉토리에 저장
+void ShaderLibrary::saveBinaries()
+{
+  for (std::map<std::string, Shader *>::iterator it = shaders.begin(); it != shaders.end(); ++it)
+  {
+    it->second->saveBinary();
+  }
+}
@@ -0,0 +1,69 @@
+#include "text/font_loader.hpp"
+
+#include <iostream> // 콘솔 입출력을 위한 헤더
+
+// FontLoader 클래스 생성자
+FontLoader::FontLoader()
+{
+  report.fonts = 0;
+  report.mappedBytes = 0;
+  report.embeddedBytes = 0;
+}
+
+// FontLoader 클래스 소멸자
+FontLoader::~FontLoader()
+{
+  for (std::map<std::string, Resource *>::iterator it = fonts.begin(); it != fonts.end(); ++it)
+  {
+    delete it->second;
+  }
+}
+
+// 폰트 파일 바이트를 가져옴
+const Resource *FontLoader::load(const char *path)
+{
+  std::map<std::string, Resource *>::iterator it = fonts.find(path);
+  if (it != fonts.end())
+  {
+    return it->second;
+  }
+
+  Resource *font = new Resource();
+  if (!font->open(path))
+  {
+    delete font;
+    std::cout << "ERROR::FONT_LOADER::FONT_NOT_FOUND: " << path << std::endl;
+    return NULL;
+  }
+
+  fonts[path] = font;
+  report.fonts++;
+  if (font->isEmbedded())
+  {
+    report.embeddedBytes += font->size();
+  }
+  else
+  {
+    report.mappedBytes += font->size();
+  }
+  return font;
+}
+
+// load() 한 폰트 바이트로 FT_Face 생성
+FT_Face FontLoader::openFace(FT_Library library, const char *path, FT_Long faceIndex)
+{
+  const Resource *font = load(path);
+  if (!font)
+  {
+    return NULL;
+  }
+
+  // FT_New_Memory_Face() 는 폰트 바이트를 복사하지 않고 매핑된 메모리를 그대로 참조함
+  FT_Face face = NULL;
+  if (FT_New_Memory_Face(library, font->data(), static_cast<FT_Long>(font->size()), faceIndex, &face) != 0)
+  {
+    std::cout << "ERROR::FONT_LOADER::INVALID_FONT: " << path << std::endl;
+    return NULL;
+  }
+  return face;
+}
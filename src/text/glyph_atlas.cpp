@@ -0,0 +1,112 @@
+#include "text/glyph_atlas.hpp"
+
+// GlyphAtlas 클래스 생성자
+GlyphAtlas::GlyphAtlas(int width, int height, int padding, int channels)
+    : packer(width - padding, height - padding), padding(padding), channels(channels)
+{
+  /**
+   * packer 가 관리하는 영역을 padding 만큼 줄여두고,
+   * 각 glyph 영역도 padding 만큼 키워서 배치한 뒤 그 안쪽 (padding, padding) 위치에 glyph 를 복사하면
+   * 아틀라스 가장자리를 포함한 모든 glyph 주변에 padding 크기의 빈 텍셀이 확보됨.
+   */
+
+  // padding 영역이 항상 0(투명)으로 채워져 있도록 0 으로 초기화된 텍스쳐 메모리를 할당
+  std::vector<unsigned char> zeros(static_cast<size_t>(width) * height * channels, 0);
+
+  glGenTextures(1, &TextureID);
+  glBindTexture(GL_TEXTURE_2D, TextureID);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, channels == 3 ? GL_RGB8 : GL_R8, width, height, 0, getFormat(), GL_UNSIGNED_BYTE, &zeros[0]);
+
+  // 텍스쳐 파라미터 설정
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// GlyphAtlas 클래스 소멸자
+GlyphAtlas::~GlyphAtlas()
+{
+  // 아틀라스 텍스쳐 객체 메모리 반납
+  glDeleteTextures(1, &TextureID);
+}
+
+// 배치된 모든 glyph 를 지우고 아틀라스를 빈 상태로 되돌림
+void GlyphAtlas::clear()
+{
+  packer.reset();
+
+  // 새로 배치될 glyph 들의 padding 영역에 이전 glyph 텍셀이 남아있으면 bleeding 이 생기므로 텍스쳐 전체를 0 으로 덮어씀.
+  std::vector<unsigned char> zeros(static_cast<size_t>(getWidth()) * getHeight() * channels, 0);
+  glBindTexture(GL_TEXTURE_2D, TextureID);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, getWidth(), getHeight(), getFormat(), GL_UNSIGNED_BYTE, &zeros[0]);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// 아틀라스 텍스쳐 전체 픽셀을 CPU 메모리로 읽어옴
+void GlyphAtlas::readPixels(std::vector<unsigned char> &pixels) const
+{
+  pixels.resize(static_cast<size_t>(getWidth()) * getHeight() * channels);
+
+  glBindTexture(GL_TEXTURE_2D, TextureID);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(GL_TEXTURE_2D, 0, getFormat(), GL_UNSIGNED_BYTE, &pixels[0]);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// 디스크 캐시 등에서 읽어온 아틀라스 전체 픽셀과 packer 상태로 아틀라스를 복원
+void GlyphAtlas::restore(const unsigned char *pixels, const std::vector<SkylinePacker::Node> &skyline, long long usedArea)
+{
+  packer.restore(skyline, usedArea);
+
+  // 메모리 매핑된 캐시 파일의 픽셀을 중간 복사 없이 바로 텍스쳐에 업로드
+  glBindTexture(GL_TEXTURE_2D, TextureID);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, getWidth(), getHeight(), getFormat(), GL_UNSIGNED_BYTE, pixels);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// glyph bitmap 을 아틀라스에 배치하고 텍스쳐에 업로드한 뒤, uv 영역을 uvRect 에 기록
+bool GlyphAtlas::addGlyph(int width, int height, int pitch, const unsigned char *pixels, glm::vec4 &uvRect)
+{
+  // 공백 문자처럼 bitmap 이 비어있는 glyph 는 아틀라스 공간을 차지할 필요가 없음.
+  if (width <= 0 || height <= 0)
+  {
+    uvRect = glm::vec4(0.0f);
+    return true;
+  }
+
+  int x, y;
+  if (!packer.pack(width + padding, height + padding, x, y))
+  {
+    return false;
+  }
+  x += padding;
+  y += padding;
+
+  // bitmap 의 pitch 가 width 와 다를 수 있으므로 GL_UNPACK_ROW_LENGTH 로 한 줄의 실제 길이(픽셀 단위)를 알려줌.
+  glBindTexture(GL_TEXTURE_2D, TextureID);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch / channels);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, getFormat(), GL_UNSIGNED_BYTE, pixels);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  /**
+   * FreeType bitmap 은 첫 번째 줄이 glyph 의 최상단이므로,
+   * 텍스쳐에 그대로 복사하면 v0 가 glyph 상단, v1 이 glyph 하단에 대응됨.
+   */
+  float atlasWidth = static_cast<float>(getWidth());
+  float atlasHeight = static_cast<float>(getHeight());
+  uvRect = glm::vec4(
+      x / atlasWidth,
+      y / atlasHeight,
+      (x + width) / atlasWidth,
+      (y + height) / atlasHeight);
+
+  return true;
+}
@@ -0,0 +1,674 @@
+#include "text/glyph_cache.hpp"
+
+#include "text/utf8.hpp"
+#include "utils/mapped_file.hpp"
+
+#include <algorithm> // std::sort, std::adjacent_find
+#include <cstring>   // std::memcpy
+#include <fstream>   // 파일 입출력을 위한 헤더
+#include <iostream>  // 콘솔 입출력을 위한 헤더
+#include <thread>    // std::this_thread::yield
+
+namespace
+{
+  /**
+   * 디스크 캐시 파일 형식
+   *
+   * [FileHeader]
+   * [PageHeader][SkylinePacker::Node x skylineCount][pageSize x pageSize x 채널 개수 byte 픽셀] x pageCount
+   * [GlyphRecord] x glyphCount
+   *
+   * 같은 머신에서 다시 읽어들이는 용도이므로 byte order 는 현재 머신의 native order 를 그대로 사용함.
+   * 파일 형식이 바뀌면 CACHE_VERSION 을 올려서 예전 캐시 파일이 무시되도록 해야 함.
+   */
+  const char CACHE_MAGIC[4] = {'G', 'L', 'Y', 'C'};
+  const unsigned int CACHE_VERSION = 1;
+
+  struct FileHeader
+  {
+    char magic[4];
+    unsigned int version;
+    unsigned long long fontHash;
+    unsigned int pixelSize;
+    unsigned int renderMode;
+    unsigned int pageSize;
+    unsigned int padding;
+    unsigned int pageCount;
+    unsigned int glyphCount;
+  };
+
+  struct PageHeader
+  {
+    unsigned int skylineCount;
+    unsigned int reserved;
+    long long usedArea;
+  };
+
+  struct GlyphRecord
+  {
+    unsigned int codepoint;
+    unsigned int page;
+    float uv[4];
+    int size[2];
+    int bearing[2];
+    unsigned int advance;
+  };
+
+  // 매핑된 파일에서 POD 구조체 하나를 읽고 cursor 를 이동 (정렬되지 않은 위치일 수 있으므로 memcpy 로 복사)
+  template <typename T>
+  bool readRecord(const unsigned char *&cursor, const unsigned char *end, T &out)
+  {
+    if (static_cast<size_t>(end - cursor) < sizeof(T))
+    {
+      return false;
+    }
+    std::memcpy(&out, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+  }
+
+  // 레코드 count 개를 읽을 만큼 파일이 남아있는지 확인 (손상된 개수 필드로 거대한 배열을 할당하지 않도록 할당 전에 검사)
+  template <typename T>
+  bool hasRecords(const unsigned char *cursor, const unsigned char *end, unsigned int count)
+  {
+    return count <= static_cast<size_t>(end - cursor) / sizeof(T);
+  }
+
+  // skyline 노드가 packer 영역 안에 있는지 확인
+  bool isValidNode(const SkylinePacker::Node &node, int packerSize)
+  {
+    return node.x >= 0 && node.y >= 0 && node.width > 0 &&
+           node.x <= packerSize - node.width && node.y <= packerSize;
+  }
+
+  /**
+   * skyline 이 SkylinePacker 가 만드는 형태인지 확인
+   *
+   * SkylinePacker 는 skyline 선분들이 x = 0 부터 빈틈이나 겹침 없이 이어져서 packer 너비 전체를 덮고 있다고 가정하므로,
+   * 노드 하나하나가 범위 안에 있더라도 선분 사이가 끊기거나 너비 합이 packer 너비와 다르면 거부함.
+   * (GlyphAtlas 는 packer 영역을 padding 만큼 줄여두므로 packer 너비는 pageSize - padding 임)
+   */
+  bool isValidSkyline(const std::vector<SkylinePacker::Node> &skyline, int packerSize)
+  {
+    int x = 0;
+    for (size_t i = 0; i < skyline.size(); i++)
+    {
+      if (!isValidNode(skyline[i], packerSize) || skyline[i].x != x)
+      {
+        return false;
+      }
+      x += skyline[i].width;
+    }
+    return x == packerSize;
+  }
+
+  // glyph 레코드의 크기와 uv 영역이 페이지 안에 있는지 확인 (NaN 도 걸러지도록 비교를 부정하지 않고 작성)
+  bool isValidGlyph(const GlyphRecord &record, int pageSize)
+  {
+    if (!(record.size[0] >= 0 && record.size[0] <= pageSize &&
+          record.size[1] >= 0 && record.size[1] <= pageSize))
+    {
+      return false;
+    }
+    return record.uv[0] >= 0.0f && record.uv[0] <= record.uv[2] && record.uv[2] <= 1.0f &&
+           record.uv[1] >= 0.0f && record.uv[1] <= record.uv[3] && record.uv[3] <= 1.0f;
+  }
+}
+
+// GlyphCache 클래스 생성자
+GlyphCache::GlyphCache(FT_Face face, int pageSize, size_t memoryBudget, int padding, GlyphRenderMode renderMode)
+    : face(face), renderMode(renderMode), pageSize(pageSize), channels(glyphChannelCount(renderMode)), padding(padding),
+      dirty(false), frame(0), rasterizer(NULL)
+{
+  // 아틀라스 페이지 하나는 pageSize x pageSize 크기의 채널당 8-bit 텍스쳐이므로, 메모리 예산을 페이지 개수로 환산 (최소 1장)
+  size_t pageBytes = static_cast<size_t>(pageSize) * pageSize * channels;
+  maxPages = memoryBudget / pageBytes;
+  if (maxPages < 1)
+  {
+    maxPages = 1;
+  }
+
+  stats.hits = 0;
+  stats.misses = 0;
+  stats.evictions = 0;
+  stats.pages = 0;
+  stats.residentBytes = 0;
+}
+
+// GlyphCache 클래스 소멸자
+GlyphCache::~GlyphCache()
+{
+  for (size_t i = 0; i < pages.size(); i++)
+  {
+    delete pages[i].atlas;
+  }
+}
+
+// 새 프레임 시작
+void GlyphCache::beginFrame()
+{
+  frame++;
+
+  // 이전 프레임 동안 worker 들이 완료한 glyph 들을 미리 업로드
+  if (rasterizer)
+  {
+    receive(false);
+  }
+}
+
+// codepoint 에 대응되는 glyph 를 반환하며, 캐시에 없으면 rasterize 해서 아틀라스에 추가함.
+unsigned int GlyphCache::get(unsigned int codepoint)
+{
+  unsigned int index = find(codepoint);
+  if (index != GlyphMetrics::NO_GLYPH)
+  {
+    return index;
+  }
+
+  if (!rasterizer)
+  {
+    return load(codepoint);
+  }
+
+  // prefetch() 로 이미 요청된 glyph 라면 worker 가 처리 중이므로, 도착한 결과들을 업로드하면서 기다림
+  if (pending.find(codepoint) == pending.end())
+  {
+    request(std::vector<unsigned int>(1, codepoint));
+  }
+  while (pending.find(codepoint) != pending.end())
+  {
+    receive(false);
+    std::this_thread::yield();
+  }
+
+  // 기다리는 동안 업로드된 다른 glyph 들 때문에 페이지가 제거되었을 수 있으므로 다시 조회
+  return table.find(codepoint);
+}
+
+// 캐시에 이미 있는 glyph 만 반환
+unsigned int GlyphCache::find(unsigned int codepoint)
+{
+  unsigned int index = table.find(codepoint);
+  if (index == GlyphMetrics::NO_GLYPH)
+  {
+    return index;
+  }
+
+  stats.hits++;
+  unsigned int page = metrics.getPage(index);
+  if (page != NO_PAGE)
+  {
+    pages[page].lastUsedFrame = frame;
+  }
+  return index;
+}
+
+// [first, last] 범위의 codepoint 들을 미리 rasterize
+void GlyphCache::preload(unsigned int first, unsigned int last)
+{
+  std::vector<unsigned int> codepoints;
+  for (unsigned int codepoint = first; codepoint <= last; codepoint++)
+  {
+    codepoints.push_back(codepoint);
+  }
+  if (!codepoints.empty())
+  {
+    preload(&codepoints[0], codepoints.size());
+  }
+}
+
+// 캐시 키 배열의 glyph 들을 미리 rasterize
+void GlyphCache::preload(const unsigned int *keys, size_t count)
+{
+  if (rasterizer)
+  {
+    // 전체를 한꺼번에 요청하고 worker 들이 모두 처리할 때까지 대기
+    std::vector<unsigned int> missing;
+    for (size_t i = 0; i < count; i++)
+    {
+      if (table.find(keys[i]) == GlyphMetrics::NO_GLYPH)
+      {
+        missing.push_back(keys[i]);
+      }
+    }
+    request(missing);
+    receive(true);
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (table.find(keys[i]) == GlyphMetrics::NO_GLYPH)
+    {
+      load(keys[i]);
+    }
+  }
+}
+
+// [first, last] 범위의 codepoint 쌍들의 kerning 을 한 번에 추출
+size_t GlyphCache::loadKerning(unsigned int first, unsigned int last)
+{
+  // SDF / MSDF glyph 는 hinting 없이 rasterize 한 외곽선을 확대/축소해서 사용하므로 pixel 격자에 맞추지 않은 kerning 사용
+  return kerning.build(face, first, last, renderMode != GLYPH_RENDER_BITMAP);
+}
+
+// UTF-8 문자열 [begin, end) 에서 캐시에 없는 문자들을 rasterizer 에 미리 요청
+void GlyphCache::prefetch(const char *begin, const char *end)
+{
+  if (!rasterizer)
+  {
+    return;
+  }
+
+  std::vector<unsigned int> missing;
+  const char *c = begin;
+  while (c != end)
+  {
+    unsigned int codepoint = decodeUtf8(c, end);
+    if (table.find(codepoint) == GlyphMetrics::NO_GLYPH)
+    {
+      missing.push_back(codepoint);
+    }
+  }
+  request(missing);
+}
+
+// 캐시 키 배열에서 캐시에 없는 glyph 들을 rasterizer 에 미리 요청
+void GlyphCache::prefetch(const unsigned int *keys, size_t count)
+{
+  if (!rasterizer)
+  {
+    return;
+  }
+
+  std::vector<unsigned int> missing;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (table.find(keys[i]) == GlyphMetrics::NO_GLYPH)
+    {
+      missing.push_back(keys[i]);
+    }
+  }
+  request(missing);
+}
+
+// codepoint 를 rasterize 해서 아틀라스에 추가
+unsigned int GlyphCache::load(unsigned int codepoint)
+{
+  if (!rasterizeGlyph(face, codepoint, renderMode, scratch))
+  {
+    // codepoint 에 해당하는 glyph 로드 실패
+    std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
+    return GlyphMetrics::NO_GLYPH;
+  }
+
+  return insert(scratch);
+}
+
+// rasterize 된 glyph bitmap 과 metrices 를 아틀라스와 조회 테이블에 추가
+unsigned int GlyphCache::insert(const RasterizedGlyph &glyph)
+{
+  glm::vec4 uv(0.0f);
+  unsigned int page = NO_PAGE;
+  if (glyph.width > 0 && glyph.rows > 0)
+  {
+    if (!place(glyph.width, glyph.rows, glyph.width * channels, &glyph.pixels[0], uv, page))
+    {
+      // 메모리 예산 안에서 공간을 확보하지 못함
+      std::cout << "ERROR::GLYPH_CACHE: Memory budget exhausted" << std::endl;
+      return GlyphMetrics::NO_GLYPH;
+    }
+    pages[page].codepoints.push_back(glyph.codepoint);
+  }
+  else
+  {
+    unpaged.push_back(glyph.codepoint);
+  }
+
+  // 로드된 glyph metrices 를 커스텀 자료형으로 파싱
+  Character character = {
+      uv,
+      page,
+      glm::ivec2(glyph.width, glyph.rows),
+      glm::ivec2(glyph.left, glyph.top),
+      glyph.advance};
+  addGlyph(glyph.codepoint, character);
+  stats.misses++;
+  dirty = true;
+
+  return table.find(glyph.codepoint);
+}
+
+// codepoint 와 metrices 를 조회 테이블과 metrices 저장소에 추가
+void GlyphCache::addGlyph(unsigned int codepoint, const Character &character)
+{
+  // 이미 있는 codepoint 라면 이전 glyph 번호를 돌려놓고 새 번호로 교체
+  unsigned int previous = table.find(codepoint);
+  if (previous != GlyphMetrics::NO_GLYPH)
+  {
+    metrics.remove(previous);
+  }
+  table.insert(codepoint, metrics.add(character));
+}
+
+// 아직 요청되지 않은 codepoint 들을 rasterizer 에 요청
+void GlyphCache::request(const std::vector<unsigned int> &codepoints)
+{
+  std::vector<unsigned int> jobs;
+  jobs.reserve(codepoints.size());
+  for (size_t i = 0; i < codepoints.size(); i++)
+  {
+    // 같은 문자열 안에서 반복되는 문자나 이미 요청된 문자는 한 번만 요청
+    if (pending.insert(codepoints[i]).second)
+    {
+      jobs.push_back(codepoints[i]);
+    }
+  }
+
+  if (!jobs.empty())
+  {
+    rasterizer->request(&jobs[0], jobs.size());
+  }
+}
+
+// rasterizer 가 완료한 glyph 들을 꺼내서 아틀라스에 업로드
+void GlyphCache::receive(bool wait)
+{
+  while (!pending.empty())
+  {
+    RasterizedGlyph *glyph = rasterizer->poll();
+    if (!glyph)
+    {
+      if (!wait)
+      {
+        break;
+      }
+      std::this_thread::yield();
+      continue;
+    }
+
+    pending.erase(glyph->codepoint);
+    if (glyph->failed)
+    {
+      // codepoint 에 해당하는 glyph 로드 실패
+      std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
+    }
+    else if (table.find(glyph->codepoint) == GlyphMetrics::NO_GLYPH)
+    {
+      insert(*glyph);
+    }
+    delete glyph;
+  }
+}
+
+// glyph bitmap 을 저장할 페이지를 찾아서 배치
+bool GlyphCache::place(int width, int height, int pitch, const unsigned char *pixels, glm::vec4 &uv, unsigned int &page)
+{
+  // 1. 기존 페이지들 중 빈 공간이 남아있는 페이지에 배치 (최근에 생성된 페이지일수록 빈 공간이 많으므로 뒤에서부터 확인)
+  for (size_t i = pages.size(); i-- > 0;)
+  {
+    if (pages[i].atlas->addGlyph(width, height, pitch, pixels, uv))
+    {
+      page = static_cast<unsigned int>(i);
+      pages[i].lastUsedFrame = frame;
+      return true;
+    }
+  }
+
+  // 2. 메모리 예산이 남아있다면 새 페이지 생성
+  if (pages.size() < maxPages)
+  {
+    Page newPage;
+    newPage.atlas = new GlyphAtlas(pageSize, pageSize, padding, channels);
+    newPage.lastUsedFrame = frame;
+    pages.push_back(newPage);
+
+    stats.pages = static_cast<unsigned int>(pages.size());
+    stats.residentBytes = pages.size() * static_cast<size_t>(pageSize) * pageSize * channels;
+
+    page = static_cast<unsigned int>(pages.size() - 1);
+    return pages.back().atlas->addGlyph(width, height, pitch, pixels, uv);
+  }
+
+  // 3. 현재 프레임에서 사용되지 않은 페이지들 중 가장 오래전에 사용된 페이지를 비워서 재사용
+  size_t victim = pages.size();
+  for (size_t i = 0; i < pages.size(); i++)
+  {
+    if (pages[i].lastUsedFrame == frame)
+    {
+      continue;
+    }
+    if (victim == pages.size() || pages[i].lastUsedFrame < pages[victim].lastUsedFrame)
+    {
+      victim = i;
+    }
+  }
+
+  if (victim == pages.size())
+  {
+    return false;
+  }
+
+  evict(static_cast<unsigned int>(victim));
+  page = static_cast<unsigned int>(victim);
+  pages[victim].lastUsedFrame = frame;
+  return pages[victim].atlas->addGlyph(width, height, pitch, pixels, uv);
+}
+
+// 주어진 페이지의 glyph 들을 캐시에서 제거하고 페이지를 비움
+void GlyphCache::evict(unsigned int page)
+{
+  Page &victim = pages[page];
+  for (size_t i = 0; i < victim.codepoints.size(); i++)
+  {
+    unsigned int index = table.find(victim.codepoints[i]);
+    if (index != GlyphMetrics::NO_GLYPH)
+    {
+      metrics.remove(index);
+      table.erase(victim.codepoints[i]);
+    }
+  }
+  victim.codepoints.clear();
+  victim.atlas->clear();
+
+  stats.evictions++;
+  dirty = true;
+}
+
+// 디스크 캐시 파일을 메모리 매핑해서 아틀라스 페이지와 glyph 들을 복원
+bool GlyphCache::loadFromDisk(const char *path, const GlyphCacheKey &key)
+{
+  if (!pages.empty() || table.size() > 0)
+  {
+    return false;
+  }
+
+  MappedFile file;
+  if (!file.open(path))
+  {
+    return false;
+  }
+
+  const unsigned char *cursor = file.data();
+  const unsigned char *end = cursor + file.size();
+
+  /** 헤더 검증 : 파일 형식 버전, 캐시 키, 페이지 설정이 모두 일치해야 함 */
+  FileHeader header;
+  if (!readRecord(cursor, end, header) ||
+      std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+      header.version != CACHE_VERSION ||
+      header.fontHash != key.fontHash ||
+      header.pixelSize != key.pixelSize ||
+      header.renderMode != key.renderMode ||
+      header.pageSize != static_cast<unsigned int>(pageSize) ||
+      header.padding != static_cast<unsigned int>(padding) ||
+      header.pageCount > maxPages)
+  {
+    return false;
+  }
+
+  /** 아틀라스 페이지 검증 : 실제 GL 텍스쳐를 만들기 전에 파일 전체가 온전한지 먼저 확인 */
+  size_t pageBytes = static_cast<size_t>(pageSize) * pageSize * channels;
+  std::vector<const unsigned char *> pagePixels(header.pageCount);
+  std::vector<std::vector<SkylinePacker::Node> > skylines(header.pageCount);
+  std::vector<long long> usedAreas(header.pageCount);
+  for (unsigned int i = 0; i < header.pageCount; i++)
+  {
+    PageHeader pageHeader;
+    if (!readRecord(cursor, end, pageHeader))
+    {
+      return false;
+    }
+
+    if (!hasRecords<SkylinePacker::Node>(cursor, end, pageHeader.skylineCount))
+    {
+      return false;
+    }
+    skylines[i].resize(pageHeader.skylineCount);
+    for (unsigned int n = 0; n < pageHeader.skylineCount; n++)
+    {
+      if (!readRecord(cursor, end, skylines[i][n]))
+      {
+        return false;
+      }
+    }
+    if (!isValidSkyline(skylines[i], pageSize - padding))
+    {
+      return false;
+    }
+    usedAreas[i] = pageHeader.usedArea;
+
+    if (static_cast<size_t>(end - cursor) < pageBytes)
+    {
+      return false;
+    }
+    pagePixels[i] = cursor;
+    cursor += pageBytes;
+  }
+
+  if (!hasRecords<GlyphRecord>(cursor, end, header.glyphCount))
+  {
+    return false;
+  }
+  std::vector<GlyphRecord> records(header.glyphCount);
+  std::vector<unsigned int> codepoints(header.glyphCount);
+  for (unsigned int i = 0; i < header.glyphCount; i++)
+  {
+    if (!readRecord(cursor, end, records[i]) || !isValidGlyph(records[i], pageSize) ||
+        (records[i].page != NO_PAGE && records[i].page >= header.pageCount))
+    {
+      return false;
+    }
+    codepoints[i] = records[i].codepoint;
+  }
+
+  // 같은 codepoint 가 두 번 저장되어 있으면 페이지의 codepoint 목록에도 두 번 들어가서, 페이지 제거 시 같은 glyph 를 두 번 제거하게 됨.
+  std::sort(codepoints.begin(), codepoints.end());
+  if (std::adjacent_find(codepoints.begin(), codepoints.end()) != codepoints.end())
+  {
+    return false;
+  }
+
+  /** 검증이 끝났으므로 매핑된 픽셀을 그대로 텍스쳐에 업로드하여 페이지 복원 */
+  for (unsigned int i = 0; i < header.pageCount; i++)
+  {
+    Page page;
+    page.atlas = new GlyphAtlas(pageSize, pageSize, padding, channels);
+    page.atlas->restore(pagePixels[i], skylines[i], usedAreas[i]);
+    page.lastUsedFrame = frame;
+    pages.push_back(page);
+  }
+
+  for (unsigned int i = 0; i < header.glyphCount; i++)
+  {
+    const GlyphRecord &record = records[i];
+    Character character = {
+        glm::vec4(record.uv[0], record.uv[1], record.uv[2], record.uv[3]),
+        record.page,
+        glm::ivec2(record.size[0], record.size[1]),
+        glm::ivec2(record.bearing[0], record.bearing[1]),
+        record.advance};
+    addGlyph(record.codepoint, character);
+
+    if (record.page != NO_PAGE)
+    {
+      pages[record.page].codepoints.push_back(record.codepoint);
+    }
+    else
+    {
+      unpaged.push_back(record.codepoint);
+    }
+  }
+
+  stats.pages = static_cast<unsigned int>(pages.size());
+  stats.residentBytes = pages.size() * pageBytes;
+  dirty = false;
+
+  return true;
+}
+
+// 현재 아틀라스 페이지와 glyph 들을 디스크 캐시 파일로 저장
+bool GlyphCache::saveToDisk(const char *path, const GlyphCacheKey &key) const
+{
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "ERROR::GLYPH_CACHE: Failed to write cache file" << std::endl;
+    return false;
+  }
+
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  header.version = CACHE_VERSION;
+  header.fontHash = key.fontHash;
+  header.pixelSize = key.pixelSize;
+  header.renderMode = key.renderMode;
+  header.pageSize = static_cast<unsigned int>(pageSize);
+  header.padding = static_cast<unsigned int>(padding);
+  header.pageCount = static_cast<unsigned int>(pages.size());
+  header.glyphCount = static_cast<unsigned int>(unpaged.size());
+  for (size_t i = 0; i < pages.size(); i++)
+  {
+    header.glyphCount += static_cast<unsigned int>(pages[i].codepoints.size());
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  /** 아틀라스 페이지 : packer 의 skyline 상태와 텍스쳐 픽셀 */
+  std::vector<unsigned char> pixels;
+  for (size_t i = 0; i < pages.size(); i++)
+  {
+    const SkylinePacker &packer = pages[i].atlas->getPacker();
+    const std::vector<SkylinePacker::Node> &skyline = packer.getSkyline();
+
+    PageHeader pageHeader;
+    pageHeader.skylineCount = static_cast<unsigned int>(skyline.size());
+    pageHeader.reserved = 0;
+    pageHeader.usedArea = packer.getUsedArea();
+    out.write(reinterpret_cast<const char *>(&pageHeader), sizeof(pageHeader));
+    out.write(reinterpret_cast<const char *>(&skyline[0]), skyline.size() * sizeof(SkylinePacker::Node));
+
+    pages[i].atlas->readPixels(pixels);
+    out.write(reinterpret_cast<const char *>(&pixels[0]), pixels.size());
+  }
+
+  /** glyph metrices : 페이지에 저장된 glyph 와 공백처럼 페이지 없이 metrices 만 있는 glyph 모두 저장 */
+  for (size_t i = 0; i <= pages.size(); i++)
+  {
+    const std::vector<unsigned int> &codepoints = i < pages.size() ? pages[i].codepoints : unpaged;
+    for (size_t n = 0; n < codepoints.size(); n++)
+    {
+      Character character = metrics.get(table.find(codepoints[n]));
+      GlyphRecord record = {
+          codepoints[n],
+          character.Page,
+          {character.UV.x, character.UV.y, character.UV.z, character.UV.w},
+          {character.Size.x, character.Size.y},
+          {character.Bearing.x, character.Bearing.y},
+          character.Advance};
+      out.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+  }
+
+  return static_cast<bool>(out);
+}
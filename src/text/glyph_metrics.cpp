@@ -0,0 +1,66 @@
+#include "text/glyph_metrics.hpp"
+
+// glyph 를 추가하고 glyph 번호 반환
+unsigned int GlyphMetrics::add(const Character &character)
+{
+  GlyphBox box = {
+      static_cast<short>(character.Size.x),
+      static_cast<short>(character.Size.y),
+      static_cast<short>(character.Bearing.x),
+      static_cast<short>(character.Bearing.y)};
+
+  // 제거된 glyph 번호가 있으면 재사용하고, 없으면 배열 끝에 추가
+  if (!freeList.empty())
+  {
+    unsigned int index = freeList.back();
+    freeList.pop_back();
+    boxes[index] = box;
+    advances[index] = static_cast<int>(character.Advance);
+    uvs[index] = character.UV;
+    pages[index] = character.Page;
+    return index;
+  }
+
+  boxes.push_back(box);
+  advances.push_back(static_cast<int>(character.Advance));
+  uvs.push_back(character.UV);
+  pages.push_back(character.Page);
+  return static_cast<unsigned int>(pages.size() - 1);
+}
+
+// glyph 번호를 비워서 다음 add() 에서 재사용
+void GlyphMetrics::remove(unsigned int index)
+{
+  freeList.push_back(index);
+}
+
+// 저장된 모든 glyph 제거
+void GlyphMetrics::clear()
+{
+  boxes.clear();
+  advances.clear();
+  uvs.clear();
+  pages.clear();
+  freeList.clear();
+}
+
+// glyph 번호의 metrices 를 Character 로 조립
+Character GlyphMetrics::get(unsigned int index) const
+{
+  const GlyphBox &box = boxes[index];
+  Character character = {
+      uvs[index],
+      pages[index],
+      glm::ivec2(box.sizeX, box.sizeY),
+      glm::ivec2(box.bearingX, box.bearingY),
+      static_cast<unsigned int>(advances[index])};
+  return character;
+}
+
+// 배열들이 차지하는 메모리
+size_t GlyphMetrics::getMemoryBytes() const
+{
+  return boxes.capacity() * sizeof(GlyphBox) + advances.capacity() * sizeof(int) +
+         uvs.capacity() * sizeof(glm::vec4) + pages.capacity() * sizeof(unsigned int) +
+         freeList.capacity() * sizeof(unsigned int);
+}
@@ -0,0 +1,248 @@
+#include "text/glyph_rasterizer.hpp"
+#include "text/msdf_generator.hpp"
+#include "text/sdf_generator.hpp"
+
+#include <cstring>  // std::memcpy
+#include <iostream> // 콘솔 입출력을 위한 헤더
+
+namespace
+{
+  // 결과 큐 크기 -> GL 스레드가 꺼내가기 전까지 worker 들이 쌓아둘 수 있는 glyph 개수 (2의 거듭제곱)
+  const size_t RESULT_QUEUE_CAPACITY = 1024;
+
+  // SDF / MSDF 모드에서 glyph 외곽선 바깥/안쪽으로 거리를 기록할 범위 (pixel 단위) -> 값을 바꾸면 디스크 캐시 CACHE_VERSION 도 올려야 함
+  const int SDF_SPREAD = 6;
+}
+
+// face 로 codepoint 의 glyph 를 renderMode 형태로 rasterize 해서 out 에 저장
+bool rasterizeGlyph(FT_Face face, unsigned int codepoint, GlyphRenderMode renderMode, RasterizedGlyph &out)
+{
+  out.codepoint = codepoint;
+  out.width = 0;
+  out.rows = 0;
+  out.left = 0;
+  out.top = 0;
+  out.advance = 0;
+  out.pixels.clear();
+
+  // shaping 결과처럼 glyph index 로 요청된 키는 그대로, 나머지는 cmap 으로 codepoint 에 대응되는 glyph index 를 찾음
+  // (cmap 에 없는 codepoint 는 FT_Load_Char() 와 마찬가지로 .notdef glyph(index 0)가 됨)
+  FT_UInt glyphIndex = (codepoint & GLYPH_INDEX_FLAG) ? (codepoint & ~GLYPH_INDEX_FLAG) : FT_Get_Char_Index(face, codepoint);
+
+  if (renderMode == GLYPH_RENDER_MSDF)
+  {
+    /**
+     * MSDF 는 bitmap 이 아닌 외곽선으로부터 생성하므로 rasterize 하지 않고 외곽선만 로드함.
+     * (hinting 은 특정 pixel size 의 격자에 외곽선을 맞추는 작업이므로, 여러 크기로 확대/축소해서 사용할 외곽선에는 적용하지 않음)
+     */
+    out.failed = FT_Load_Glyph(face, glyphIndex, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING) != 0 ||
+                 face->glyph->format != FT_GLYPH_FORMAT_OUTLINE;
+    if (out.failed)
+    {
+      return false;
+    }
+
+    FT_GlyphSlot slot = face->glyph;
+    out.advance = static_cast<unsigned int>(slot->advance.x);
+    if (!generateMsdf(&slot->outline, SDF_SPREAD, out.pixels, out.width, out.rows, out.left, out.top))
+    {
+      // 공백 문자처럼 외곽선이 없는 glyph 는 metrices 만 사용함
+      out.width = 0;
+      out.rows = 0;
+      out.left = 0;
+      out.top = 0;
+      out.pixels.clear();
+    }
+    return true;
+  }
+
+  out.failed = FT_Load_Glyph(face, glyphIndex, FT_LOAD_RENDER) != 0;
+  if (out.failed)
+  {
+    return false;
+  }
+
+  FT_GlyphSlot slot = face->glyph;
+  int width = static_cast<int>(slot->bitmap.width);
+  int rows = static_cast<int>(slot->bitmap.rows);
+  out.left = slot->bitmap_left;
+  out.top = slot->bitmap_top;
+  out.advance = static_cast<unsigned int>(slot->advance.x);
+
+  if (width == 0 || rows == 0)
+  {
+    // 공백 문자처럼 bitmap 이 없는 glyph 는 metrices 만 사용함
+    return true;
+  }
+
+  if (renderMode == GLYPH_RENDER_SDF)
+  {
+    // 사방으로 SDF_SPREAD 만큼 여백이 추가되므로, 2D Quad 가 여백까지 덮도록 bearing 도 함께 이동시킴
+    generateSdf(slot->bitmap.buffer, width, rows, slot->bitmap.pitch, SDF_SPREAD, out.pixels);
+    out.width = width + 2 * SDF_SPREAD;
+    out.rows = rows + 2 * SDF_SPREAD;
+    out.left -= SDF_SPREAD;
+    out.top += SDF_SPREAD;
+    return true;
+  }
+
+  // FT_GlyphSlot 의 bitmap 은 다음 FT_Load_Glyph() 호출 시 덮어써지므로, pitch 를 제거하면서 결과 버퍼로 복사
+  out.width = width;
+  out.rows = rows;
+  out.pixels.resize(static_cast<size_t>(width) * rows);
+  for (int row = 0; row < rows; row++)
+  {
+    std::memcpy(&out.pixels[static_cast<size_t>(row) * width], slot->bitmap.buffer + row * slot->bitmap.pitch, width);
+  }
+  return true;
+}
+
+// GlyphRasterizer 클래스 생성자
+GlyphRasterizer::GlyphRasterizer(const unsigned char *fontData, size_t fontSize, unsigned int pixelSize,
+                                 GlyphRenderMode renderMode, unsigned int threadCount)
+    : fontData(fontData), fontSize(fontSize), pixelSize(pixelSize), renderMode(renderMode), stopping(false), results(RESULT_QUEUE_CAPACITY)
+{
+  if (threadCount == 0)
+  {
+    // hardware_concurrency() 는 알 수 없을 때 0 을 반환하므로 최소 1개는 생성
+    threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+    {
+      threadCount = 1;
+    }
+  }
+
+  for (unsigned int i = 0; i < threadCount; i++)
+  {
+    workers.push_back(std::thread(&GlyphRasterizer::workerMain, this));
+  }
+}
+
+// GlyphRasterizer 클래스 소멸자
+GlyphRasterizer::~GlyphRasterizer()
+{
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    stopping = true;
+    jobs.clear();
+  }
+  jobReady.notify_all();
+
+  for (size_t i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+
+  // GL 스레드가 꺼내가지 않은 결과 정리
+  RasterizedGlyph *glyph;
+  while (results.pop(glyph))
+  {
+    delete glyph;
+  }
+}
+
+// codepoint 의 rasterize 작업 요청
+void GlyphRasterizer::request(unsigned int codepoint)
+{
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    jobs.push_back(codepoint);
+  }
+  jobReady.notify_one();
+}
+
+// 여러 codepoint 의 rasterize 작업을 한꺼번에 요청
+void GlyphRasterizer::request(const unsigned int *codepoints, size_t count)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    jobs.insert(jobs.end(), codepoints, codepoints + count);
+  }
+  jobReady.notify_all();
+}
+
+// rasterize 가 끝난 glyph 하나를 꺼냄
+RasterizedGlyph *GlyphRasterizer::poll()
+{
+  RasterizedGlyph *glyph;
+  return results.pop(glyph) ? glyph : NULL;
+}
+
+// worker 스레드 본체
+void GlyphRasterizer::workerMain()
+{
+  /**
+   * FT_Library / FT_Face 는 스레드 간에 공유할 수 없으므로 worker 마다 따로 생성
+   * (FreeType 문서 : 하나의 FT_Face 를 여러 스레드에서 동시에 사용하면 안됨)
+   *
+   * 폰트 바이트는 FreeType 이 읽기만 하므로 모든 worker 가 같은 메모리를 공유해도 됨.
+   */
+  FT_Library ft;
+  FT_Face face;
+  bool ready = FT_Init_FreeType(&ft) == 0;
+  if (ready && FT_New_Memory_Face(ft, fontData, static_cast<FT_Long>(fontSize), 0, &face) != 0)
+  {
+    FT_Done_FreeType(ft);
+    ready = false;
+  }
+  if (ready)
+  {
+    FT_Set_Pixel_Sizes(face, 0, pixelSize);
+  }
+  else
+  {
+    std::cout << "ERROR::GLYPH_RASTERIZER: Failed to create worker FT_Face" << std::endl;
+  }
+
+  for (;;)
+  {
+    unsigned int codepoint;
+    {
+      std::unique_lock<std::mutex> lock(jobMutex);
+      while (!stopping && jobs.empty())
+      {
+        jobReady.wait(lock);
+      }
+      if (stopping)
+      {
+        break;
+      }
+      codepoint = jobs.front();
+      jobs.pop_front();
+    }
+
+    RasterizedGlyph *glyph = new RasterizedGlyph();
+    if (ready)
+    {
+      rasterizeGlyph(face, codepoint, renderMode, *glyph);
+    }
+    else
+    {
+      glyph->codepoint = codepoint;
+      glyph->failed = true;
+    }
+
+    // 결과 큐가 가득 차 있다면 GL 스레드가 꺼내갈 때까지 양보하며 재시도
+    while (!results.push(glyph))
+    {
+      if (stopping)
+      {
+        delete glyph;
+        glyph = NULL;
+        break;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  if (ready)
+  {
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+  }
+}
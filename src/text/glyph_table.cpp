@@ -0,0 +1,187 @@
+#include "text/glyph_table.hpp"
+
+// GlyphTable 클래스 생성자
+GlyphTable::GlyphTable()
+    : denseCount(0), sparseCount(0), shift(32)
+{
+  clear();
+}
+
+// 저장된 모든 glyph 제거
+void GlyphTable::clear()
+{
+  for (unsigned int i = 0; i < DENSE_RANGE; i++)
+  {
+    dense[i] = NO_INDEX;
+  }
+  denseCount = 0;
+
+  slots.clear();
+  sparseCount = 0;
+  shift = 32;
+}
+
+// codepoint 를 해시 테이블의 시작 slot index 로 변환
+size_t GlyphTable::slotIndex(unsigned int codepoint) const
+{
+  /**
+   * Fibonacci hashing : 황금비에서 유도한 상수(2^32 / φ)를 곱한 32-bit 결과의 상위 log2(slot 개수) bit 를 사용함.
+   *
+   * 곱셈 결과의 하위 k bit 는 codepoint 의 하위 k bit 에만 의존하므로, 하위 bit 를 mask 로 잘라내면
+   * codepoint mod slot 개수를 뒤섞은 것에 불과해서 slot 개수의 배수만큼 떨어진 codepoint 들이 항상 충돌함.
+   * 상위 bit 는 codepoint 의 모든 bit 가 섞인 값이므로 연속된 codepoint 들(예: 한글 음절 블록)도 테이블 전체에 고르게 흩어짐.
+   */
+  return static_cast<size_t>((codepoint * 2654435769u) >> shift);
+}
+
+// dense 배열 범위 밖의 codepoint 를 해시 테이블에서 찾음
+unsigned int GlyphTable::findSparse(unsigned int codepoint) const
+{
+  if (slots.empty())
+  {
+    return NO_INDEX;
+  }
+
+  // linear probing : 시작 slot 부터 빈 slot 을 만날 때까지 다음 slot 을 순서대로 확인
+  size_t mask = slots.size() - 1;
+  for (size_t i = slotIndex(codepoint);; i = (i + 1) & mask)
+  {
+    const Slot &slot = slots[i];
+    if (slot.key == codepoint)
+    {
+      return slot.value;
+    }
+    if (slot.key == EMPTY_KEY)
+    {
+      return NO_INDEX;
+    }
+  }
+}
+
+// codepoint 에 대응되는 glyph 번호를 추가 (이미 있으면 덮어씀)
+void GlyphTable::insert(unsigned int codepoint, unsigned int index)
+{
+  if (codepoint < DENSE_RANGE)
+  {
+    if (dense[codepoint] == NO_INDEX)
+    {
+      denseCount++;
+    }
+    dense[codepoint] = index;
+    return;
+  }
+
+  // 탐색 길이가 길어지지 않도록 항상 절반 이하만 채워진 상태를 유지함.
+  if ((sparseCount + 1) * 2 > slots.size())
+  {
+    rehash(slots.empty() ? 64 : slots.size() * 2);
+  }
+
+  size_t mask = slots.size() - 1;
+  for (size_t i = slotIndex(codepoint);; i = (i + 1) & mask)
+  {
+    Slot &slot = slots[i];
+    if (slot.key == codepoint)
+    {
+      slot.value = index;
+      return;
+    }
+    if (slot.key == EMPTY_KEY)
+    {
+      slot.key = codepoint;
+      slot.value = index;
+      sparseCount++;
+      return;
+    }
+  }
+}
+
+// codepoint 에 대응되는 glyph 를 제거 (제거된 glyph 가 있으면 true 반환)
+bool GlyphTable::erase(unsigned int codepoint)
+{
+  if (codepoint < DENSE_RANGE)
+  {
+    if (dense[codepoint] == NO_INDEX)
+    {
+      return false;
+    }
+    dense[codepoint] = NO_INDEX;
+    denseCount--;
+    return true;
+  }
+
+  if (slots.empty())
+  {
+    return false;
+  }
+
+  size_t mask = slots.size() - 1;
+  size_t hole = slotIndex(codepoint);
+  for (;; hole = (hole + 1) & mask)
+  {
+    if (slots[hole].key == codepoint)
+    {
+      break;
+    }
+    if (slots[hole].key == EMPTY_KEY)
+    {
+      return false;
+    }
+  }
+
+  /**
+   * backward shift deletion
+   *
+   * linear probing 테이블에서 slot 을 그냥 비워버리면 그 뒤에 밀려서 저장된 항목들을 찾지 못하게 되므로,
+   * 빈 slot 을 만날 때까지 뒤따르는 항목들 중 원래 위치가 구멍(hole) 이전인 항목을 구멍으로 당겨옴.
+   * (tombstone 을 남기지 않으므로 삽입/삭제가 반복되어도 탐색 길이가 늘어나지 않음)
+   */
+  for (size_t next = (hole + 1) & mask;; next = (next + 1) & mask)
+  {
+    if (slots[next].key == EMPTY_KEY)
+    {
+      break;
+    }
+
+    size_t home = slotIndex(slots[next].key);
+    // home 이 (hole, next] 구간 밖에 있다면 hole 위치로 당겨와도 탐색 경로가 끊기지 않음.
+    bool between = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+    if (!between)
+    {
+      slots[hole] = slots[next];
+      hole = next;
+    }
+  }
+
+  slots[hole].key = EMPTY_KEY;
+  sparseCount--;
+  return true;
+}
+
+// 해시 테이블 크기를 newCapacity(2의 거듭제곱)로 늘리고 기존 항목들을 다시 배치
+void GlyphTable::rehash(size_t newCapacity)
+{
+  std::vector<Slot> old;
+  old.swap(slots);
+
+  Slot empty;
+  empty.key = EMPTY_KEY;
+  empty.value = NO_INDEX;
+  slots.assign(newCapacity, empty);
+  sparseCount = 0;
+
+  // slotIndex() 가 곱셈 결과의 상위 log2(newCapacity) bit 를 사용하도록 shift 계산
+  shift = 32;
+  for (size_t capacity = newCapacity; capacity > 1; capacity >>= 1)
+  {
+    shift--;
+  }
+
+  for (size_t i = 0; i < old.size(); i++)
+  {
+    if (old[i].key != EMPTY_KEY)
+    {
+      insert(old[i].key, old[i].value);
+    }
+  }
+}
@@ -0,0 +1,84 @@
+#include "text/kerning_table.hpp"
+
+// KerningTable 클래스 생성자
+KerningTable::KerningTable()
+    : mask(0), count(0)
+{
+}
+
+// 추출된 모든 쌍 제거
+void KerningTable::clear()
+{
+  entries.clear();
+  mask = 0;
+  count = 0;
+}
+
+// face 의 현재 pixel size 로 [first, last] 범위 codepoint 쌍들의 kerning 추출
+size_t KerningTable::build(FT_Face face, unsigned int first, unsigned int last, bool unfitted)
+{
+  clear();
+
+  // 'kern' 테이블이 없는 폰트는 FT_Get_Kerning() 이 항상 0 을 반환하므로 쌍을 순회할 필요도 없음
+  if (!FT_HAS_KERNING(face) || first > last)
+  {
+    return 0;
+  }
+
+  /** 범위 내에서 glyph 가 있는 codepoint 와 glyph index 를 미리 조회 */
+  std::vector<unsigned int> codepoints;
+  std::vector<FT_UInt> glyphIndices;
+  for (unsigned int codepoint = first; codepoint <= last; codepoint++)
+  {
+    FT_UInt index = FT_Get_Char_Index(face, codepoint);
+    if (index != 0)
+    {
+      codepoints.push_back(codepoint);
+      glyphIndices.push_back(index);
+    }
+  }
+
+  /** 모든 쌍의 kerning 을 조회해서 0 이 아닌 쌍만 모음 */
+  FT_UInt kerningMode = unfitted ? FT_KERNING_UNFITTED : FT_KERNING_DEFAULT;
+  std::vector<Entry> pairs;
+  for (size_t l = 0; l < codepoints.size(); l++)
+  {
+    for (size_t r = 0; r < codepoints.size(); r++)
+    {
+      FT_Vector delta;
+      if (FT_Get_Kerning(face, glyphIndices[l], glyphIndices[r], kerningMode, &delta) == 0 && delta.x != 0)
+      {
+        // 26.6 고정소수점 값을 layout 루프에서 바로 더할 수 있도록 px 단위로 변환해서 저장
+        Entry entry = {makeKey(codepoints[l], codepoints[r]), static_cast<float>(delta.x) / 64.0f};
+        pairs.push_back(entry);
+      }
+    }
+  }
+
+  if (pairs.empty())
+  {
+    return 0;
+  }
+
+  /** 부하율이 0.5 이하가 되도록 2의 거듭제곱 크기로 할당하고 linear probing 으로 삽입 */
+  size_t capacity = 16;
+  while (capacity < pairs.size() * 2)
+  {
+    capacity *= 2;
+  }
+  Entry empty = {EMPTY_KEY, 0.0f};
+  entries.assign(capacity, empty);
+  mask = capacity - 1;
+
+  for (size_t i = 0; i < pairs.size(); i++)
+  {
+    size_t slot = hashKey(pairs[i].key) & mask;
+    while (entries[slot].key != EMPTY_KEY)
+    {
+      slot = (slot + 1) & mask;
+    }
+    entries[slot] = pairs[i];
+  }
+  count = pairs.size();
+  return count;
+}
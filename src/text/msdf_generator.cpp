@@ -0,0 +1,616 @@
+#include "text/msdf_generator.hpp"
+
+#include FT_OUTLINE_H
+
+#include <cmath> // std::sqrt, std::fabs, std::floor, std::ceil
+
+namespace
+{
+  // 외곽선 좌표 및 거리 계산용 2차원 벡터 (26.6 고정소수점 좌표를 pixel 단위 double 로 변환해서 사용)
+  struct Vec2
+  {
+    double x, y;
+    Vec2() : x(0.0), y(0.0) {}
+    Vec2(double x, double y) : x(x), y(y) {}
+  };
+
+  inline Vec2 operator+(const Vec2 &a, const Vec2 &b) { return Vec2(a.x + b.x, a.y + b.y); }
+  inline Vec2 operator-(const Vec2 &a, const Vec2 &b) { return Vec2(a.x - b.x, a.y - b.y); }
+  inline Vec2 operator*(double s, const Vec2 &a) { return Vec2(s * a.x, s * a.y); }
+  inline double dot(const Vec2 &a, const Vec2 &b) { return a.x * b.x + a.y * b.y; }
+  inline double cross(const Vec2 &a, const Vec2 &b) { return a.x * b.y - a.y * b.x; }
+  inline double length(const Vec2 &a) { return std::sqrt(dot(a, a)); }
+
+  // 길이가 0 인 벡터는 방향을 알 수 없으므로 임의의 단위 벡터를 반환
+  inline Vec2 normalize(const Vec2 &a)
+  {
+    double len = length(a);
+    return len > 0.0 ? Vec2(a.x / len, a.y / len) : Vec2(0.0, 1.0);
+  }
+
+  inline double nonZeroSign(double value) { return value > 0.0 ? 1.0 : -1.0; }
+
+  // edge 색상 = 거리값을 기록할 채널 조합 (bit 0 = R, bit 1 = G, bit 2 = B)
+  enum EdgeColor
+  {
+    EDGE_YELLOW = 1 | 2,
+    EDGE_MAGENTA = 1 | 4,
+    EDGE_CYAN = 2 | 4,
+    EDGE_WHITE = 1 | 2 | 4
+  };
+
+  // 외곽선을 이루는 직선(degree 1) 또는 2차 베지어 곡선(degree 2) edge
+  struct Edge
+  {
+    int degree;
+    Vec2 p[3];
+    int color;
+
+    Vec2 point(double t) const
+    {
+      if (degree == 1)
+      {
+        return p[0] + t * (p[1] - p[0]);
+      }
+      return (1.0 - t) * (1.0 - t) * p[0] + (2.0 * t * (1.0 - t)) * p[1] + (t * t) * p[2];
+    }
+
+    Vec2 direction(double t) const
+    {
+      if (degree == 1)
+      {
+        return p[1] - p[0];
+      }
+      Vec2 tangent = (1.0 - t) * (p[1] - p[0]) + t * (p[2] - p[1]);
+      // 제어점이 끝점과 겹쳐서 접선이 0 이 되는 경우에는 반대편 끝점 방향을 사용
+      if (tangent.x == 0.0 && tangent.y == 0.0)
+      {
+        return p[2] - p[0];
+      }
+      return tangent;
+    }
+
+    Vec2 end() const { return p[degree]; }
+  };
+
+  Edge makeLinear(const Vec2 &p0, const Vec2 &p1)
+  {
+    Edge edge;
+    edge.degree = 1;
+    edge.p[0] = p0;
+    edge.p[1] = p1;
+    edge.color = EDGE_WHITE;
+    return edge;
+  }
+
+  Edge makeQuadratic(const Vec2 &p0, const Vec2 &p1, const Vec2 &p2)
+  {
+    Edge edge;
+    edge.degree = 2;
+    edge.p[0] = p0;
+    edge.p[1] = p1;
+    edge.p[2] = p2;
+    edge.color = EDGE_WHITE;
+    return edge;
+  }
+
+  // edge 를 [t0, t1] 구간만 남긴 edge 로 자름
+  Edge subEdge(const Edge &edge, double t0, double t1)
+  {
+    if (edge.degree == 1)
+    {
+      return makeLinear(edge.point(t0), edge.point(t1));
+    }
+    // 2차 곡선 구간의 제어점은 양 끝점의 접선이 만나는 점
+    Vec2 a = edge.point(t0);
+    Vec2 b = edge.point(t1);
+    Vec2 control = a + (0.5 * (t1 - t0)) * (2.0 * ((1.0 - t0) * (edge.p[1] - edge.p[0]) + t0 * (edge.p[2] - edge.p[1])));
+    return makeQuadratic(a, control, b);
+  }
+
+  struct Contour
+  {
+    std::vector<Edge> edges;
+  };
+
+  /** 외곽선까지의 signed distance (같은 거리라면 edge 방향과 더 수직으로 만나는 쪽을 가까운 것으로 봄) */
+  struct SignedDistance
+  {
+    double distance;
+    double dot;
+  };
+
+  inline bool closer(const SignedDistance &a, const SignedDistance &b)
+  {
+    double da = std::fabs(a.distance);
+    double db = std::fabs(b.distance);
+    return da < db || (da == db && a.dot < b.dot);
+  }
+
+  /** 3차 이하 방정식의 실근 계산 (2차 곡선 위에서 점 p 와 가장 가까운 위치를 찾는 데 사용) */
+  int solveQuadratic(double x[3], double a, double b, double c)
+  {
+    if (a == 0.0 || std::fabs(b) > 1e12 * std::fabs(a))
+    {
+      if (b == 0.0)
+      {
+        return 0;
+      }
+      x[0] = -c / b;
+      return 1;
+    }
+
+    double discriminant = b * b - 4.0 * a * c;
+    if (discriminant > 0.0)
+    {
+      discriminant = std::sqrt(discriminant);
+      x[0] = (-b + discriminant) / (2.0 * a);
+      x[1] = (-b - discriminant) / (2.0 * a);
+      return 2;
+    }
+    if (discriminant == 0.0)
+    {
+      x[0] = -b / (2.0 * a);
+      return 1;
+    }
+    return 0;
+  }
+
+  int solveCubicNormed(double x[3], double a, double b, double c)
+  {
+    const double PI = 3.14159265358979323846;
+    double a2 = a * a;
+    double q = (a2 - 3.0 * b) / 9.0;
+    double r = (a * (2.0 * a2 - 9.0 * b) + 27.0 * c) / 54.0;
+    double r2 = r * r;
+    double q3 = q * q * q;
+    a /= 3.0;
+
+    if (r2 < q3)
+    {
+      double t = r / std::sqrt(q3);
+      t = t < -1.0 ? -1.0 : (t > 1.0 ? 1.0 : t);
+      t = std::acos(t);
+      q = -2.0 * std::sqrt(q);
+      x[0] = q * std::cos(t / 3.0) - a;
+      x[1] = q * std::cos((t + 2.0 * PI) / 3.0) - a;
+      x[2] = q * std::cos((t - 2.0 * PI) / 3.0) - a;
+      return 3;
+    }
+
+    double u = (r < 0.0 ? 1.0 : -1.0) * std::pow(std::fabs(r) + std::sqrt(r2 - q3), 1.0 / 3.0);
+    double v = u == 0.0 ? 0.0 : q / u;
+    x[0] = (u + v) - a;
+    if (u == v || std::fabs(u - v) < 1e-12 * std::fabs(u + v))
+    {
+      x[1] = -0.5 * (u + v) - a;
+      return 2;
+    }
+    return 1;
+  }
+
+  int solveCubic(double x[3], double a, double b, double c, double d)
+  {
+    if (a != 0.0)
+    {
+      double bn = b / a;
+      if (std::fabs(bn) < 1e6)
+      {
+        return solveCubicNormed(x, bn, c / a, d / a);
+      }
+    }
+    return solveQuadratic(x, b, c, d);
+  }
+
+  /**
+   * 점 p 에서 edge 까지의 signed distance 와 가장 가까운 위치의 곡선 parameter 를 계산
+   *
+   * 부호는 edge 진행 방향의 오른쪽이 양수이며, 가장 가까운 위치가 edge 끝점이라면
+   * 끝점 접선과 끝점->p 방향이 얼마나 평행한지(dot)를 함께 기록해서 모서리를 공유하는 두 edge 중 하나를 고를 때 사용함.
+   */
+  SignedDistance signedDistance(const Edge &edge, const Vec2 &p, double &param)
+  {
+    SignedDistance result;
+
+    if (edge.degree == 1)
+    {
+      Vec2 aq = p - edge.p[0];
+      Vec2 ab = edge.p[1] - edge.p[0];
+      param = dot(aq, ab) / dot(ab, ab);
+      Vec2 eq = (param > 0.5 ? edge.p[1] : edge.p[0]) - p;
+      double endpointDistance = length(eq);
+      if (param > 0.0 && param < 1.0)
+      {
+        Vec2 ortho = normalize(Vec2(ab.y, -ab.x));
+        double orthoDistance = dot(ortho, aq);
+        if (std::fabs(orthoDistance) < endpointDistance)
+        {
+          result.distance = orthoDistance;
+          result.dot = 0.0;
+          return result;
+        }
+      }
+      result.distance = nonZeroSign(cross(aq, ab)) * endpointDistance;
+      result.dot = std::fabs(dot(normalize(ab), normalize(eq)));
+      return result;
+    }
+
+    Vec2 qa = edge.p[0] - p;
+    Vec2 ab = edge.p[1] - edge.p[0];
+    Vec2 br = edge.p[2] - edge.p[1] - ab;
+    double a = dot(br, br);
+    double b = 3.0 * dot(ab, br);
+    double c = 2.0 * dot(ab, ab) + dot(qa, br);
+    double d = dot(qa, ab);
+    double t[3];
+    int solutions = solveCubic(t, a, b, c, d);
+
+    // 양 끝점까지의 거리를 먼저 후보로 두고
+    Vec2 startDirection = edge.direction(0.0);
+    double minDistance = nonZeroSign(cross(startDirection, qa)) * length(qa);
+    param = -dot(qa, startDirection) / dot(startDirection, startDirection);
+
+    Vec2 endDirection = edge.direction(1.0);
+    Vec2 eq = edge.p[2] - p;
+    double endDistance = length(eq);
+    if (endDistance < std::fabs(minDistance))
+    {
+      minDistance = nonZeroSign(cross(endDirection, eq)) * endDistance;
+      param = dot(p - edge.p[1], endDirection) / dot(endDirection, endDirection);
+    }
+
+    // 곡선 내부(0 < t < 1)의 극값 위치들 중 더 가까운 곳이 있다면 교체
+    for (int i = 0; i < solutions; i++)
+    {
+      if (t[i] > 0.0 && t[i] < 1.0)
+      {
+        Vec2 qe = qa + (2.0 * t[i]) * ab + (t[i] * t[i]) * br;
+        double distance = length(qe);
+        if (distance <= std::fabs(minDistance))
+        {
+          minDistance = nonZeroSign(cross(ab + t[i] * br, qe)) * distance;
+          param = t[i];
+        }
+      }
+    }
+
+    result.distance = minDistance;
+    if (param >= 0.0 && param <= 1.0)
+    {
+      result.dot = 0.0;
+    }
+    else if (param < 0.5)
+    {
+      result.dot = std::fabs(dot(normalize(startDirection), normalize(qa)));
+    }
+    else
+    {
+      result.dot = std::fabs(dot(normalize(endDirection), normalize(eq)));
+    }
+    return result;
+  }
+
+  /**
+   * 가장 가까운 위치가 edge 끝점 바깥쪽이라면, edge 를 끝점 접선 방향으로 연장한 직선까지의 거리(pseudo-distance)로 바꿈
+   *
+   * 모서리 바깥 영역에서도 각 채널이 해당 edge 를 무한히 연장한 것처럼 거리를 기록해야
+   * median 으로 복원한 외곽선이 모서리에서 뭉개지지 않고 날카롭게 만나게 됨.
+   */
+  double pseudoDistance(const Edge &edge, const Vec2 &p, const SignedDistance &distance, double param)
+  {
+    if (param < 0.0)
+    {
+      Vec2 direction = normalize(edge.direction(0.0));
+      Vec2 aq = p - edge.p[0];
+      if (dot(aq, direction) < 0.0)
+      {
+        double pseudo = cross(aq, direction);
+        if (std::fabs(pseudo) <= std::fabs(distance.distance))
+        {
+          return pseudo;
+        }
+      }
+    }
+    else if (param > 1.0)
+    {
+      Vec2 direction = normalize(edge.direction(1.0));
+      Vec2 bq = p - edge.end();
+      if (dot(bq, direction) > 0.0)
+      {
+        double pseudo = cross(bq, direction);
+        if (std::fabs(pseudo) <= std::fabs(distance.distance))
+        {
+          return pseudo;
+        }
+      }
+    }
+    return distance.distance;
+  }
+
+  /** FT_Outline_Decompose() 콜백 : 외곽선 명령을 Contour / Edge 로 변환 */
+  struct DecomposeContext
+  {
+    std::vector<Contour> contours;
+    Vec2 position;
+  };
+
+  inline Vec2 toVec2(const FT_Vector *v) { return Vec2(v->x / 64.0, v->y / 64.0); }
+
+  int moveTo(const FT_Vector *to, void *user)
+  {
+    DecomposeContext *context = static_cast<DecomposeContext *>(user);
+    context->contours.push_back(Contour());
+    context->position = toVec2(to);
+    return 0;
+  }
+
+  int lineTo(const FT_Vector *to, void *user)
+  {
+    DecomposeContext *context = static_cast<DecomposeContext *>(user);
+    Vec2 end = toVec2(to);
+    // 길이가 0 인 edge 는 방향이 없으므로 건너뜀
+    if (end.x != context->position.x || end.y != context->position.y)
+    {
+      context->contours.back().edges.push_back(makeLinear(context->position, end));
+      context->position = end;
+    }
+    return 0;
+  }
+
+  int conicTo(const FT_Vector *control, const FT_Vector *to, void *user)
+  {
+    DecomposeContext *context = static_cast<DecomposeContext *>(user);
+    Vec2 end = toVec2(to);
+    context->contours.back().edges.push_back(makeQuadratic(context->position, toVec2(control), end));
+    context->position = end;
+    return 0;
+  }
+
+  int cubicTo(const FT_Vector *control1, const FT_Vector *control2, const FT_Vector *to, void *user)
+  {
+    /**
+     * CFF(.otf) 폰트의 3차 베지어 곡선은 4개의 2차 곡선으로 근사함.
+     *
+     * 각 구간 [t0, t1] 의 3차 곡선을 양 끝점과 끝점 접선이 같은 3차 곡선으로 만든 뒤,
+     * 두 제어점의 가중 평균 (3 * (c1 + c2) - p0 - p1) / 4 를 2차 곡선의 제어점으로 사용함.
+     */
+    const int SEGMENTS = 4;
+    DecomposeContext *context = static_cast<DecomposeContext *>(user);
+    Vec2 p0 = context->position;
+    Vec2 p1 = toVec2(control1);
+    Vec2 p2 = toVec2(control2);
+    Vec2 p3 = toVec2(to);
+
+    for (int i = 0; i < SEGMENTS; i++)
+    {
+      double t0 = static_cast<double>(i) / SEGMENTS;
+      double t1 = static_cast<double>(i + 1) / SEGMENTS;
+      double dt = t1 - t0;
+
+      Vec2 a, b, da, db;
+      double ts[2] = {t0, t1};
+      for (int n = 0; n < 2; n++)
+      {
+        double t = ts[n];
+        double s = 1.0 - t;
+        Vec2 point = (s * s * s) * p0 + (3.0 * s * s * t) * p1 + (3.0 * s * t * t) * p2 + (t * t * t) * p3;
+        Vec2 tangent = (3.0 * s * s) * (p1 - p0) + (6.0 * s * t) * (p2 - p1) + (3.0 * t * t) * (p3 - p2);
+        if (n == 0)
+        {
+          a = point;
+          da = tangent;
+        }
+        else
+        {
+          b = point;
+          db = tangent;
+        }
+      }
+
+      Vec2 c1 = a + (dt / 3.0) * da;
+      Vec2 c2 = b - (dt / 3.0) * db;
+      Vec2 control = 0.25 * (3.0 * (c1 + c2) - a - b);
+      context->contours.back().edges.push_back(makeQuadratic(a, control, b));
+    }
+    context->position = p3;
+    return 0;
+  }
+
+  /** edge coloring */
+  // 두 edge 가 만나는 각도가 이보다 크게 꺾이면 모서리로 판단 (sin(3 rad) -> 약 8도 이상 꺾이는 경우)
+  const double CORNER_CROSS_THRESHOLD = 0.14112000805986721;
+
+  inline bool isCorner(const Vec2 &a, const Vec2 &b)
+  {
+    return dot(a, b) <= 0.0 || std::fabs(cross(a, b)) > CORNER_CROSS_THRESHOLD;
+  }
+
+  // n 개 edge 중 position 번째 edge 를 앞 / 가운데 / 뒤 세 구간 중 하나(-1, 0, 1)로 대칭이 되도록 분류
+  inline int symmetricalTrichotomy(int position, int n)
+  {
+    return static_cast<int>(3 + 2.875 * position / (n - 1) - 1.4375 + 0.5) - 3;
+  }
+
+  // 모서리 사이의 edge 묶음(spline)별 색상 -> 인접한 spline 끼리는 항상 다른 색이면서 정확히 한 채널만 공유함
+  inline int splineColor(int spline, int splineCount)
+  {
+    if (splineCount > 2 && spline == splineCount - 1)
+    {
+      // 마지막 spline 은 바로 앞 spline, 그리고 contour 를 한 바퀴 돌아 첫 spline 과도 인접하므로 두 색과 모두 다른 색 사용
+      return EDGE_YELLOW;
+    }
+    return spline % 2 ? EDGE_MAGENTA : EDGE_CYAN;
+  }
+
+  void colorEdges(Contour &contour)
+  {
+    std::vector<Edge> &edges = contour.edges;
+    int edgeCount = static_cast<int>(edges.size());
+
+    std::vector<int> corners;
+    Vec2 previousDirection = normalize(edges.back().direction(1.0));
+    for (int i = 0; i < edgeCount; i++)
+    {
+      if (isCorner(previousDirection, normalize(edges[i].direction(0.0))))
+      {
+        corners.push_back(i);
+      }
+      previousDirection = normalize(edges[i].direction(1.0));
+    }
+
+    if (corners.empty())
+    {
+      // 모서리가 없는 매끄러운 contour (예: 'O') 는 모든 채널이 같은 거리를 가짐
+      for (int i = 0; i < edgeCount; i++)
+      {
+        edges[i].color = EDGE_WHITE;
+      }
+      return;
+    }
+
+    if (corners.size() == 1)
+    {
+      /**
+       * 모서리가 하나뿐인 물방울 모양 contour 는 모서리 양쪽 edge 들을 서로 다른 색으로 칠하되,
+       * 가운데 부분은 WHITE 로 두어 양쪽 색이 자연스럽게 이어지도록 함.
+       * edge 가 3개보다 적으면 세 구간을 만들 수 없으므로 edge 를 3등분해서 사용함.
+       */
+      const int colors[3] = {EDGE_MAGENTA, EDGE_WHITE, EDGE_YELLOW};
+      int corner = corners[0];
+
+      if (edgeCount >= 3)
+      {
+        for (int i = 0; i < edgeCount; i++)
+        {
+          edges[(corner + i) % edgeCount].color = colors[1 + symmetricalTrichotomy(i, edgeCount)];
+        }
+        return;
+      }
+
+      std::vector<Edge> parts;
+      for (int i = 0; i < edgeCount; i++)
+      {
+        const Edge &edge = edges[(corner + i) % edgeCount];
+        for (int n = 0; n < 3; n++)
+        {
+          parts.push_back(subEdge(edge, n / 3.0, (n + 1) / 3.0));
+        }
+      }
+      for (size_t i = 0; i < parts.size(); i++)
+      {
+        parts[i].color = colors[(3 * i) / parts.size()];
+      }
+      edges.swap(parts);
+      return;
+    }
+
+    // 모서리가 여러 개라면 모서리를 지날 때마다 색을 바꿈
+    int splineCount = static_cast<int>(corners.size());
+    int spline = 0;
+    int start = corners[0];
+    for (int i = 0; i < edgeCount; i++)
+    {
+      int index = (start + i) % edgeCount;
+      if (spline + 1 < splineCount && corners[spline + 1] == index)
+      {
+        spline++;
+      }
+      edges[index].color = splineColor(spline, splineCount);
+    }
+  }
+}
+
+// FreeType glyph 외곽선으로부터 multi-channel signed distance field(MSDF) bitmap 생성
+bool generateMsdf(FT_Outline *outline, int spread, std::vector<unsigned char> &msdf,
+                  int &width, int &height, int &left, int &top)
+{
+  /** 1. 외곽선 분해 */
+  DecomposeContext context;
+  FT_Outline_Funcs funcs;
+  funcs.move_to = moveTo;
+  funcs.line_to = lineTo;
+  funcs.conic_to = conicTo;
+  funcs.cubic_to = cubicTo;
+  funcs.shift = 0;
+  funcs.delta = 0;
+  if (FT_Outline_Decompose(outline, &funcs, &context) != 0)
+  {
+    return false;
+  }
+
+  std::vector<Edge> edges;
+  for (size_t i = 0; i < context.contours.size(); i++)
+  {
+    Contour &contour = context.contours[i];
+    if (contour.edges.empty())
+    {
+      continue;
+    }
+
+    /** 2. edge coloring */
+    colorEdges(contour);
+    edges.insert(edges.end(), contour.edges.begin(), contour.edges.end());
+  }
+  if (edges.empty())
+  {
+    return false;
+  }
+
+  // 외곽선 bounding box 를 pixel 격자에 맞추고 사방으로 spread 만큼 여백 추가
+  FT_BBox box;
+  FT_Outline_Get_CBox(outline, &box);
+  left = static_cast<int>(std::floor(box.xMin / 64.0)) - spread;
+  top = static_cast<int>(std::ceil(box.yMax / 64.0)) + spread;
+  width = static_cast<int>(std::ceil(box.xMax / 64.0)) + spread - left;
+  height = top - (static_cast<int>(std::floor(box.yMin / 64.0)) - spread);
+
+  // TrueType 외곽선은 시계 방향으로 채워지므로 edge 진행 방향의 오른쪽이 glyph 안쪽이지만, PostScript 외곽선은 반대임
+  double inside = FT_Outline_Get_Orientation(outline) == FT_ORIENTATION_POSTSCRIPT ? -1.0 : 1.0;
+
+  /** 3. 픽셀마다 채널별 pseudo-distance 계산 */
+  msdf.resize(static_cast<size_t>(width) * height * 3);
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      // bitmap 첫 줄이 glyph 최상단이므로 y 는 아래로 갈수록 외곽선 좌표가 작아짐 (픽셀 중심에서 샘플링)
+      Vec2 p(left + x + 0.5, top - y - 0.5);
+
+      SignedDistance minDistance[3];
+      const Edge *nearest[3] = {NULL, NULL, NULL};
+      double nearestParam[3] = {0.0, 0.0, 0.0};
+      for (int c = 0; c < 3; c++)
+      {
+        minDistance[c].distance = -1e240;
+        minDistance[c].dot = 1.0;
+      }
+
+      for (size_t i = 0; i < edges.size(); i++)
+      {
+        double param;
+        SignedDistance distance = signedDistance(edges[i], p, param);
+        for (int c = 0; c < 3; c++)
+        {
+          if ((edges[i].color & (1 << c)) && closer(distance, minDistance[c]))
+          {
+            minDistance[c] = distance;
+            nearest[c] = &edges[i];
+            nearestParam[c] = param;
+          }
+        }
+      }
+
+      unsigned char *texel = &msdf[(static_cast<size_t>(y) * width + x) * 3];
+      for (int c = 0; c < 3; c++)
+      {
+        double distance = nearest[c] ? pseudoDistance(*nearest[c], p, minDistance[c], nearestParam[c])
+                                     : minDistance[c].distance;
+        double value = 0.5 + inside * distance / (2.0 * spread);
+        value = value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value);
+        texel[c] = static_cast<unsigned char>(value * 255.0 + 0.5);
+      }
+    }
+  }
+
+  return true;
+}
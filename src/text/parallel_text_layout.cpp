@@ -0,0 +1,217 @@
+#include "text/parallel_text_layout.hpp"
+
+#include <algorithm> // std::sort, std::unique
+#include <chrono>    // std::chrono
+
+// ParallelTextLayout 클래스 생성자
+ParallelTextLayout::ParallelTextLayout(JobSystem &jobs, GlyphCache &glyphs, TextShaper *shaper)
+    : jobs(jobs), glyphs(glyphs), shaper(shaper), blocks(NULL), mode(TEXT_BATCH_VERTICES), force(false)
+{
+  for (unsigned int i = 0; i < jobs.getWorkerCount(); i++)
+  {
+    arenas.push_back(new Arena());
+  }
+
+  stats.blocks = 0;
+  stats.glyphs = 0;
+  stats.relayouts = 0;
+  stats.layoutMs = 0.0;
+  stats.submitMs = 0.0;
+}
+
+// ParallelTextLayout 클래스 소멸자
+ParallelTextLayout::~ParallelTextLayout()
+{
+  for (size_t i = 0; i < arenas.size(); i++)
+  {
+    delete arenas[i];
+  }
+}
+
+// 텍스트 블록들의 layout 과 정점 데이터 생성을 병렬로 처리
+void ParallelTextLayout::build(const TextBlock *blocks, size_t count, TextBatchMode mode)
+{
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+  this->blocks = blocks;
+  this->mode = mode;
+  force = false;
+  stats.blocks = static_cast<unsigned int>(count);
+  stats.relayouts = 0;
+
+  // 블록 개수가 늘어날 때만 배열이 커지고, 줄어들 때는 기존 원소(와 그 안의 배열 capacity)를 그대로 재사용
+  if (layouts.size() < count)
+  {
+    layouts.resize(count);
+    results.resize(count);
+  }
+  resetArenas();
+
+  /** 1. shaping (FT_Face 를 사용하므로 GL 스레드에서, 대부분 TextShaper 캐시 조회로 끝남) */
+  if (shaper)
+  {
+    if (runs.size() < count)
+    {
+      runs.resize(count);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      // shape() 가 반환한 참조는 다음 shape() 호출 때 무효화될 수 있으므로 블록별 run 에 복사해둠 (capacity 재사용)
+      runs[i] = shaper->shape(blocks[i].text);
+    }
+  }
+
+  /** 2. 모든 블록의 layout + 정점 데이터 생성을 worker 들에게 나눠서 실행 */
+  jobBlocks.clear();
+  for (size_t i = 0; i < count; i++)
+  {
+    jobBlocks.push_back(i);
+  }
+  unsigned int evictionsBefore = glyphs.getStats().evictions;
+  jobs.parallelFor(&ParallelTextLayout::layoutJob, this, jobBlocks.size());
+
+  /** 3. 캐시에 없던 glyph 들을 GL 스레드에서 한꺼번에 올리고 해당 블록들만 다시 실행 */
+  missing.clear();
+  jobBlocks.clear();
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!results[i].built)
+    {
+      const std::vector<unsigned int> &blockMissing = layouts[i].getMissing();
+      missing.insert(missing.end(), blockMissing.begin(), blockMissing.end());
+      jobBlocks.push_back(i);
+    }
+  }
+
+  if (!jobBlocks.empty())
+  {
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+    glyphs.preload(&missing[0], missing.size());
+
+    if (glyphs.getStats().evictions != evictionsBefore)
+    {
+      // 페이지가 제거되어 이미 생성한 정점 데이터의 uv 도 무효일 수 있으므로 모든 블록을 다시 실행
+      resetArenas();
+      jobBlocks.clear();
+      for (size_t i = 0; i < count; i++)
+      {
+        jobBlocks.push_back(i);
+      }
+    }
+
+    // 메모리 예산이 부족해서 여전히 올리지 못한 glyph 는 빼고 나머지로 정점 데이터를 생성
+    force = true;
+    stats.relayouts = static_cast<unsigned int>(jobBlocks.size());
+    jobs.parallelFor(&ParallelTextLayout::layoutJob, this, jobBlocks.size());
+  }
+
+  stats.glyphs = 0;
+  for (size_t i = 0; i < arenas.size(); i++)
+  {
+    stats.glyphs += static_cast<unsigned int>(arenas[i]->vertices.size() / 6 + arenas[i]->instances.size());
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+  stats.layoutMs = elapsed.count();
+}
+
+// build() 결과를 블록 순서대로 TextBatcher 에 제출
+void ParallelTextLayout::submit(TextBatcher &batcher)
+{
+  std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+  unsigned int evictions = glyphs.getStats().evictions;
+  for (size_t i = 0; i < stats.blocks; i++)
+  {
+    const BlockResult &result = results[i];
+
+    // build() 이후 페이지가 제거되었다면 uv 가 무효일 수 있으므로 제출하지 않음 (다음 build() 에서 다시 layout 됨)
+    if (!result.built || layouts[i].getEvictions() != evictions)
+    {
+      continue;
+    }
+
+    const Arena &arena = *arenas[result.worker];
+    for (size_t j = 0; j < result.segmentCount; j++)
+    {
+      const Segment &segment = arena.segments[result.firstSegment + j];
+      glyphs.touchPage(segment.page);
+      if (mode == TEXT_BATCH_INSTANCED)
+      {
+        batcher.submitInstances(segment.key, &arena.instances[segment.first], segment.count);
+      }
+      else
+      {
+        batcher.submitVertices(segment.key, &arena.vertices[segment.first], segment.count);
+      }
+    }
+  }
+
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+  stats.submitMs = elapsed.count();
+}
+
+// JobSystem 작업 함수
+void ParallelTextLayout::layoutJob(void *context, size_t index, unsigned int worker)
+{
+  ParallelTextLayout *self = static_cast<ParallelTextLayout *>(context);
+  self->layoutBlock(self->jobBlocks[index], worker, self->force);
+}
+
+// 블록 하나를 layout 하고 worker 의 arena 에 정점 데이터 생성
+void ParallelTextLayout::layoutBlock(size_t block, unsigned int worker, bool force)
+{
+  const TextBlock &input = blocks[block];
+  TextLayout &layout = layouts[block];
+  BlockResult &result = results[block];
+
+  if (shaper)
+  {
+    layout.layout(runs[block], glyphs, input.x, input.y, input.scale);
+  }
+  else
+  {
+    layout.layout(input.text, glyphs, input.x, input.y, input.scale);
+  }
+
+  result.worker = worker;
+  result.built = false;
+  if (!layout.isComplete() && !force)
+  {
+    // GL 스레드가 glyph 를 올린 뒤 다시 실행함
+    return;
+  }
+
+  /** 같은 페이지가 이어지는 구간마다 SIMD 커널로 mode 형식의 정점 데이터를 arena 에 기록 (구간 하나가 segment 하나) */
+  Arena &arena = *arenas[worker];
+  result.firstSegment = arena.segments.size();
+
+  size_t glyphCount = layout.getGlyphCount();
+  for (size_t i = 0; i < glyphCount;)
+  {
+    size_t end = layout.getPageRunEnd(i);
+    unsigned int page = layout.getPage(i);
+    size_t first = mode == TEXT_BATCH_INSTANCED ? arena.instances.size() : arena.vertices.size();
+    layout.appendQuads(i, end - i, input.color, mode, arena.vertices, arena.instances);
+    size_t count = (mode == TEXT_BATCH_INSTANCED ? arena.instances.size() : arena.vertices.size()) - first;
+
+    Segment segment = {{input.features, glyphs.getPageTexture(page), TEXT_BLEND_ALPHA}, page, first, count};
+    arena.segments.push_back(segment);
+    i = end;
+  }
+
+  result.segmentCount = arena.segments.size() - result.firstSegment;
+  result.built = true;
+}
+
+// 모든 arena 비우기 (capacity 는 유지)
+void ParallelTextLayout::resetArenas()
+{
+  for (size_t i = 0; i < arenas.size(); i++)
+  {
+    arenas[i]->vertices.clear();
+    arenas[i]->instances.clear();
+    arenas[i]->segments.clear();
+  }
+}
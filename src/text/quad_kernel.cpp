@@ -0,0 +1,304 @@
+#include "text/quad_kernel.hpp"
+
+#include <cstring> // std::memcpy
+
+/**
+ * SIMD 명령어 집합 사용 가능 여부
+ *
+ * SSE2 는 x86-64 의 기본 명령어 집합이므로 컴파일 옵션 없이 사용하고,
+ * AVX2 는 함수 단위로만 활성화(GCC / Clang 의 target attribute)한 뒤 실행 중에 CPU 지원 여부를 확인해서 호출함.
+ * 따라서 실행파일은 AVX2 가 없는 CPU 에서도 그대로 동작함.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QUAD_KERNEL_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(QUAD_KERNEL_HAS_SSE2) && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
+#define QUAD_KERNEL_HAS_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define QUAD_KERNEL_TARGET_AVX2
+#else
+#define QUAD_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+/**
+ * storeFour() 는 AVX2 커널 안에 반드시 inline 되어야 함.
+ * 별도 함수로 호출되면 VEX 가 아닌 SSE 명령어로 컴파일된 코드가 AVX 레지스터 상위 절반이 사용 중인 상태에서 실행되어
+ * SSE / AVX 상태 전환 비용이 매 호출마다 발생함 (AVX2 커널이 scalar 보다 2배 느려짐).
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define QUAD_KERNEL_INLINE __forceinline
+#else
+#define QUAD_KERNEL_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace
+{
+  // [0, 1] 범위의 색상값을 8-bit 정수로 변환 (appendTextQuad() 와 같은 반올림)
+  unsigned char toByte(float v)
+  {
+    if (v <= 0.0f)
+      return 0;
+    if (v >= 1.0f)
+      return 255;
+    return static_cast<unsigned char>(v * 255.0f + 0.5f);
+  }
+
+  /** scalar 커널 (SIMD 커널의 나머지 glyph 처리 및 x86 이 아닌 CPU 용) */
+  void generateScalar(const QuadSource &source, size_t first, size_t end, float scale, const unsigned char rgba[4],
+                      TextBatchMode mode, unsigned char *out)
+  {
+    for (size_t i = first; i < end; i++)
+    {
+      float x = source.originX[i] + source.bearingX[i] * scale;
+      float y = source.originY[i] - (source.sizeY[i] - source.bearingY[i]) * scale;
+      float w = source.sizeX[i] * scale;
+      float h = source.sizeY[i] * scale;
+      float u0 = source.u0[i];
+      float v0 = source.v0[i];
+      float u1 = source.u1[i];
+      float v1 = source.v1[i];
+
+      if (mode == TEXT_BATCH_INSTANCED)
+      {
+        TextInstance *instance = reinterpret_cast<TextInstance *>(out);
+        instance->Rect[0] = x;
+        instance->Rect[1] = y;
+        instance->Rect[2] = w;
+        instance->Rect[3] = h;
+        instance->UV[0] = u0;
+        instance->UV[1] = v0;
+        instance->UV[2] = u1;
+        instance->UV[3] = v1;
+        std::memcpy(instance->Color, rgba, 4);
+        out += sizeof(TextInstance);
+        continue;
+      }
+
+      TextVertex v[6] = {
+          {{x, y + h, u0, v0}, {0, 0, 0, 0}},
+          {{x, y, u0, v1}, {0, 0, 0, 0}},
+          {{x + w, y, u1, v1}, {0, 0, 0, 0}},
+          {{x, y + h, u0, v0}, {0, 0, 0, 0}},
+          {{x + w, y, u1, v1}, {0, 0, 0, 0}},
+          {{x + w, y + h, u1, v0}, {0, 0, 0, 0}},
+      };
+      for (int k = 0; k < 6; k++)
+      {
+        std::memcpy(v[k].Color, rgba, 4);
+      }
+      std::memcpy(out, v, sizeof(v));
+      out += sizeof(v);
+    }
+  }
+
+#ifdef QUAD_KERNEL_HAS_SSE2
+  /**
+   * glyph 4개의 계산 결과를 mode 형식으로 기록
+   *
+   * 입력은 필드별 레지스터(SoA)이므로 4x4 전치(transpose)로 glyph 별 레지스터(AoS)로 바꾼 뒤,
+   * 정점마다 (위치, uv) 를 shuffle 로 조립해서 16 byte store 한 번 + 색상 4 byte 로 기록함.
+   * (AVX2 커널도 8개를 반씩 나눠서 이 함수로 기록함)
+   */
+  QUAD_KERNEL_INLINE void storeFour(__m128 x, __m128 y, __m128 w, __m128 h, __m128 u0, __m128 v0, __m128 u1, __m128 v1,
+                        const unsigned char rgba[4], TextBatchMode mode, unsigned char *&out)
+  {
+    _MM_TRANSPOSE4_PS(u0, v0, u1, v1); // -> glyph 별 (u0, v0, u1, v1)
+
+    if (mode == TEXT_BATCH_INSTANCED)
+    {
+      _MM_TRANSPOSE4_PS(x, y, w, h); // -> glyph 별 (x, y, w, h)
+      __m128 rects[4] = {x, y, w, h};
+      __m128 uvs[4] = {u0, v0, u1, v1};
+      for (int k = 0; k < 4; k++)
+      {
+        TextInstance *instance = reinterpret_cast<TextInstance *>(out);
+        _mm_storeu_ps(instance->Rect, rects[k]);
+        _mm_storeu_ps(instance->UV, uvs[k]);
+        std::memcpy(instance->Color, rgba, 4);
+        out += sizeof(TextInstance);
+      }
+      return;
+    }
+
+    // 정점 위치는 좌하단 (x0, y0) 와 우상단 (x1, y1) 모서리 조합이므로 덧셈을 미리 해두고 전치
+    __m128 x1 = _mm_add_ps(x, w);
+    __m128 y1 = _mm_add_ps(y, h);
+    _MM_TRANSPOSE4_PS(x, y, x1, y1); // -> glyph 별 (x0, y0, x1, y1)
+    __m128 corners[4] = {x, y, x1, y1};
+    __m128 uvs[4] = {u0, v0, u1, v1};
+    for (int k = 0; k < 4; k++)
+    {
+      const __m128 p = corners[k];
+      const __m128 t = uvs[k];
+
+      // _mm_shuffle_ps(a, b, _MM_SHUFFLE(d, c, b, a)) -> (a[a], a[b], b[c], b[d])
+      __m128 topLeft = _mm_shuffle_ps(p, t, _MM_SHUFFLE(1, 0, 3, 0));     // (x0, y1, u0, v0)
+      __m128 bottomLeft = _mm_shuffle_ps(p, t, _MM_SHUFFLE(3, 0, 1, 0));  // (x0, y0, u0, v1)
+      __m128 bottomRight = _mm_shuffle_ps(p, t, _MM_SHUFFLE(3, 2, 1, 2)); // (x1, y0, u1, v1)
+      __m128 topRight = _mm_shuffle_ps(p, t, _MM_SHUFFLE(1, 2, 3, 2));    // (x1, y1, u1, v0)
+
+      // appendTextQuad() 와 같은 정점 순서 (삼각형 2개)
+      const __m128 order[6] = {topLeft, bottomLeft, bottomRight, topLeft, bottomRight, topRight};
+      TextVertex *vertices = reinterpret_cast<TextVertex *>(out);
+      for (int j = 0; j < 6; j++)
+      {
+        _mm_storeu_ps(vertices[j].Vertex, order[j]);
+        std::memcpy(vertices[j].Color, rgba, 4);
+      }
+      out += 6 * sizeof(TextVertex);
+    }
+  }
+
+  /** SSE2 커널 : glyph 4개씩 처리 */
+  void generateSse2(const QuadSource &source, size_t first, size_t end, float scale, const unsigned char rgba[4],
+                    TextBatchMode mode, unsigned char *out)
+  {
+    const __m128 s = _mm_set1_ps(scale);
+    size_t i = first;
+    for (; i + 4 <= end; i += 4)
+    {
+      __m128 sizeY = _mm_loadu_ps(source.sizeY + i);
+      __m128 x = _mm_add_ps(_mm_loadu_ps(source.originX + i), _mm_mul_ps(_mm_loadu_ps(source.bearingX + i), s));
+      __m128 y = _mm_sub_ps(_mm_loadu_ps(source.originY + i), _mm_mul_ps(_mm_sub_ps(sizeY, _mm_loadu_ps(source.bearingY + i)), s));
+      __m128 w = _mm_mul_ps(_mm_loadu_ps(source.sizeX + i), s);
+      __m128 h = _mm_mul_ps(sizeY, s);
+      storeFour(x, y, w, h, _mm_loadu_ps(source.u0 + i), _mm_loadu_ps(source.v0 + i), _mm_loadu_ps(source.u1 + i),
+                _mm_loadu_ps(source.v1 + i), rgba, mode, out);
+    }
+    generateScalar(source, i, end, scale, rgba, mode, out);
+  }
+#endif
+
+#ifdef QUAD_KERNEL_HAS_AVX2
+  /** AVX2 커널 : glyph 8개씩 계산하고 4개씩 나눠서 기록 */
+  QUAD_KERNEL_TARGET_AVX2 void generateAvx2(const QuadSource &source, size_t first, size_t end, float scale,
+                                            const unsigned char rgba[4], TextBatchMode mode, unsigned char *out)
+  {
+    const __m256 s = _mm256_set1_ps(scale);
+    size_t i = first;
+    for (; i + 8 <= end; i += 8)
+    {
+      // FMA 는 반올림 결과가 달라지므로 사용하지 않고 곱셈과 덧셈을 나눠서 scalar 커널과 같은 결과를 만듦
+      __m256 sizeY = _mm256_loadu_ps(source.sizeY + i);
+      __m256 x = _mm256_add_ps(_mm256_loadu_ps(source.originX + i), _mm256_mul_ps(_mm256_loadu_ps(source.bearingX + i), s));
+      __m256 y = _mm256_sub_ps(_mm256_loadu_ps(source.originY + i),
+                               _mm256_mul_ps(_mm256_sub_ps(sizeY, _mm256_loadu_ps(source.bearingY + i)), s));
+      __m256 w = _mm256_mul_ps(_mm256_loadu_ps(source.sizeX + i), s);
+      __m256 h = _mm256_mul_ps(sizeY, s);
+      __m256 u0 = _mm256_loadu_ps(source.u0 + i);
+      __m256 v0 = _mm256_loadu_ps(source.v0 + i);
+      __m256 u1 = _mm256_loadu_ps(source.u1 + i);
+      __m256 v1 = _mm256_loadu_ps(source.v1 + i);
+
+      storeFour(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(w), _mm256_castps256_ps128(h),
+                _mm256_castps256_ps128(u0), _mm256_castps256_ps128(v0), _mm256_castps256_ps128(u1), _mm256_castps256_ps128(v1),
+                rgba, mode, out);
+      storeFour(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(w, 1), _mm256_extractf128_ps(h, 1),
+                _mm256_extractf128_ps(u0, 1), _mm256_extractf128_ps(v0, 1), _mm256_extractf128_ps(u1, 1), _mm256_extractf128_ps(v1, 1),
+                rgba, mode, out);
+    }
+    generateSse2(source, i, end, scale, rgba, mode, out);
+  }
+
+  // CPU 와 OS 가 AVX2 를 지원하는지 확인 (OS 가 AVX 레지스터 상태를 저장해주지 않으면 사용할 수 없음)
+  bool cpuSupportsAvx2()
+  {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+      return false;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+    {
+      return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+  }
+#endif
+}
+
+// 현재 CPU 에서 사용할 수 있는 가장 넓은 커널
+QuadKernel detectQuadKernel()
+{
+#ifdef QUAD_KERNEL_HAS_AVX2
+  if (cpuSupportsAvx2())
+  {
+    return QUAD_KERNEL_AVX2;
+  }
+#endif
+#ifdef QUAD_KERNEL_HAS_SSE2
+  return QUAD_KERNEL_SSE2;
+#else
+  return QUAD_KERNEL_SCALAR;
+#endif
+}
+
+// 커널 이름
+const char *quadKernelName(QuadKernel kernel)
+{
+  switch (kernel)
+  {
+  case QUAD_KERNEL_AVX2:
+    return "AVX2";
+  case QUAD_KERNEL_SSE2:
+    return "SSE2";
+  default:
+    return "scalar";
+  }
+}
+
+// 실행 중인 CPU 에 맞는 커널로 2D Quad 생성
+void generateQuads(const QuadSource &source, size_t first, size_t count, float scale, const glm::vec4 &color,
+                   TextBatchMode mode, void *out)
+{
+  // CPU 지원 여부는 처음 한 번만 확인 (C++11 부터 함수 내 static 변수 초기화는 스레드 안전함)
+  static const QuadKernel kernel = detectQuadKernel();
+  generateQuads(kernel, source, first, count, scale, color, mode, out);
+}
+
+// 커널을 직접 지정해서 2D Quad 생성
+void generateQuads(QuadKernel kernel, const QuadSource &source, size_t first, size_t count, float scale,
+                   const glm::vec4 &color, TextBatchMode mode, void *out)
+{
+  static const QuadKernel supported = detectQuadKernel();
+  if (kernel > supported)
+  {
+    kernel = supported;
+  }
+
+  const unsigned char rgba[4] = {toByte(color.x), toByte(color.y), toByte(color.z), toByte(color.w)};
+  unsigned char *bytes = static_cast<unsigned char *>(out);
+  size_t end = first + count;
+
+  switch (kernel)
+  {
+#ifdef QUAD_KERNEL_HAS_AVX2
+  case QUAD_KERNEL_AVX2:
+    generateAvx2(source, first, end, scale, rgba, mode, bytes);
+    break;
+#endif
+#ifdef QUAD_KERNEL_HAS_SSE2
+  case QUAD_KERNEL_SSE2:
+    generateSse2(source, first, end, scale, rgba, mode, bytes);
+    break;
+#endif
+  default:
+    generateScalar(source, first, end, scale, rgba, mode, bytes);
+    break;
+  }
+}
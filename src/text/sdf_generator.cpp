@@ -0,0 +1,139 @@
+#include "text/sdf_generator.hpp"
+
+#include <cmath> // std::sqrt
+
+namespace
+{
+  // 아직 거리가 계산되지 않은 픽셀을 나타내는 제곱 거리 (float 로 계산하면 q * q 와 더할 때 정밀도가 부족하므로 double 사용)
+  const double INF = 1e20;
+
+  /**
+   * 1차원 squared Euclidean distance transform (Felzenszwalb & Huttenlocher)
+   *
+   * grid 의 offset 부터 stride 간격으로 length 개 원소를 f(q) 로 보고,
+   * 각 q 에 대해 min_p((q - p)^2 + f(p)) 를 계산해서 덮어씀.
+   * 포물선 (q - p)^2 + f(p) 들의 lower envelope 을 한 번 구해두고 다시 한 번 순회하며 값을 읽으므로 O(length) 임.
+   */
+  void transform1D(std::vector<double> &grid, int offset, int stride, int length,
+                   std::vector<double> &f, std::vector<int> &v, std::vector<double> &z)
+  {
+    for (int q = 0; q < length; q++)
+    {
+      f[q] = grid[offset + q * stride];
+    }
+
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+    for (int q = 1; q < length; q++)
+    {
+      // 새 포물선 q 와 envelope 의 마지막 포물선 v[k] 의 교차점 s 를 계산하고, s 보다 뒤에서 시작하는 포물선들은 envelope 에서 제거
+      double s;
+      for (;;)
+      {
+        int p = v[k];
+        s = ((f[q] + static_cast<double>(q) * q) - (f[p] + static_cast<double>(p) * p)) / (2.0 * q - 2.0 * p);
+        if (s > z[k])
+        {
+          break;
+        }
+        k--;
+      }
+
+      k++;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = INF;
+    }
+
+    k = 0;
+    for (int q = 0; q < length; q++)
+    {
+      while (z[k + 1] < q)
+      {
+        k++;
+      }
+      double d = static_cast<double>(q - v[k]);
+      grid[offset + q * stride] = d * d + f[v[k]];
+    }
+  }
+
+  // 2차원 squared Euclidean distance transform (열 방향으로 한 번, 행 방향으로 한 번 1차원 변환을 적용)
+  void transform2D(std::vector<double> &grid, int width, int height)
+  {
+    int length = width > height ? width : height;
+    std::vector<double> f(length);
+    std::vector<int> v(length);
+    std::vector<double> z(length + 1);
+
+    for (int x = 0; x < width; x++)
+    {
+      transform1D(grid, x, width, height, f, v, z);
+    }
+    for (int y = 0; y < height; y++)
+    {
+      transform1D(grid, y * width, 1, width, f, v, z);
+    }
+  }
+}
+
+// 8-bit coverage bitmap 으로부터 signed distance field(SDF) bitmap 생성
+void generateSdf(const unsigned char *coverage, int width, int height, int pitch, int spread,
+                 std::vector<unsigned char> &sdf)
+{
+  int sdfWidth = width + 2 * spread;
+  int sdfHeight = height + 2 * spread;
+  size_t count = static_cast<size_t>(sdfWidth) * sdfHeight;
+
+  /**
+   * outside : 각 픽셀에서 가장 가까운 glyph 안쪽 픽셀까지의 제곱 거리 (glyph 바깥 픽셀에서 의미있음)
+   * inside  : 각 픽셀에서 가장 가까운 glyph 바깥 픽셀까지의 제곱 거리 (glyph 안쪽 픽셀에서 의미있음)
+   *
+   * 여백을 포함한 모든 픽셀은 처음에 glyph 바깥으로 초기화함.
+   */
+  std::vector<double> outside(count, INF);
+  std::vector<double> inside(count, 0.0);
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      double alpha = coverage[y * pitch + x] / 255.0;
+      size_t index = static_cast<size_t>(y + spread) * sdfWidth + (x + spread);
+
+      if (alpha >= 1.0)
+      {
+        outside[index] = 0.0;
+        inside[index] = INF;
+      }
+      else if (alpha > 0.0)
+      {
+        // 가장자리 픽셀은 coverage 0.5 를 외곽선으로 보고, coverage 와 0.5 의 차이를 외곽선까지의 sub-pixel 거리로 사용함
+        double edge = 0.5 - alpha;
+        outside[index] = edge > 0.0 ? edge * edge : 0.0;
+        inside[index] = edge < 0.0 ? edge * edge : 0.0;
+      }
+    }
+  }
+
+  transform2D(outside, sdfWidth, sdfHeight);
+  transform2D(inside, sdfWidth, sdfHeight);
+
+  // 바깥쪽이 양수인 signed distance 를 [0, 255] 범위로 양자화 (외곽선이 0.5 에 오도록 spread 거리를 0.5 로 정규화)
+  sdf.resize(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    double distance = std::sqrt(outside[i]) - std::sqrt(inside[i]);
+    double value = 0.5 - distance / (2.0 * spread);
+    if (value < 0.0)
+    {
+      value = 0.0;
+    }
+    else if (value > 1.0)
+    {
+      value = 1.0;
+    }
+    sdf[i] = static_cast<unsigned char>(value * 255.0 + 0.5);
+  }
+}
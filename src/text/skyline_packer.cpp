@@ -0,0 +1,157 @@
+#include "text/skyline_packer.hpp"
+
+#include <climits> // INT_MAX
+
+// SkylinePacker 클래스 생성자
+SkylinePacker::SkylinePacker(int width, int height)
+    : width(width), height(height), usedArea(0)
+{
+  reset();
+}
+
+// 모든 배치 정보를 지우고 빈 상태로 되돌림
+void SkylinePacker::reset()
+{
+  // 처음에는 아틀라스 전체 너비를 덮는 y = 0 짜리 선분 하나로 시작함.
+  skyline.clear();
+  Node root = {0, 0, width};
+  skyline.push_back(root);
+  usedArea = 0;
+}
+
+// 저장해 둔 skyline 상태로 되돌림
+void SkylinePacker::restore(const std::vector<Node> &nodes, long long area)
+{
+  if (nodes.empty())
+  {
+    reset();
+    return;
+  }
+
+  skyline = nodes;
+  usedArea = area;
+}
+
+// 주어진 크기의 사각형을 배치할 위치를 찾아 outX, outY 에 기록 (공간이 부족하면 false 반환)
+bool SkylinePacker::pack(int rectWidth, int rectHeight, int &outX, int &outY)
+{
+  int bestBottom = INT_MAX;
+  int bestWidth = INT_MAX;
+  int bestIndex = -1;
+  int bestX = 0;
+  int bestY = 0;
+
+  /**
+   * 모든 선분을 시작점으로 삼아 사각형을 놓아보고,
+   * 사각형 하단(= y + height)이 가장 위쪽에 오는 위치를 선택함.
+   *
+   * 하단 높이가 같은 후보가 여러 개라면, 더 좁은 선분 위에 놓는 쪽을 선택해서
+   * 넓은 빈 공간을 이후의 큰 glyph 를 위해 남겨둠.
+   */
+  for (size_t i = 0; i < skyline.size(); i++)
+  {
+    int y = fit(i, rectWidth, rectHeight);
+    if (y < 0)
+    {
+      continue;
+    }
+
+    int bottom = y + rectHeight;
+    if (bottom < bestBottom || (bottom == bestBottom && skyline[i].width < bestWidth))
+    {
+      bestBottom = bottom;
+      bestWidth = skyline[i].width;
+      bestIndex = static_cast<int>(i);
+      bestX = skyline[i].x;
+      bestY = y;
+    }
+  }
+
+  if (bestIndex < 0)
+  {
+    return false;
+  }
+
+  addLevel(static_cast<size_t>(bestIndex), bestX, bestY, rectWidth, rectHeight);
+  usedArea += static_cast<long long>(rectWidth) * rectHeight;
+
+  outX = bestX;
+  outY = bestY;
+  return true;
+}
+
+// index 번째 선분부터 사각형을 놓았을 때의 y 좌표 계산 (놓을 수 없으면 -1 반환)
+int SkylinePacker::fit(size_t index, int rectWidth, int rectHeight) const
+{
+  int x = skyline[index].x;
+  if (x + rectWidth > width)
+  {
+    return -1;
+  }
+
+  // 사각형 너비가 걸쳐지는 모든 선분들 중 가장 낮게 내려온 선분에 맞춰 y 좌표를 결정함.
+  int widthLeft = rectWidth;
+  int y = skyline[index].y;
+  while (widthLeft > 0)
+  {
+    // skyline 이 페이지 너비를 빈틈없이 덮고 있다면 범위를 벗어나지 않지만, 손상된 skyline 에서도 배열 밖을 읽지 않도록 확인
+    if (index >= skyline.size())
+    {
+      return -1;
+    }
+    if (skyline[index].y > y)
+    {
+      y = skyline[index].y;
+    }
+    if (y + rectHeight > height)
+    {
+      return -1;
+    }
+    widthLeft -= skyline[index].width;
+    index++;
+  }
+
+  return y;
+}
+
+// index 위치에 새 선분을 추가하고, 새 선분에 가려지는 기존 선분들을 잘라내거나 병합
+void SkylinePacker::addLevel(size_t index, int x, int y, int rectWidth, int rectHeight)
+{
+  Node node = {x, y + rectHeight, rectWidth};
+  skyline.insert(skyline.begin() + index, node);
+
+  // 새 선분 오른쪽에 있는 선분들 중 새 선분과 겹치는 부분을 잘라냄
+  for (size_t i = index + 1; i < skyline.size(); i++)
+  {
+    Node &prev = skyline[i - 1];
+    Node &cur = skyline[i];
+    int prevRight = prev.x + prev.width;
+    if (cur.x >= prevRight)
+    {
+      break;
+    }
+
+    int shrink = prevRight - cur.x;
+    cur.x += shrink;
+    cur.width -= shrink;
+    if (cur.width > 0)
+    {
+      break;
+    }
+
+    // 완전히 가려진 선분은 제거
+    skyline.erase(skyline.begin() + i);
+    i--;
+  }
+
+  // 같은 높이의 인접한 선분들은 하나로 병합하여 선분 개수를 최소화
+  for (size_t i = 0; i + 1 < skyline.size(); i++)
+  {
+    if (skyline[i].y == skyline[i + 1].y)
+    {
+      skyline[i].width += skyline[i + 1].width;
+      skyline.erase(skyline.begin() + i + 1);
+      i--;
+    }
+  }
+}
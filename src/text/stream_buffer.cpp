@@ -0,0 +1,216 @@
+#include "text/stream_buffer.hpp"
+
+#include <chrono> // std::chrono
+
+namespace
+{
+  const int MAX_REGIONS = 8;
+
+  // 1ms 단위로 fence 를 재확인하기 위한 timeout (nanosecond 단위)
+  const GLuint64 FENCE_TIMEOUT_NS = 1000000;
+}
+
+// StreamBuffer 클래스 생성자
+StreamBuffer::StreamBuffer(GLenum target, size_t regionSize, int regionCount, StreamBufferStrategy strategy)
+    : ID(0), target(target), regionSize(0), currentRegion(0), strategy(strategy), persistentPtr(NULL)
+{
+  if (regionCount < 1)
+    regionCount = 1;
+  if (regionCount > MAX_REGIONS)
+    regionCount = MAX_REGIONS;
+  this->regionCount = regionCount;
+
+  for (int i = 0; i < MAX_REGIONS; i++)
+  {
+    fences[i] = 0;
+  }
+
+  stats.lastFenceWaitMs = 0.0;
+  stats.totalFenceWaitMs = 0.0;
+  stats.stalls = 0;
+  stats.reallocations = 0;
+
+  /**
+   * persistent mapping 은 GL 4.4 core 또는 GL_ARB_buffer_storage 확장이 필요함.
+   * glad 로더는 GL 4.4 이상의 컨텍스트에서만 glBufferStorage 함수 포인터를 로드하므로,
+   * 4.4 미만에서 확장이 있으면 loadGLExtensions() 가 포인터를 채워둠. (포인터가 NULL 이면 확장도 없거나 로드되지 않은 것)
+   */
+  if (strategy == STREAM_BUFFER_PERSISTENT)
+  {
+    if (glBufferStorage == NULL)
+    {
+      this->strategy = STREAM_BUFFER_UNSYNCHRONIZED;
+    }
+  }
+
+  allocate(regionSize);
+}
+
+// StreamBuffer 클래스 소멸자
+StreamBuffer::~StreamBuffer()
+{
+  release();
+}
+
+// 주어진 region 크기로 GPU 버퍼 메모리 할당
+void StreamBuffer::allocate(size_t newRegionSize)
+{
+  regionSize = newRegionSize;
+  currentRegion = 0;
+  GLsizeiptr totalSize = static_cast<GLsizeiptr>(regionSize * regionCount);
+
+  glGenBuffers(1, &ID);
+  glBindBuffer(target, ID);
+
+  if (strategy == STREAM_BUFFER_PERSISTENT)
+  {
+    /**
+     * glBufferStorage() 로 할당한 버퍼는 크기를 바꿀 수 없는 대신(immutable storage),
+     * GL_MAP_PERSISTENT_BIT 로 매핑한 포인터를 draw call 중에도 계속 유지할 수 있음.
+     *
+     * GL_MAP_COHERENT_BIT 를 함께 지정하면 CPU 에서 기록한 내용이 별도의 flush 없이 GPU 에 보이게 됨.
+     */
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(target, totalSize, NULL, flags);
+    persistentPtr = static_cast<unsigned char *>(glMapBufferRange(target, 0, totalSize, flags));
+  }
+  else
+  {
+    glBufferData(target, totalSize, NULL, GL_STREAM_DRAW);
+  }
+
+  glBindBuffer(target, 0);
+}
+
+// 할당된 GPU 버퍼 메모리 및 fence 해제
+void StreamBuffer::release()
+{
+  for (int i = 0; i < MAX_REGIONS; i++)
+  {
+    if (fences[i])
+    {
+      glDeleteSync(fences[i]);
+      fences[i] = 0;
+    }
+  }
+
+  if (persistentPtr)
+  {
+    glBindBuffer(target, ID);
+    glUnmapBuffer(target);
+    glBindBuffer(target, 0);
+    persistentPtr = NULL;
+  }
+
+  // 아직 GPU 가 사용 중인 버퍼를 삭제하더라도, 드라이버가 사용이 끝날 때까지 실제 해제를 미뤄줌.
+  if (ID)
+  {
+    glDeleteBuffers(1, &ID);
+    ID = 0;
+  }
+}
+
+// 주어진 region 의 fence 가 signal 될 때까지 대기
+void StreamBuffer::waitRegion(int region)
+{
+  stats.lastFenceWaitMs = 0.0;
+
+  GLsync sync = fences[region];
+  if (!sync)
+  {
+    return;
+  }
+
+  // 대부분의 경우 GPU 는 이미 해당 region 을 다 읽은 상태이므로, 먼저 기다리지 않고 상태만 확인함.
+  GLenum result = glClientWaitSync(sync, 0, 0);
+  if (result == GL_TIMEOUT_EXPIRED)
+  {
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+    // 아직 GPU 가 읽는 중이라면 command 를 flush 해서 fence 가 반드시 처리되도록 한 뒤 signal 될 때까지 대기
+    do
+    {
+      result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NS);
+    } while (result == GL_TIMEOUT_EXPIRED);
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+    stats.lastFenceWaitMs = elapsed.count();
+    stats.totalFenceWaitMs += elapsed.count();
+    stats.stalls++;
+  }
+
+  glDeleteSync(sync);
+  fences[region] = 0;
+}
+
+// 현재 region 에서 size byte 를 기록할 수 있는 포인터를 반환
+void *StreamBuffer::map(size_t size, size_t &offset)
+{
+  /**
+   * 한 프레임 데이터가 region 크기를 넘어서면 2배씩 늘린 크기로 버퍼를 재할당함.
+   * (immutable storage 는 크기를 바꿀 수 없으므로 버퍼 객체 자체를 새로 생성)
+   */
+  if (size > regionSize)
+  {
+    size_t newRegionSize = regionSize > 0 ? regionSize : 1;
+    while (newRegionSize < size)
+    {
+      newRegionSize *= 2;
+    }
+    release();
+    allocate(newRegionSize);
+    stats.reallocations++;
+  }
+
+  if (strategy == STREAM_BUFFER_ORPHAN)
+  {
+    /**
+     * orphaning : 같은 크기로 glBufferData(NULL) 를 다시 호출하면 드라이버가 새 메모리를 내주고
+     * 이전 메모리는 GPU 가 다 읽은 뒤에 해제하므로, fence 없이도 stall 이 발생하지 않음.
+     */
+    offset = 0;
+    glBindBuffer(target, ID);
+    glBufferData(target, static_cast<GLsizeiptr>(regionSize * regionCount), NULL, GL_STREAM_DRAW);
+    return glMapBufferRange(target, 0, static_cast<GLsizeiptr>(size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  }
+
+  // ring 을 한 바퀴 돌아 다시 사용하게 된 region 이라면, 이전에 걸어둔 fence 로 GPU 가 다 읽었는지 확인
+  waitRegion(currentRegion);
+  offset = regionSize * currentRegion;
+
+  if (strategy == STREAM_BUFFER_PERSISTENT)
+  {
+    return persistentPtr + offset;
+  }
+
+  // fence 로 이미 동기화했으므로 드라이버의 암묵적 동기화는 GL_MAP_UNSYNCHRONIZED_BIT 로 끔.
+  glBindBuffer(target, ID);
+  return glMapBufferRange(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size),
+                          GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+}
+
+// map() 으로 기록한 데이터를 GPU 에 반영
+void StreamBuffer::unmap()
+{
+  // persistent mapping 은 coherent 로 매핑되어 있으므로 별도 처리가 필요 없음.
+  if (strategy == STREAM_BUFFER_PERSISTENT)
+  {
+    return;
+  }
+
+  glBindBuffer(target, ID);
+  glUnmapBuffer(target);
+  glBindBuffer(target, 0);
+}
+
+// 현재 region 을 사용하는 draw call 이후에 호출하여 fence 를 걸고 다음 region 으로 넘어감
+void StreamBuffer::fence()
+{
+  if (strategy == STREAM_BUFFER_ORPHAN)
+  {
+    return;
+  }
+
+  fences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  currentRegion = (currentRegion + 1) % regionCount;
+}
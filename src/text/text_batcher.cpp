@@ -0,0 +1,529 @@
+#include "text/text_batcher.hpp"
+#include "text/text_layout.hpp"
+#include "text/text_mesh.hpp"
+
+#include <algorithm> // std::sort
+#include <cstring>   // std::memcpy
+
+namespace
+{
+  // Bucket 정렬 시 Bucket 배열 대신 index 배열을 정렬하기 위한 비교 함수 객체
+  template <typename BucketT>
+  struct BucketOrder
+  {
+    const std::vector<BucketT> *buckets;
+    bool operator()(size_t a, size_t b) const { return (*buckets)[a].key < (*buckets)[b].key; }
+  };
+
+  // [0, 1] 범위의 색상값을 8-bit 정수로 변환
+  unsigned char toByte(float v)
+  {
+    if (v <= 0.0f)
+      return 0;
+    if (v >= 1.0f)
+      return 255;
+    return static_cast<unsigned char>(v * 255.0f + 0.5f);
+  }
+}
+
+// TextBatcher 클래스 생성자
+TextBatcher::TextBatcher(ShaderLibrary &shaders, const GLchar *vertexPath, const GLchar *fragmentPath,
+                         TextBatchMode mode, StreamBufferStrategy strategy)
+    : mode(mode), shaders(shaders), vertexPath(vertexPath), fragmentPath(fragmentPath),
+      projection(1.0f), outlineColor(0.0f, 0.0f, 0.0f, 1.0f), outlineWidth(0.1f),
+      shadowColor(0.0f, 0.0f, 0.0f, 0.5f), shadowOffset(2.0f, -2.0f),
+      // 우선 region 당 glyph 256 개 분량을 예약해두고, 한 프레임의 데이터가 더 커지면 StreamBuffer 내부에서 재할당함.
+      stream(GL_ARRAY_BUFFER, (mode == TEXT_BATCH_INSTANCED ? sizeof(TextInstance) : sizeof(TextVertex) * 6) * 256, 3, strategy),
+      quadVBO(0), lastBucket(0), pendingRebuilds(0)
+{
+  stats.glyphs = 0;
+  stats.drawCalls = 0;
+  stats.uploadedBytes = 0;
+  stats.fenceWaitMs = 0.0;
+  stats.meshes = 0;
+  stats.meshRebuilds = 0;
+
+  for (unsigned int i = 0; i < TEXT_FEATURE_COMBINATIONS; i++)
+  {
+    variants[i].shader = NULL;
+  }
+
+  /** 2D Quad 의 VAO 객체 생성 및 설정 (glyph 데이터를 담는 VBO 는 StreamBuffer 가 관리) */
+  glGenVertexArrays(1, &VAO);
+  glBindVertexArray(VAO);
+
+  if (mode == TEXT_BATCH_INSTANCED)
+  {
+    /**
+     * 모든 glyph 가 공유하는 정적 unit quad (0 ~ 1 범위의 모서리 좌표)
+     *
+     * GL_TRIANGLE_STRIP 으로 그리면 정점 4개만으로 2D Quad 를 구성할 수 있으며,
+     * 기존 정점 배열과 동일하게 반시계 방향(= front face)으로 감기도록 좌상단부터 나열함.
+     */
+    float corners[4][2] = {
+        {0.0f, 1.0f},
+        {0.0f, 0.0f},
+        {1.0f, 1.0f},
+        {1.0f, 0.0f},
+    };
+    glGenBuffers(1, &quadVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void *)0);
+
+    // per-instance 데이터 : glVertexAttribDivisor(index, 1) 로 지정하면 정점이 아닌 인스턴스(= glyph)마다 다음 데이터로 넘어감.
+    glEnableVertexAttribArray(1); // 2D Quad 위치(xy) + 크기(zw)
+    glEnableVertexAttribArray(2); // 아틀라스 uv 영역
+    glEnableVertexAttribArray(3); // 8-bit RGBA 색상
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribDivisor(3, 1);
+  }
+  else
+  {
+    glEnableVertexAttribArray(0); // position(xy) + uv(zw)
+    glEnableVertexAttribArray(1); // 8-bit RGBA 색상
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindVertexArray(0);
+}
+
+// TextBatcher 클래스 소멸자
+TextBatcher::~TextBatcher()
+{
+  if (quadVBO)
+  {
+    glDeleteBuffers(1, &quadVBO);
+  }
+  glDeleteVertexArrays(1, &VAO);
+}
+
+// 버퍼 객체 내의 주어진 위치를 가리키도록 glyph 데이터 vertex attribute 를 지정 (VAO 가 바인딩된 상태에서 호출)
+void TextBatcher::bindAttributes(unsigned int buffer, size_t offset)
+{
+  /**
+   * StreamBuffer 는 매 프레임 다른 region 에 데이터를 기록하고, 재할당 시에는 버퍼 객체 자체가 바뀌므로
+   * vertex attribute 는 생성자에서 한 번만 지정하지 않고 draw call 직전에 현재 위치를 가리키도록 다시 지정함.
+   * (TextMesh 를 그릴 때는 TextMesh 의 버퍼 객체를 가리키도록 지정)
+   */
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+  if (mode == TEXT_BATCH_INSTANCED)
+  {
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(TextInstance), (void *)(offset + offsetof(TextInstance, Rect)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(TextInstance), (void *)(offset + offsetof(TextInstance, UV)));
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextInstance), (void *)(offset + offsetof(TextInstance, Color)));
+  }
+  else
+  {
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)(offset + offsetof(TextVertex, Vertex)));
+    // normalized 를 GL_TRUE 로 지정해서 쉐이더에서는 [0, 1] 범위의 vec4 로 받음.
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TextVertex), (void *)(offset + offsetof(TextVertex, Color)));
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// 주어진 batch key 에 대응되는 Bucket 을 찾거나 새로 만듦
+TextBatcher::Bucket &TextBatcher::findBucket(const TextBatchKey &key)
+{
+  if (lastBucket < buckets.size() && buckets[lastBucket].key == key)
+  {
+    return buckets[lastBucket];
+  }
+
+  // batch key 의 종류는 (쉐이더 x 아틀라스 페이지 x blending 상태) 조합이라 많지 않으므로 선형 탐색으로 충분함.
+  for (size_t i = 0; i < buckets.size(); i++)
+  {
+    if (buckets[i].key == key)
+    {
+      lastBucket = i;
+      return buckets[i];
+    }
+  }
+
+  Bucket bucket;
+  bucket.key = key;
+  buckets.push_back(bucket);
+  lastBucket = buckets.size() - 1;
+  return buckets.back();
+}
+
+// glyph 2D Quad 하나를 mode 에 맞는 형태로 정점 배열에 추가
+void appendTextQuad(TextBatchMode mode, float x, float y, float w, float h, const glm::vec4 &uv, const glm::vec4 &color,
+                    std::vector<TextVertex> &vertices, std::vector<TextInstance> &instances)
+{
+  unsigned char rgba[4] = {toByte(color.x), toByte(color.y), toByte(color.z), toByte(color.w)};
+
+  if (mode == TEXT_BATCH_INSTANCED)
+  {
+    // 인스턴싱 모드에서는 정점을 펼치지 않고 glyph 당 TextInstance 하나만 기록함.
+    TextInstance instance = {{x, y, w, h}, {uv.x, uv.y, uv.z, uv.w}, {rgba[0], rgba[1], rgba[2], rgba[3]}};
+    instances.push_back(instance);
+    return;
+  }
+
+  TextVertex v[6] = {
+      // position      // uv
+      {{x, y + h, uv.x, uv.y}, {0, 0, 0, 0}},
+      {{x, y, uv.x, uv.w}, {0, 0, 0, 0}},
+      {{x + w, y, uv.z, uv.w}, {0, 0, 0, 0}},
+      {{x, y + h, uv.x, uv.y}, {0, 0, 0, 0}},
+      {{x + w, y, uv.z, uv.w}, {0, 0, 0, 0}},
+      {{x + w, y + h, uv.z, uv.y}, {0, 0, 0, 0}},
+  };
+
+  for (int i = 0; i < 6; i++)
+  {
+    std::memcpy(v[i].Color, rgba, sizeof(rgba));
+  }
+
+  vertices.insert(vertices.end(), v, v + 6);
+}
+
+// glyph 2D Quad 하나를 주어진 batch key 의 정점 배열에 추가
+void TextBatcher::submitQuad(const TextBatchKey &key, float x, float y, float w, float h, const glm::vec4 &uv, const glm::vec4 &color)
+{
+  // 같은 permutation 으로 그려지는 기능 조합끼리는 같은 Bucket 에 모이도록 정리된 플래그로 batch key 를 만듦
+  TextBatchKey normalized = key;
+  normalized.features = normalizeFeatures(key.features);
+
+  Bucket &bucket = findBucket(normalized);
+  appendTextQuad(mode, x, y, w, h, uv, color, bucket.vertices, bucket.instances);
+}
+
+// TextLayout 의 positioned glyph 들을 2D Quad 로 제출
+bool TextBatcher::submitLayout(const TextLayout &layout, GlyphCache &glyphs, unsigned int features, const glm::vec4 &color)
+{
+  if (layout.getEvictions() != glyphs.getStats().evictions)
+  {
+    return false;
+  }
+
+  TextBatchKey key = {normalizeFeatures(features), 0, TEXT_BLEND_ALPHA};
+  size_t count = layout.getGlyphCount();
+  size_t first = 0;
+  while (first < count)
+  {
+    // 같은 아틀라스 페이지가 이어지는 구간은 같은 batch key 이므로 SIMD 커널로 한꺼번에 bucket 에 기록
+    size_t end = layout.getPageRunEnd(first);
+    unsigned int page = layout.getPage(first);
+    key.texture = glyphs.getPageTexture(page);
+    glyphs.touchPage(page);
+
+    Bucket &bucket = findBucket(key);
+    layout.appendQuads(first, end - first, color, mode, bucket.vertices, bucket.instances);
+    first = end;
+  }
+  return true;
+}
+
+// 미리 만들어 둔 정점 데이터를 batch key 의 정점 배열에 이어붙임
+void TextBatcher::submitVertices(const TextBatchKey &key, const TextVertex *vertices, size_t count)
+{
+  if (mode != TEXT_BATCH_VERTICES || count == 0)
+  {
+    return;
+  }
+
+  TextBatchKey normalized = key;
+  normalized.features = normalizeFeatures(key.features);
+
+  Bucket &bucket = findBucket(normalized);
+  bucket.vertices.insert(bucket.vertices.end(), vertices, vertices + count);
+}
+
+// 미리 만들어 둔 per-instance 데이터를 batch key 의 배열에 이어붙임
+void TextBatcher::submitInstances(const TextBatchKey &key, const TextInstance *instances, size_t count)
+{
+  if (mode != TEXT_BATCH_INSTANCED || count == 0)
+  {
+    return;
+  }
+
+  TextBatchKey normalized = key;
+  normalized.features = normalizeFeatures(key.features);
+
+  Bucket &bucket = findBucket(normalized);
+  bucket.instances.insert(bucket.instances.end(), instances, instances + count);
+}
+
+// 이번 프레임에 TextMesh 를 그리도록 제출
+void TextBatcher::submitMesh(TextMesh &mesh)
+{
+  if (mesh.update(mode))
+  {
+    pendingRebuilds++;
+  }
+  mesh.touchPages();
+  meshes.push_back(&mesh);
+}
+
+// 효과 플래그를 실제로 적용 가능한 조합으로 정리
+unsigned int TextBatcher::normalizeFeatures(unsigned int features)
+{
+  features &= TEXT_FEATURE_COMBINATIONS - 1;
+
+  // MSDF 아틀라스를 SDF 로 샘플링할 일은 없으므로 둘 다 지정되면 MSDF 만 남김
+  if (features & TEXT_FEATURE_MSDF)
+  {
+    features &= ~static_cast<unsigned int>(TEXT_FEATURE_SDF);
+  }
+
+  // bitmap 아틀라스에는 거리값이 없어서 테두리와 그림자를 계산할 수 없으므로, 불필요한 permutation 이 생기지 않도록 제거
+  if (!(features & (TEXT_FEATURE_SDF | TEXT_FEATURE_MSDF)))
+  {
+    features = TEXT_FEATURE_NONE;
+  }
+  return features;
+}
+
+// 기능 플래그 조합에 대응되는 define 목록
+std::vector<std::string> TextBatcher::featureDefines(unsigned int features) const
+{
+  std::vector<std::string> defines;
+  if (mode == TEXT_BATCH_INSTANCED)
+    defines.push_back("INSTANCED");
+  if (features & TEXT_FEATURE_SDF)
+    defines.push_back("SDF");
+  if (features & TEXT_FEATURE_MSDF)
+    defines.push_back("MSDF");
+  if (features & TEXT_FEATURE_OUTLINE)
+    defines.push_back("OUTLINE");
+  if (features & TEXT_FEATURE_SHADOW)
+    defines.push_back("SHADOW");
+  return defines;
+}
+
+// 기능 플래그 조합의 쉐이더 permutation 을 미리 컴파일 제출
+void TextBatcher::preloadVariant(unsigned int features)
+{
+  shaders.addVariant(vertexPath.c_str(), fragmentPath.c_str(), featureDefines(normalizeFeatures(features)));
+}
+
+// 기능 플래그 조합의 쉐이더 permutation 을 찾아서 uniform 을 적용하고 활성화
+void TextBatcher::useVariant(unsigned int features)
+{
+  Variant &variant = variants[normalizeFeatures(features)];
+  if (!variant.shader)
+  {
+    // 처음 사용되는 조합만 permutation 을 찾고 uniform 핸들을 조회해 둠 (preloadVariant() 로 제출되지 않았다면 여기서 컴파일)
+    variant.shader = shaders.getVariant(vertexPath.c_str(), fragmentPath.c_str(), featureDefines(normalizeFeatures(features)));
+    variant.projection = variant.shader->getUniform("projection");
+    variant.text = variant.shader->getUniform("text");
+    variant.outlineColor = variant.shader->getUniform("outlineColor");
+    variant.outlineWidth = variant.shader->getUniform("outlineWidth");
+    variant.shadowColor = variant.shader->getUniform("shadowColor");
+    variant.shadowOffset = variant.shader->getUniform("shadowOffset");
+  }
+
+  // 해당 기능이 없는 permutation 에서는 uniform 핸들이 -1 이므로 glUniform*() 이 조용히 무시됨
+  variant.shader->use();
+  variant.shader->setMat4(variant.projection, projection);
+  variant.shader->setInt(variant.text, 0);
+  variant.shader->setVec4(variant.outlineColor, outlineColor);
+  variant.shader->setFloat(variant.outlineWidth, outlineWidth);
+  variant.shader->setVec4(variant.shadowColor, shadowColor);
+  variant.shader->setVec2(variant.shadowOffset, shadowOffset);
+}
+
+// batch key 의 blending 상태 적용
+void TextBatcher::applyBlend(TextBlendMode blend)
+{
+  if (blend == TEXT_BLEND_ADDITIVE)
+  {
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+  }
+  else
+  {
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  }
+}
+
+// 지금까지 제출된 glyph 들을 batch key 별로 묶어서 렌더링하고, 다음 프레임을 위해 비움
+void TextBatcher::flush()
+{
+  stats.glyphs = 0;
+  stats.drawCalls = 0;
+  stats.uploadedBytes = 0;
+  stats.fenceWaitMs = 0.0;
+  stats.meshes = 0;
+  stats.meshRebuilds = pendingRebuilds;
+  pendingRebuilds = 0;
+
+  /** 비어있지 않은 Bucket 들만 골라서 batch key 순으로 정렬 */
+  order.clear();
+  size_t bytes = 0;
+  for (size_t i = 0; i < buckets.size(); i++)
+  {
+    if (buckets[i].glyphCount() > 0)
+    {
+      order.push_back(i);
+      bytes += buckets[i].vertices.size() * sizeof(TextVertex) + buckets[i].instances.size() * sizeof(TextInstance);
+    }
+  }
+
+  draws.clear();
+
+  BucketOrder<Bucket> compare = {&buckets};
+  std::sort(order.begin(), order.end(), compare);
+
+  /**
+   * 모든 Bucket 의 정점(또는 per-instance) 데이터를 StreamBuffer 의 이번 프레임 region 에 정렬된 순서대로 이어붙여서 기록
+   *
+   * persistent mapping 을 지원하는 환경에서는 GPU 가 직접 읽는 메모리에 바로 memcpy 하게 되며,
+   * 이전 프레임들이 아직 사용 중인 region 은 건드리지 않으므로 glBufferSubData() 와 같은 암묵적 동기화가 발생하지 않음.
+   */
+  size_t baseOffset = 0;
+  unsigned char *dst = order.empty() ? NULL : static_cast<unsigned char *>(stream.map(bytes, baseOffset));
+  stats.fenceWaitMs = order.empty() ? 0.0 : stream.getStats().lastFenceWaitMs;
+  bool uploaded = dst != NULL;
+  if (dst)
+  {
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      const Bucket &bucket = buckets[order[i]];
+      if (mode == TEXT_BATCH_INSTANCED)
+      {
+        size_t size = bucket.instances.size() * sizeof(TextInstance);
+        std::memcpy(dst, &bucket.instances[0], size);
+        dst += size;
+      }
+      else
+      {
+        size_t size = bucket.vertices.size() * sizeof(TextVertex);
+        std::memcpy(dst, &bucket.vertices[0], size);
+        dst += size;
+      }
+    }
+    stream.unmap();
+  }
+
+  /** 업로드된 Bucket 마다 이번 region 의 구간을 draw 목록에 추가 */
+  GLint first = 0;
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    Bucket &bucket = buckets[order[i]];
+    GLsizei count = static_cast<GLsizei>(mode == TEXT_BATCH_INSTANCED ? bucket.instances.size() : bucket.vertices.size());
+    if (uploaded)
+    {
+      Draw draw = {bucket.key, stream.ID, baseOffset, first, count, draws.size()};
+      draws.push_back(draw);
+    }
+
+    first += count;
+    stats.glyphs += static_cast<unsigned int>(bucket.glyphCount());
+
+    // clear() 는 capacity 를 유지하므로 다음 프레임에서 메모리 재할당이 일어나지 않음.
+    bucket.vertices.clear();
+    bucket.instances.clear();
+  }
+  stats.uploadedBytes = uploaded ? static_cast<unsigned int>(bytes) : 0;
+
+  /**
+   * TextMesh 는 submitMesh() 시점에 이미 layout 과 업로드가 끝나 있으므로, segment(batch key 가 같은 glyph 구간)를 draw 목록에 추가하기만 함.
+   * 제출 순서대로 추가하므로 같은 batch key 안에서는 Bucket -> 제출된 순서의 TextMesh 들 순서가 됨.
+   */
+  for (size_t i = 0; i < meshes.size(); i++)
+  {
+    const TextMesh &mesh = *meshes[i];
+    const std::vector<TextMesh::Segment> &segments = mesh.getSegments();
+    for (size_t j = 0; j < segments.size(); j++)
+    {
+      const TextMesh::Segment &segment = segments[j];
+      Draw draw = {segment.key, mesh.getBuffer(), 0, segment.first, segment.count, draws.size()};
+      draws.push_back(draw);
+      stats.glyphs += static_cast<unsigned int>(mode == TEXT_BATCH_INSTANCED ? segment.count : segment.count / 6);
+    }
+    stats.meshes++;
+  }
+  meshes.clear();
+
+  drawSorted();
+
+  // 이번 region 을 읽는 draw call 들 뒤에 fence 를 걸고, 다음 프레임은 다음 region 에 기록하도록 넘김
+  if (uploaded)
+  {
+    stream.fence();
+  }
+}
+
+// draw 목록을 batch key 순으로 정렬해서 렌더링 (같은 버퍼에서 이어지는 구간은 한 번의 draw call 로 합침)
+void TextBatcher::drawSorted()
+{
+  if (draws.empty())
+  {
+    return;
+  }
+
+  // sequence 가 마지막 비교 기준이므로 std::sort 로도 같은 batch key 안의 추가 순서가 유지됨 (std::stable_sort 와 달리 임시 버퍼 할당 없음)
+  std::sort(draws.begin(), draws.end());
+
+  /** 정렬된 순서대로 batch key 가 바뀔 때만 GL 상태를 변경하면서 draw call */
+  glActiveTexture(GL_TEXTURE0);
+  glBindVertexArray(VAO);
+
+  unsigned int currentFeatures = 0;
+  unsigned int currentTexture = 0;
+  TextBlendMode currentBlend = TEXT_BLEND_ALPHA;
+  unsigned int currentBuffer = 0;
+  size_t currentOffset = 0;
+  for (size_t i = 0; i < draws.size();)
+  {
+    // batch key 와 버퍼가 같고 바로 이어지는 구간들은 하나로 합침
+    Draw draw = draws[i];
+    for (i++; i < draws.size(); i++)
+    {
+      const Draw &next = draws[i];
+      if (!(next.key == draw.key) || next.buffer != draw.buffer || next.offset != draw.offset ||
+          next.first != draw.first + draw.count)
+      {
+        break;
+      }
+      draw.count += next.count;
+    }
+
+    bool initial = stats.drawCalls == 0;
+    if (initial || draw.key.features != currentFeatures)
+    {
+      currentFeatures = draw.key.features;
+      useVariant(currentFeatures);
+    }
+    if (initial || draw.key.blend != currentBlend)
+    {
+      currentBlend = draw.key.blend;
+      applyBlend(currentBlend);
+    }
+    if (initial || draw.key.texture != currentTexture)
+    {
+      currentTexture = draw.key.texture;
+      glBindTexture(GL_TEXTURE_2D, currentTexture);
+    }
+
+    if (mode == TEXT_BATCH_INSTANCED)
+    {
+      /**
+       * per-instance attribute 는 baseinstance 를 지정할 수 없는 GL 3.3 에서도 동작하도록
+       * draw call 마다 attribute 시작 위치를 구간의 offset 으로 옮겨서 지정함.
+       */
+      bindAttributes(draw.buffer, draw.offset + static_cast<size_t>(draw.first) * sizeof(TextInstance));
+      glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, draw.count);
+    }
+    else
+    {
+      if (initial || draw.buffer != currentBuffer || draw.offset != currentOffset)
+      {
+        currentBuffer = draw.buffer;
+        currentOffset = draw.offset;
+        bindAttributes(currentBuffer, currentOffset);
+      }
+      glDrawArrays(GL_TRIANGLES, draw.first, draw.count);
+    }
+    stats.drawCalls++;
+  }
+
+  // 다른 렌더링 코드에 영향을 주지 않도록 기본 blending 상태로 복구 및 바인딩 해제
+  applyBlend(TEXT_BLEND_ALPHA);
+  glBindVertexArray(0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
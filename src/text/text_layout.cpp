@@ -0,0 +1,222 @@
+#include "text/text_layout.hpp"
+#include "text/utf8.hpp"
+
+#include <algorithm> // std::find, std::min, std::max
+
+// TextLayout 클래스 생성자
+TextLayout::TextLayout()
+    : scale(1.0f), penX(0.0f), bounds(0.0f), evictions(0)
+{
+}
+
+// shaping 된 glyph run 을 layout
+void TextLayout::layout(const ShapedRun &run, const GlyphCache &glyphs, float x, float y, float scale)
+{
+  begin(glyphs, x, y, scale);
+
+  const GlyphMetrics &metrics = glyphs.getMetrics();
+  for (size_t i = 0; i < run.glyphs.size(); i++)
+  {
+    const ShapedGlyph &shaped = run.glyphs[i];
+    unsigned int key = glyphIndexKey(shaped.glyphIndex);
+    unsigned int glyph = glyphs.peek(key);
+    if (glyph == GlyphMetrics::NO_GLYPH)
+    {
+      addMissing(key);
+    }
+    else
+    {
+      // pen 위치에서 shaping 결과의 offset(1/64 px 단위)만큼 떨어진 곳이 glyph 원점
+      place(key, metrics, glyph, penX + shaped.xOffset / 64.0f * scale, y + shaped.yOffset / 64.0f * scale);
+    }
+    penX += shaped.xAdvance / 64.0f * scale;
+  }
+}
+
+// UTF-8 문자열을 codepoint 단위로 layout
+void TextLayout::layout(const char *text, size_t length, const GlyphCache &glyphs, float x, float y, float scale)
+{
+  begin(glyphs, x, y, scale);
+
+  const GlyphMetrics &metrics = glyphs.getMetrics();
+  const char *c = text;
+  const char *end = text + length;
+  const char *ascii = skipAscii(text, end); // [text, ascii) 는 ASCII byte 만 있는 구간 (UI 문자열은 대부분 끝까지 ASCII)
+  unsigned int previous = 0;                // 직전 문자의 codepoint (kerning 조회용, 첫 문자는 0 이라서 kerning 이 없음)
+  while (c != end)
+  {
+    // 앞부분의 ASCII 구간은 디코딩 없이 byte 를 그대로 codepoint 로 사용하고, 그 뒤부터는 UTF-8 디코딩
+    unsigned int codepoint = c < ascii ? static_cast<unsigned char>(*c++) : decodeUtf8(c, end);
+
+    unsigned int glyph = glyphs.peek(codepoint);
+    if (glyph == GlyphMetrics::NO_GLYPH)
+    {
+      addMissing(codepoint);
+      continue;
+    }
+
+    // 직전 문자와의 kerning 만큼 pen 위치 보정 (미리 추출해둔 테이블에서 한 번만 조회)
+    penX += glyphs.getKerning(previous, codepoint) * scale;
+    previous = codepoint;
+
+    place(codepoint, metrics, glyph, penX, y);
+
+    /**
+     * 현재 glyph 원점에서 Advance 만큼 떨어진 다음 glyph 원점의 x 좌표값 계산
+     *
+     * FreeType 라이브러리의 Advance 값은 1/64 px 단위로 계산되기 때문에 1px 단위로 변환해서 사용해야 하며,
+     * >> 6, 즉, right bit shift 연산을 6번 수행하면 1/2 를 6제곱(= 1/64)하는 것과 동일함.
+     */
+    penX += (metrics.getAdvance(glyph) >> 6) * scale;
+  }
+}
+
+// layout 결과 비우기
+void TextLayout::clear()
+{
+  begin(0.0f, 0.0f, 1.0f);
+}
+
+// i 번째 glyph 의 2D Quad
+PositionedGlyph TextLayout::getGlyph(size_t i) const
+{
+  PositionedGlyph glyph;
+  glyph.key = keys[i];
+  glyph.page = pages[i];
+  glyph.x = originX[i] + bearingX[i] * scale;
+  glyph.y = originY[i] - (sizeY[i] - bearingY[i]) * scale;
+  glyph.w = sizeX[i] * scale;
+  glyph.h = sizeY[i] * scale;
+  glyph.uv = glm::vec4(u0[i], v0[i], u1[i], v1[i]);
+  return glyph;
+}
+
+// first 번째 glyph 부터 같은 아틀라스 페이지가 이어지는 구간의 끝
+size_t TextLayout::getPageRunEnd(size_t first) const
+{
+  size_t end = first + 1;
+  while (end < pages.size() && pages[end] == pages[first])
+  {
+    end++;
+  }
+  return end;
+}
+
+// [first, first + count) 번째 glyph 들의 2D Quad 를 정점 배열 끝에 추가
+void TextLayout::appendQuads(size_t first, size_t count, const glm::vec4 &color, TextBatchMode mode,
+                             std::vector<TextVertex> &vertices, std::vector<TextInstance> &instances) const
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  // 배열을 한 번에 늘리고 (capacity 가 충분하면 재할당 없음) 늘어난 영역에 커널이 바로 기록
+  void *out;
+  if (mode == TEXT_BATCH_INSTANCED)
+  {
+    size_t offset = instances.size();
+    instances.resize(offset + count);
+    out = &instances[offset];
+  }
+  else
+  {
+    size_t offset = vertices.size();
+    vertices.resize(offset + count * 6);
+    out = &vertices[offset];
+  }
+  generateQuads(getQuadSource(), first, count, scale, color, mode, out);
+}
+
+// SIMD 커널 입력
+QuadSource TextLayout::getQuadSource() const
+{
+  QuadSource source = {originX.data(), originY.data(), bearingX.data(), bearingY.data(), sizeX.data(), sizeY.data(),
+                       u0.data(), v0.data(), u1.data(), v1.data()};
+  return source;
+}
+
+// layout 시작 시 결과 초기화 (clear() 는 capacity 를 유지하므로 재할당 없음)
+void TextLayout::begin(const GlyphCache &glyphs, float x, float y, float scale)
+{
+  begin(x, y, scale);
+  evictions = glyphs.getStats().evictions;
+}
+
+// 결과 배열 비우기
+void TextLayout::begin(float x, float y, float scale)
+{
+  keys.clear();
+  pages.clear();
+  originX.clear();
+  originY.clear();
+  bearingX.clear();
+  bearingY.clear();
+  sizeX.clear();
+  sizeY.clear();
+  u0.clear();
+  v0.clear();
+  u1.clear();
+  v1.clear();
+  missing.clear();
+  this->scale = scale;
+  penX = x;
+  bounds = glm::vec4(x, y, x, y);
+}
+
+// pen 원점 (originX, originY) 에 glyph 추가
+void TextLayout::place(unsigned int key, const GlyphMetrics &metrics, unsigned int glyph, float originX, float originY)
+{
+  // 공백 문자처럼 bitmap 이 없는 glyph 는 그릴 필요가 없으므로 pen 위치만 이동
+  unsigned int page = metrics.getPage(glyph);
+  if (page == NO_PAGE)
+  {
+    return;
+  }
+  const GlyphBox &box = metrics.getBox(glyph);
+  const glm::vec4 &uv = metrics.getUV(glyph);
+
+  /**
+   * 2D Quad 위치는 정점 데이터를 만들 때 SIMD 커널이 한꺼번에 계산하므로 여기서는 필드별 배열에 원점과 metrices 만 기록함.
+   * (Bearing 만큼 glyph 원점에서 떨어진 곳이 2D Quad 좌하단이며,
+   *  g, j, p 처럼 baseline 아래로 내려오는 glyph 는 Bearing.y 가 Size.y 보다 작으므로 2D Quad 가 baseline 밑으로 내려감)
+   */
+  keys.push_back(key);
+  pages.push_back(page);
+  this->originX.push_back(originX);
+  this->originY.push_back(originY);
+  bearingX.push_back(static_cast<float>(box.bearingX));
+  bearingY.push_back(static_cast<float>(box.bearingY));
+  sizeX.push_back(static_cast<float>(box.sizeX));
+  sizeY.push_back(static_cast<float>(box.sizeY));
+  u0.push_back(uv.x);
+  v0.push_back(uv.y);
+  u1.push_back(uv.z);
+  v1.push_back(uv.w);
+
+  // 측정용 영역은 커널과 같은 식으로 바로 갱신
+  float x = originX + box.bearingX * scale;
+  float y = originY - (box.sizeY - box.bearingY) * scale;
+  float w = box.sizeX * scale;
+  float h = box.sizeY * scale;
+  if (keys.size() == 1)
+  {
+    bounds = glm::vec4(x, y, x + w, y + h);
+  }
+  else
+  {
+    bounds.x = std::min(bounds.x, x);
+    bounds.y = std::min(bounds.y, y);
+    bounds.z = std::max(bounds.z, x + w);
+    bounds.w = std::max(bounds.w, y + h);
+  }
+}
+
+// glyph 캐시에 없는 glyph 키 기록 (한 문자열 안에서 반복되는 glyph 는 한 번만)
+void TextLayout::addMissing(unsigned int key)
+{
+  if (std::find(missing.begin(), missing.end(), key) == missing.end())
+  {
+    missing.push_back(key);
+  }
+}
@@ -0,0 +1,253 @@
+#include "text/text_mesh.hpp"
+
+#include <algorithm> // std::find, std::sort, std::binary_search
+
+namespace
+{
+  // layout 도중 batch key 별로 모으는 정점 배열
+  struct MeshBucket
+  {
+    TextBatchKey key;
+    unsigned int page;
+    std::vector<TextVertex> vertices;
+    std::vector<TextInstance> instances;
+  };
+
+  // layout 의 [first, first + count) 번째 glyph 들(같은 아틀라스 페이지)을 batch key 별 bucket 에 추가
+  void appendGlyphs(std::vector<MeshBucket> &buckets, const GlyphCache &glyphs, const TextLayout &layout, size_t first,
+                    size_t count, unsigned int features, const glm::vec4 &color, TextBatchMode mode)
+  {
+    unsigned int page = layout.getPage(first);
+    TextBatchKey key = {features, glyphs.getPageTexture(page), TEXT_BLEND_ALPHA};
+
+    MeshBucket *bucket = NULL;
+    for (size_t i = 0; i < buckets.size(); i++)
+    {
+      if (buckets[i].key == key)
+      {
+        bucket = &buckets[i];
+        break;
+      }
+    }
+    if (!bucket)
+    {
+      MeshBucket newBucket;
+      newBucket.key = key;
+      newBucket.page = page;
+      buckets.push_back(newBucket);
+      bucket = &buckets.back();
+    }
+
+    layout.appendQuads(first, count, color, mode, bucket->vertices, bucket->instances);
+  }
+}
+
+// TextMesh 클래스 생성자
+TextMesh::TextMesh(GlyphCache *glyphs)
+    : glyphs(glyphs), shaper(NULL), x(0.0f), y(0.0f), scale(1.0f), color(1.0f), features(TEXT_FEATURE_NONE),
+      dirty(true), built(false), builtMode(TEXT_BATCH_VERTICES), evictions(0), failedEvictions(0), capacity(0), glyphCount(0)
+{
+  glGenBuffers(1, &VBO);
+}
+
+// TextMesh 클래스 소멸자
+TextMesh::~TextMesh()
+{
+  glDeleteBuffers(1, &VBO);
+}
+
+void TextMesh::setFont(GlyphCache *glyphs)
+{
+  if (this->glyphs != glyphs)
+  {
+    this->glyphs = glyphs;
+    dirty = true;
+  }
+}
+
+void TextMesh::setShaper(TextShaper *shaper)
+{
+  if (this->shaper != shaper)
+  {
+    this->shaper = shaper;
+    dirty = true;
+  }
+}
+
+void TextMesh::setText(TextView text)
+{
+  if (this->text.compare(0, std::string::npos, text.data, text.length) != 0)
+  {
+    this->text.assign(text.data, text.length);
+    dirty = true;
+  }
+}
+
+void TextMesh::setPosition(float x, float y)
+{
+  if (this->x != x || this->y != y)
+  {
+    this->x = x;
+    this->y = y;
+    dirty = true;
+  }
+}
+
+void TextMesh::setScale(float scale)
+{
+  if (this->scale != scale)
+  {
+    this->scale = scale;
+    dirty = true;
+  }
+}
+
+void TextMesh::setColor(const glm::vec4 &color)
+{
+  if (this->color != color)
+  {
+    this->color = color;
+    dirty = true;
+  }
+}
+
+void TextMesh::setFeatures(unsigned int features)
+{
+  if (this->features != features)
+  {
+    this->features = features;
+    dirty = true;
+  }
+}
+
+// 필요한 경우에만 다시 layout 해서 버퍼 객체에 업로드
+bool TextMesh::update(TextBatchMode mode)
+{
+  if (!glyphs)
+  {
+    return false;
+  }
+  if (built && !dirty && mode == builtMode && evictions == glyphs->getStats().evictions)
+  {
+    return false;
+  }
+
+  /**
+   * TextLayout 으로 positioned glyph 들을 계산하고, glyph 캐시에 없던 glyph 가 있으면 한꺼번에 올린 뒤 다시 layout 함.
+   * (preload() 도중 페이지가 제거될 수 있으므로 uv 는 항상 두 번째 layout 결과를 사용)
+   */
+  layoutText();
+  if (!layout.isComplete())
+  {
+    // 이전에 메모리 예산이 부족해서 추가하지 못한 glyph 는 그 이후로 비워진 페이지가 없다면 다시 요청해도 실패하므로 제외
+    if (failedEvictions != glyphs->getStats().evictions)
+    {
+      failed.clear();
+    }
+
+    const std::vector<unsigned int> &missing = layout.getMissing();
+    std::vector<unsigned int> requests;
+    for (size_t i = 0; i < missing.size(); i++)
+    {
+      if (!std::binary_search(failed.begin(), failed.end(), missing[i]))
+      {
+        requests.push_back(missing[i]);
+      }
+    }
+
+    if (!requests.empty())
+    {
+      glyphs->preload(&requests[0], requests.size());
+      layoutText();
+    }
+  }
+
+  /**
+   * 그래도 추가하지 못한 glyph 는 기억해두고, 페이지가 제거되어 evictions 가 바뀔 때만 다시 시도함.
+   * (매 제출마다 다시 시도하면 같은 glyph 때문에 매 프레임 layout 과 업로드를 반복하고 예산 부족 에러도 매 프레임 출력됨)
+   */
+  failed = layout.getMissing();
+  std::sort(failed.begin(), failed.end());
+  failedEvictions = glyphs->getStats().evictions;
+
+  /** positioned glyph 들을 batch key(= 아틀라스 페이지)별로 모아둠 */
+  std::vector<MeshBucket> buckets;
+  size_t count = layout.getGlyphCount();
+  for (size_t first = 0; first < count;)
+  {
+    size_t end = layout.getPageRunEnd(first);
+    appendGlyphs(buckets, *glyphs, layout, first, end - first, features, color, mode);
+    first = end;
+  }
+  glyphCount = static_cast<unsigned int>(count);
+
+  /** 모든 batch key 의 정점 데이터를 하나의 버퍼 객체에 이어붙여서 업로드하고 segment 로 구간을 기록 */
+  size_t stride = (mode == TEXT_BATCH_INSTANCED) ? sizeof(TextInstance) : sizeof(TextVertex);
+  size_t bytes = 0;
+  for (size_t i = 0; i < buckets.size(); i++)
+  {
+    bytes += (buckets[i].vertices.size() + buckets[i].instances.size()) * stride;
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  if (bytes > capacity)
+  {
+    // 내용이 거의 바뀌지 않는 데이터이므로 GL_STATIC_DRAW 로 할당 (줄어들 때는 재할당하지 않고 기존 크기를 재사용)
+    glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STATIC_DRAW);
+    capacity = bytes;
+  }
+
+  segments.clear();
+  pages.clear();
+  GLint first = 0;
+  for (size_t i = 0; i < buckets.size(); i++)
+  {
+    const MeshBucket &bucket = buckets[i];
+    GLsizei count = static_cast<GLsizei>(bucket.vertices.size() + bucket.instances.size());
+    const void *data = mode == TEXT_BATCH_INSTANCED ? static_cast<const void *>(&bucket.instances[0])
+                                                    : static_cast<const void *>(&bucket.vertices[0]);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<size_t>(first) * stride, count * stride, data);
+
+    Segment segment = {bucket.key, first, count};
+    segments.push_back(segment);
+    if (std::find(pages.begin(), pages.end(), bucket.page) == pages.end())
+    {
+      pages.push_back(bucket.page);
+    }
+    first += count;
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // 정점 데이터의 uv 는 마지막 layout 시점의 아틀라스 기준이므로, 그 이후로 페이지가 제거되면 다음 제출 때 다시 layout 함
+  evictions = layout.getEvictions();
+  dirty = false;
+  built = true;
+  builtMode = mode;
+  return true;
+}
+
+// shaper 가 있으면 shaping 된 glyph run 으로, 없으면 codepoint 단위로 layout
+void TextMesh::layoutText()
+{
+  if (shaper)
+  {
+    layout.layout(shaper->shape(text), *glyphs, x, y, scale);
+  }
+  else
+  {
+    layout.layout(text.data(), text.size(), *glyphs, x, y, scale);
+  }
+}
+
+// 사용 중인 아틀라스 페이지들을 현재 프레임에서 사용 중인 것으로 표시
+void TextMesh::touchPages()
+{
+  if (!glyphs)
+  {
+    return;
+  }
+  for (size_t i = 0; i < pages.size(); i++)
+  {
+    glyphs->touchPage(pages[i]);
+  }
+}
@@ -0,0 +1,153 @@
+#include "text/text_shaper.hpp"
+#include "utils/hash.hpp"
+
+#include <hb-ft.h> // FT_Face 로 hb_font 생성
+
+#include <iostream> // 콘솔 입출력을 위한 헤더
+
+// TextShaper 클래스 생성자
+TextShaper::TextShaper(FT_Face face, GlyphRenderMode renderMode, size_t capacity)
+    : face(face), pixelSize(face->size ? face->size->metrics.y_ppem : 0), featuresHash(hashBytes(NULL, 0)),
+      capacity(capacity > 0 ? capacity : 1)
+{
+  stats.hits = 0;
+  stats.misses = 0;
+  stats.evictions = 0;
+
+  // FT_Face 의 현재 pixel size 로 scale 이 설정된 hb_font 생성 (위치값이 FreeType 과 같은 1/64 px 단위로 계산됨)
+  font = hb_ft_font_create(face, NULL);
+
+  // glyph 캐시가 rasterize 할 때와 같은 hinting 설정으로 advance 를 계산해야 glyph 사이 간격이 어긋나지 않음
+  hb_ft_font_set_load_flags(font, renderMode == GLYPH_RENDER_BITMAP ? FT_LOAD_DEFAULT : FT_LOAD_NO_HINTING);
+
+  buffer = hb_buffer_create();
+  if (!hb_buffer_allocation_successful(buffer))
+  {
+    std::cout << "ERROR::TEXT_SHAPER: Failed to allocate HarfBuzz buffer" << std::endl;
+  }
+}
+
+// TextShaper 클래스 소멸자
+TextShaper::~TextShaper()
+{
+  hb_buffer_destroy(buffer);
+  hb_font_destroy(font);
+}
+
+// 이후 shape() 에 적용할 OpenType feature 설정
+bool TextShaper::setFeatures(const std::string &features)
+{
+  std::vector<hb_feature_t> parsed;
+  size_t begin = 0;
+  while (begin < features.size())
+  {
+    size_t end = features.find(',', begin);
+    if (end == std::string::npos)
+    {
+      end = features.size();
+    }
+
+    if (end > begin)
+    {
+      hb_feature_t feature;
+      if (!hb_feature_from_string(features.data() + begin, static_cast<int>(end - begin), &feature))
+      {
+        std::cout << "ERROR::TEXT_SHAPER: Invalid OpenType feature: " << features.substr(begin, end - begin) << std::endl;
+        return false;
+      }
+      parsed.push_back(feature);
+    }
+    begin = end + 1;
+  }
+
+  this->features.swap(parsed);
+  featuresHash = hashBytes(features.data(), features.size());
+  return true;
+}
+
+// UTF-8 문자열을 shaping 한 run 을 반환 (캐시에 있으면 shaping 생략)
+const ShapedRun &TextShaper::shape(const char *text, size_t length)
+{
+  // FT_Set_Pixel_Sizes() 로 face 크기가 바뀌었다면 hb_font 의 scale 도 다시 맞춤 (pixel size 가 키에 포함되므로 기존 run 은 재사용되지 않음)
+  unsigned int currentPixelSize = face->size ? face->size->metrics.y_ppem : 0;
+  if (currentPixelSize != pixelSize)
+  {
+    hb_ft_font_changed(font);
+    pixelSize = currentPixelSize;
+  }
+
+  ShapeKey key = {hashBytes(text, length), face, pixelSize, featuresHash};
+  unsigned long long hash = hashBytes(&key.font, sizeof(key.font), key.textHash);
+  hash = hashBytes(&key.pixelSize, sizeof(key.pixelSize), hash);
+  hash = hashBytes(&key.featuresHash, sizeof(key.featuresHash), hash);
+
+  /** 캐시 조회 -> 적중하면 list 의 맨 앞(가장 최근)으로 옮기고 그대로 반환 */
+  std::unordered_map<unsigned long long, std::list<Entry>::iterator>::iterator found = runIndex.find(hash);
+  if (found != runIndex.end())
+  {
+    std::list<Entry>::iterator entry = found->second;
+    if (entry->key == key && entry->text.compare(0, std::string::npos, text, length) == 0)
+    {
+      stats.hits++;
+      runs.splice(runs.begin(), runs, entry);
+      return entry->run;
+    }
+
+    // 해시만 같은 다른 문자열 -> 기존 run 을 버리고 새로 shaping 한 run 으로 교체
+    runs.erase(entry);
+    runIndex.erase(found);
+  }
+
+  /** 캐시 미스 -> hb_shape() 로 shaping */
+  stats.misses++;
+
+  hb_buffer_clear_contents(buffer);
+  hb_buffer_add_utf8(buffer, text, static_cast<int>(length), 0, static_cast<int>(length));
+
+  // 문자열로부터 방향(LTR / RTL), 문자 체계(script), 언어를 추정 (RTL 문자열이면 glyph 들이 시각적인 순서로 뒤집혀서 나옴)
+  hb_buffer_guess_segment_properties(buffer);
+  hb_shape(font, buffer, features.empty() ? NULL : &features[0], static_cast<unsigned int>(features.size()));
+
+  // capacity 를 넘어서면 가장 오랫동안 조회되지 않은 run 제거
+  if (runs.size() >= capacity)
+  {
+    runIndex.erase(runs.back().hash);
+    runs.pop_back();
+    stats.evictions++;
+  }
+
+  runs.push_front(Entry());
+  Entry &entry = runs.front();
+  entry.key = key;
+  entry.hash = hash;
+  entry.text.assign(text, length);
+  runIndex[hash] = runs.begin();
+
+  unsigned int count = 0;
+  const hb_glyph_info_t *infos = hb_buffer_get_glyph_infos(buffer, &count);
+  const hb_glyph_position_t *positions = hb_buffer_get_glyph_positions(buffer, NULL);
+
+  ShapedRun &run = entry.run;
+  run.glyphs.resize(count);
+  run.advance = 0;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    ShapedGlyph &glyph = run.glyphs[i];
+    glyph.glyphIndex = infos[i].codepoint; // shaping 이후에는 codepoint 필드에 glyph index 가 저장됨
+    glyph.cluster = infos[i].cluster;
+    glyph.xAdvance = positions[i].x_advance;
+    glyph.yAdvance = positions[i].y_advance;
+    glyph.xOffset = positions[i].x_offset;
+    glyph.yOffset = positions[i].y_offset;
+    run.advance += glyph.xAdvance;
+  }
+
+  return run;
+}
+
+// 캐시된 모든 run 제거
+void TextShaper::clear()
+{
+  runs.clear();
+  runIndex.clear();
+}
@@ -0,0 +1,42 @@
+#include "utils/gl_extensions.hpp"
+
+#include <cstring> // std::strcmp
+
+// 현재 OpenGL 컨텍스트가 주어진 이름의 확장(extension)을 지원하는지 검사
+bool hasGLExtension(const char *name)
+{
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+  for (GLint i = 0; i < count; i++)
+  {
+    const char *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+    if (extension && std::strcmp(extension, name) == 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// core 기능으로 승격된 ARB 확장의 함수 포인터를 로드
+void loadGLExtensions(GLADloadproc loader)
+{
+  if (!loader)
+  {
+    return;
+  }
+
+  if (!GLAD_GL_VERSION_4_1 && hasGLExtension("GL_ARB_get_program_binary"))
+  {
+    glad_glGetProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYPROC>(loader("glGetProgramBinary"));
+    glad_glProgramBinary = reinterpret_cast<PFNGLPROGRAMBINARYPROC>(loader("glProgramBinary"));
+    glad_glProgramParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIPROC>(loader("glProgramParameteri"));
+  }
+
+  if (!GLAD_GL_VERSION_4_4 && hasGLExtension("GL_ARB_buffer_storage"))
+  {
+    glad_glBufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(loader("glBufferStorage"));
+  }
+}
@@ -0,0 +1,169 @@
+#include "utils/job_system.hpp"
+
+// JobSystem 클래스 생성자
+JobSystem::JobSystem(unsigned int threadCount)
+    : function(NULL), context(NULL), remaining(0), generation(0), stopping(false), jobCount(0), stealCount(0)
+{
+  if (threadCount == 0)
+  {
+    // hardware_concurrency() 는 알 수 없을 때 0 을 반환하므로 최소 1개(호출 스레드)는 사용
+    threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+    {
+      threadCount = 1;
+    }
+  }
+
+  for (unsigned int i = 0; i < threadCount; i++)
+  {
+    queues.push_back(new WorkQueue());
+  }
+
+  // 마지막 worker 번호는 parallelFor() 호출 스레드가 사용하므로 스레드는 하나 적게 생성
+  for (unsigned int i = 0; i + 1 < threadCount; i++)
+  {
+    threads.push_back(std::thread(&JobSystem::workerMain, this, i));
+  }
+}
+
+// JobSystem 클래스 소멸자
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (size_t i = 0; i < threads.size(); i++)
+  {
+    threads[i].join();
+  }
+  for (size_t i = 0; i < queues.size(); i++)
+  {
+    delete queues[i];
+  }
+}
+
+// [0, count) 범위의 작업들을 병렬로 실행하고 모두 끝날 때까지 대기
+void JobSystem::parallelFor(JobFunction function, void *context, size_t count)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  this->function = function;
+  this->context = context;
+  remaining.store(count, std::memory_order_relaxed);
+
+  /**
+   * 작업 번호들을 worker 개수만큼 연속된 구간으로 나눠서 각 deque 에 채워 넣음
+   *
+   * 인접한 작업(같은 화면의 인접한 라벨 등)은 같은 worker 가 처리하는 편이 캐시에 유리하며,
+   * 구간별 비용이 고르지 않은 경우는 steal 로 균형을 맞춤.
+   */
+  size_t workers = queues.size();
+  for (size_t w = 0; w < workers; w++)
+  {
+    size_t begin = count * w / workers;
+    size_t end = count * (w + 1) / workers;
+    std::lock_guard<std::mutex> lock(queues[w]->mutex);
+    for (size_t i = begin; i < end; i++)
+    {
+      queues[w]->jobs.push_back(i);
+    }
+  }
+
+  if (!threads.empty())
+  {
+    {
+      std::lock_guard<std::mutex> lock(wakeMutex);
+      generation++;
+    }
+    wake.notify_all();
+  }
+
+  // 호출 스레드도 마지막 worker 로 참여하고, 꺼낼 작업이 없어지면 다른 worker 들이 실행 중인 작업이 끝나기를 기다림
+  unsigned int self = static_cast<unsigned int>(workers - 1);
+  drain(self);
+  while (remaining.load(std::memory_order_acquire) != 0)
+  {
+    std::this_thread::yield();
+  }
+}
+
+// worker 스레드 본체
+void JobSystem::workerMain(unsigned int worker)
+{
+  unsigned long long seen = 0;
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      while (!stopping && generation == seen)
+      {
+        wake.wait(lock);
+      }
+      if (stopping)
+      {
+        break;
+      }
+      seen = generation;
+    }
+
+    drain(worker);
+  }
+}
+
+// 꺼낼 작업이 없을 때까지 실행
+void JobSystem::drain(unsigned int worker)
+{
+  size_t workers = queues.size();
+  for (;;)
+  {
+    size_t index;
+    bool stolen = false;
+    if (!pop(worker, false, index))
+    {
+      // 자신의 deque 가 비었으면 다음 worker 부터 차례로 훔쳐올 작업을 찾음
+      for (size_t i = 1; i < workers && !stolen; i++)
+      {
+        stolen = pop(static_cast<unsigned int>((worker + i) % workers), true, index);
+      }
+      if (!stolen)
+      {
+        // 작업은 실행 도중 새 작업을 만들지 않으므로, 모든 deque 가 비었다면 이번 parallelFor() 에서 할 일이 끝남
+        return;
+      }
+      stealCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    function(context, index, worker);
+    jobCount.fetch_add(1, std::memory_order_relaxed);
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+// worker 의 deque 에서 작업 하나를 꺼냄
+bool JobSystem::pop(unsigned int worker, bool steal, size_t &index)
+{
+  WorkQueue &queue = *queues[worker];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.jobs.empty())
+  {
+    return false;
+  }
+
+  if (steal)
+  {
+    index = queue.jobs.front();
+    queue.jobs.pop_front();
+  }
+  else
+  {
+    index = queue.jobs.back();
+    queue.jobs.pop_back();
+  }
+  return true;
+}
@@ -0,0 +1,119 @@
+#include "utils/mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+#endif
+
+// MappedFile 클래스 생성자
+MappedFile::MappedFile()
+    : bytes(NULL), length(0)
+#ifdef _WIN32
+      ,
+      file(NULL), mapping(NULL)
+#endif
+{
+}
+
+// MappedFile 클래스 소멸자
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+// 주어진 경로의 파일을 읽기 전용으로 매핑
+bool MappedFile::open(const char *path)
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+  {
+    CloseHandle(fileHandle);
+    return false;
+  }
+
+  HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (!mappingHandle)
+  {
+    CloseHandle(fileHandle);
+    return false;
+  }
+
+  void *view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+  if (!view)
+  {
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    return false;
+  }
+
+  file = fileHandle;
+  mapping = mappingHandle;
+  bytes = static_cast<const unsigned char *>(view);
+  length = static_cast<size_t>(fileSize.QuadPart);
+#else
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  // MAP_SHARED + PROT_READ 로 매핑하면 같은 파일을 매핑한 모든 프로세스가 page cache 의 동일한 물리 페이지를 공유함.
+  void *view = mmap(NULL, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+  // 매핑이 유지되는 동안에는 file descriptor 를 닫아도 됨.
+  ::close(fd);
+
+  if (view == MAP_FAILED)
+  {
+    return false;
+  }
+
+  bytes = static_cast<const unsigned char *>(view);
+  length = static_cast<size_t>(info.st_size);
+#endif
+
+  return true;
+}
+
+// 매핑 해제
+void MappedFile::close()
+{
+  if (!bytes)
+  {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(bytes);
+  CloseHandle(mapping);
+  CloseHandle(file);
+  mapping = NULL;
+  file = NULL;
+#else
+  munmap(const_cast<unsigned char *>(bytes), length);
+#endif
+
+  bytes = NULL;
+  length = 0;
+}
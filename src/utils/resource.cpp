@@ -0,0 +1,81 @@
+#include "utils/resource.hpp"
+
+#include <cstdlib> // std::getenv
+#include <cstring> // std::strcmp
+#include <string>  // std::string
+
+const char *const Resource::RESOURCE_OVERRIDE_ENV = "TEXT_RENDERING_RESOURCE_DIR";
+
+// Resource 클래스 생성자
+Resource::Resource()
+    : bytes(NULL), length(0), embedded(false)
+{
+}
+
+// Resource 클래스 소멸자
+Resource::~Resource()
+{
+  close();
+}
+
+// 실행파일에 내장된 리소스 조회
+const EmbeddedResource *Resource::findEmbedded(const char *path)
+{
+  // 내장 리소스는 쉐이더 몇 개와 폰트 정도라서 선형 탐색으로 충분함
+  for (size_t i = 0; i < EMBEDDED_RESOURCE_COUNT; i++)
+  {
+    if (std::strcmp(EMBEDDED_RESOURCES[i].path, path) == 0)
+    {
+      return &EMBEDDED_RESOURCES[i];
+    }
+  }
+  return NULL;
+}
+
+// 주어진 경로의 리소스를 찾음
+bool Resource::open(const char *path)
+{
+  close();
+
+  // 1. 개발용 override 디렉토리에 같은 경로의 파일이 있으면 내장 리소스 대신 사용
+  const char *overrideDir = std::getenv(RESOURCE_OVERRIDE_ENV);
+  if (overrideDir && overrideDir[0] != '\0')
+  {
+    std::string overridePath = std::string(overrideDir) + "/" + path;
+    if (file.open(overridePath.c_str()))
+    {
+      bytes = file.data();
+      length = file.size();
+      return true;
+    }
+  }
+
+  // 2. 실행파일에 내장된 리소스 (파일 시스템 접근 없음)
+  const EmbeddedResource *resource = findEmbedded(path);
+  if (resource)
+  {
+    bytes = resource->data;
+    length = resource->size;
+    embedded = true;
+    return true;
+  }
+
+  // 3. 내장되지 않은 리소스는 작업 디렉토리 기준 경로로 매핑
+  if (file.open(path))
+  {
+    bytes = file.data();
+    length = file.size();
+    return true;
+  }
+
+  return false;
+}
+
+// 리소스 해제
+void Resource::close()
+{
+  file.close();
+  bytes = NULL;
+  length = 0;
+  embedded = false;
+}
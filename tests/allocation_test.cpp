@@ -0,0 +1,157 @@
+#include "support/gl_stub.hpp"
+#include "support/test.hpp"
+#include "support/test_font.hpp"
+
+#include <shader/shader_library.hpp>
+#include <text/glyph_cache.hpp>
+#include <text/parallel_text_layout.hpp>
+#include <text/text_batcher.hpp>
+#include <text/text_mesh.hpp>
+#include <utils/job_system.hpp>
+
+#include <atomic>  // std::atomic
+#include <cstdio>  // std::snprintf
+#include <cstdlib> // std::malloc, std::free
+#include <new>     // std::bad_alloc, std::nothrow_t
+
+/**
+ * steady state 의 프레임(layout + 제출 + flush)은 힙 메모리를 새로 할당하지 않아야 함.
+ *
+ * 전역 operator new / delete 를 교체해서 할당 횟수를 세고, 워밍업 프레임들로 배열 capacity 가 자리잡은 뒤의
+ * 프레임들에서 ParallelTextLayout::build() / submit(), TextBatcher::submitMesh() / flush() 가 할당을 하지 않는지 확인함.
+ * (worker 스레드의 할당도 세기 위해 전역 카운터는 atomic 으로 둠)
+ */
+namespace
+{
+  std::atomic<bool> counting(false);
+  std::atomic<long> allocations(0);
+
+  void *allocate(size_t size)
+  {
+    if (counting.load(std::memory_order_relaxed))
+    {
+      allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    return std::malloc(size ? size : 1);
+  }
+}
+
+void *operator new(size_t size)
+{
+  void *p = allocate(size);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new[](size_t size)
+{
+  void *p = allocate(size);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+const int WARMUP_FRAMES = 10;
+const int MEASURED_FRAMES = 200;
+const int STATIC_BLOCKS = 16;
+const int MESH_COUNT = 4;
+
+void testSteadyState(GlyphCache &glyphs, ShaderLibrary &shaders, TextBatchMode mode)
+{
+  JobSystem jobs;
+  TextBatcher batcher(shaders, "resources/shaders/text.vs", "resources/shaders/text.fs", mode);
+  ParallelTextLayout layout(jobs, glyphs, NULL);
+
+  TextMesh meshes[MESH_COUNT];
+  for (int i = 0; i < MESH_COUNT; i++)
+  {
+    meshes[i].setFont(&glyphs);
+    meshes[i].setText(TextView("This is sample text"));
+    meshes[i].setPosition(25.0f, 25.0f + i * 40.0f);
+    meshes[i].setFeatures(i % 2 ? TEXT_FEATURE_SDF : TEXT_FEATURE_NONE);
+  }
+
+  // HUD 처럼 매 프레임 내용이 바뀌는 문자열 2개 + 내용이 같은 문자열들 (기능 플래그를 섞어서 batch key 를 여러 개 사용)
+  char frameLine[64];
+  char batchLine[64];
+  TextBlock blocks[2 + STATIC_BLOCKS];
+  for (int i = 0; i < STATIC_BLOCKS; i++)
+  {
+    TextBlock block = {TextView("(C) LearnOpenGL.com"), 540.0f, 570.0f - i * 20.0f, 0.5f, glm::vec4(0.3f, 0.7f, 0.9f, 1.0f),
+                       i % 3 ? static_cast<unsigned int>(TEXT_FEATURE_NONE) : TEXT_FEATURE_SDF | TEXT_FEATURE_OUTLINE};
+    blocks[2 + i] = block;
+  }
+
+  long buildAllocations = 0;
+  long submitAllocations = 0;
+  long flushAllocations = 0;
+  for (int frame = 0; frame < WARMUP_FRAMES + MEASURED_FRAMES; frame++)
+  {
+    if (frame == WARMUP_FRAMES)
+    {
+      allocations = 0;
+      counting = true;
+    }
+
+    glyphs.beginFrame();
+
+    // 고정 폭 서식이므로 문자열 길이는 프레임마다 같고 내용(= glyph)만 바뀜
+    int frameLength = std::snprintf(frameLine, sizeof(frameLine), "%6.2f ms / frame", 16.0 + (frame % 97) * 0.37);
+    int batchLength = std::snprintf(batchLine, sizeof(batchLine), "%5u glyphs, %3u draw calls",
+                                    batcher.getStats().glyphs, batcher.getStats().drawCalls);
+    TextBlock frameBlock = {TextView(frameLine, frameLength), 25.0f, 570.0f, 0.35f, glm::vec4(1.0f), TEXT_FEATURE_NONE};
+    TextBlock batchBlock = {TextView(batchLine, batchLength), 25.0f, 552.0f, 0.35f, glm::vec4(1.0f), TEXT_FEATURE_NONE};
+    blocks[0] = frameBlock;
+    blocks[1] = batchBlock;
+
+    long before = allocations;
+    layout.build(blocks, 2 + STATIC_BLOCKS, mode);
+    long afterBuild = allocations;
+    layout.submit(batcher);
+    for (int i = 0; i < MESH_COUNT; i++)
+    {
+      batcher.submitMesh(meshes[i]);
+    }
+    long afterSubmit = allocations;
+    batcher.flush();
+    long afterFlush = allocations;
+
+    buildAllocations += afterBuild - before;
+    submitAllocations += afterSubmit - afterBuild;
+    flushAllocations += afterFlush - afterSubmit;
+  }
+  counting = false;
+
+  CHECK_EQUAL(0, buildAllocations);
+  CHECK_EQUAL(0, submitAllocations);
+  CHECK_EQUAL(0, flushAllocations);
+  CHECK(batcher.getStats().glyphs > 0);
+  CHECK_EQUAL(static_cast<unsigned int>(MESH_COUNT), batcher.getStats().meshes);
+}
+
+int main()
+{
+  installGlStub();
+
+  TestFont font;
+  CHECK(font.getFace() != NULL);
+  if (!font.getFace())
+    return TEST_RESULT();
+
+  ShaderLibrary shaders(NULL);
+  GlyphCache glyphs(font.getFace());
+  glyphs.preload(32, 126);
+
+  testSteadyState(glyphs, shaders, TEXT_BATCH_VERTICES);
+  testSteadyState(glyphs, shaders, TEXT_BATCH_INSTANCED);
+
+  return TEST_RESULT();
+}
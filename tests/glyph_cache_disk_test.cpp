@@ -0,0 +1,143 @@
+#include "support/gl_stub.hpp"
+#include "support/test.hpp"
+#include "support/test_font.hpp"
+
+#include <text/glyph_cache.hpp>
+#include <text/glyph_metrics.hpp>
+
+#include <cstdio>   // std::remove
+#include <cstring>  // std::memcpy
+#include <fstream>  // 파일 입출력을 위한 헤더
+#include <iterator> // std::istreambuf_iterator
+#include <vector>   // std::vector
+
+/**
+ * 디스크 캐시 파일 형식 (glyph_cache.cpp 의 FileHeader / PageHeader / GlyphRecord 와 같은 배치)
+ *
+ * [FileHeader 40 bytes] [페이지마다 PageHeader 16 bytes + skyline 노드 12 bytes x N + 픽셀] [GlyphRecord 44 bytes x glyphCount]
+ */
+const size_t FILE_HEADER_SIZE = 40;
+const size_t FILE_VERSION_OFFSET = 4;
+const size_t FILE_GLYPH_COUNT_OFFSET = 36;
+const size_t PAGE_HEADER_SIZE = 16;
+const size_t NODE_SIZE = 12;
+const size_t GLYPH_RECORD_SIZE = 44;
+
+const char *const CACHE_PATH = "glyph_cache_disk_test.glyphcache";
+const char *const CORRUPT_PATH = "glyph_cache_disk_test_corrupt.glyphcache";
+
+const GlyphCacheKey KEY = {0x1234567890ABCDEFull, 48, GLYPH_RENDER_BITMAP};
+
+std::vector<unsigned char> readFile(const char *path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<unsigned char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const char *path, const std::vector<unsigned char> &bytes)
+{
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(&bytes[0]), bytes.size());
+}
+
+int readInt(const std::vector<unsigned char> &bytes, size_t offset)
+{
+  int value;
+  std::memcpy(&value, &bytes[offset], sizeof(value));
+  return value;
+}
+
+void writeInt(std::vector<unsigned char> &bytes, size_t offset, int value)
+{
+  std::memcpy(&bytes[offset], &value, sizeof(value));
+}
+
+// 손상된 파일은 거부되어야 하고, 거부된 뒤에도 캐시는 비어있는 상태로 남아서 온전한 파일을 다시 불러올 수 있어야 함.
+void expectRejected(FT_Face face, const std::vector<unsigned char> &bytes, const char *what)
+{
+  writeFile(CORRUPT_PATH, bytes);
+
+  GlyphCache cache(face);
+  bool loaded = cache.loadFromDisk(CORRUPT_PATH, KEY);
+  CHECK(!loaded);
+  if (loaded)
+  {
+    std::cout << "  accepted corrupted cache file: " << what << std::endl;
+  }
+  CHECK(cache.loadFromDisk(CACHE_PATH, KEY));
+}
+
+int main()
+{
+  installGlStub();
+
+  TestFont font;
+  CHECK(font.getFace() != NULL);
+  if (!font.getFace())
+    return TEST_RESULT();
+
+  /** 온전한 캐시 파일 저장 후 다시 불러오기 */
+  {
+    GlyphCache cache(font.getFace());
+    cache.preload(32, 126);
+    CHECK(cache.saveToDisk(CACHE_PATH, KEY));
+  }
+  {
+    GlyphCache cache(font.getFace());
+    CHECK(cache.loadFromDisk(CACHE_PATH, KEY));
+    CHECK(cache.peek('A') != GlyphMetrics::NO_GLYPH);
+    CHECK(cache.peek(' ') != GlyphMetrics::NO_GLYPH);
+  }
+
+  const std::vector<unsigned char> original = readFile(CACHE_PATH);
+  CHECK(original.size() > FILE_HEADER_SIZE + PAGE_HEADER_SIZE);
+  if (original.size() <= FILE_HEADER_SIZE + PAGE_HEADER_SIZE)
+    return TEST_RESULT();
+
+  // 첫 번째 페이지의 skyline (95 개 glyph 를 배치했으므로 선분이 여러 개여야 함)
+  const size_t skylineCount = static_cast<size_t>(readInt(original, FILE_HEADER_SIZE));
+  const size_t firstNode = FILE_HEADER_SIZE + PAGE_HEADER_SIZE;
+  const size_t lastNode = firstNode + (skylineCount - 1) * NODE_SIZE;
+  CHECK(skylineCount >= 2);
+
+  const size_t glyphCount = static_cast<size_t>(readInt(original, FILE_GLYPH_COUNT_OFFSET));
+  const size_t firstRecord = original.size() - glyphCount * GLYPH_RECORD_SIZE;
+  CHECK(glyphCount >= 2);
+
+  std::vector<unsigned char> bytes;
+
+  bytes = original;
+  writeInt(bytes, FILE_VERSION_OFFSET, readInt(bytes, FILE_VERSION_OFFSET) + 1);
+  expectRejected(font.getFace(), bytes, "version mismatch");
+
+  bytes = original;
+  bytes.resize(bytes.size() - GLYPH_RECORD_SIZE / 2);
+  expectRejected(font.getFace(), bytes, "truncated glyph records");
+
+  // 첫 번째 노드가 x = 0 에서 시작하지 않음
+  bytes = original;
+  writeInt(bytes, firstNode, 1);
+  writeInt(bytes, firstNode + 8, readInt(bytes, firstNode + 8) - 1);
+  expectRejected(font.getFace(), bytes, "skyline does not start at x = 0");
+
+  // 두 번째 노드가 첫 번째 노드 바로 뒤에서 시작하지 않음 (너비 합은 그대로)
+  bytes = original;
+  writeInt(bytes, firstNode + 8, readInt(bytes, firstNode + 8) - 1);
+  writeInt(bytes, firstNode + NODE_SIZE + 8, readInt(bytes, firstNode + NODE_SIZE + 8) + 1);
+  expectRejected(font.getFace(), bytes, "gap between skyline nodes");
+
+  // 노드들은 이어져 있지만 페이지 너비 전체를 덮지 않음
+  bytes = original;
+  writeInt(bytes, lastNode + 8, readInt(bytes, lastNode + 8) - 1);
+  expectRejected(font.getFace(), bytes, "skyline narrower than the page");
+
+  // 같은 codepoint 의 glyph 레코드가 두 번 저장됨
+  bytes = original;
+  std::memcpy(&bytes[firstRecord + GLYPH_RECORD_SIZE], &bytes[firstRecord], 4);
+  expectRejected(font.getFace(), bytes, "duplicate codepoint");
+
+  std::remove(CACHE_PATH);
+  std::remove(CORRUPT_PATH);
+
+  return TEST_RESULT();
+}
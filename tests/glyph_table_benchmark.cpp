@@ -0,0 +1,98 @@
+#include "support/benchmark.hpp"
+
+#include <text/glyph_table.hpp>
+
+#include <cstdio> // std::printf
+#include <map>    // std::map
+#include <vector> // std::vector
+
+/**
+ * GlyphTable::find() 와 예전 구현이 사용하던 std::map 조회 비교
+ *
+ * 두 테이블에 같은 glyph 들(ASCII + 한글 음절 일부)을 넣고, 같은 codepoint 문자열을 반복 조회해서
+ * 조회 한 번당 평균 시간을 출력함. ASCII 문자열은 dense 배열 경로, 한글 문자열은 해시 테이블 경로를 측정함.
+ */
+const unsigned int HANGUL_FIRST = 0xAC00;
+const unsigned int HANGUL_COUNT = 2350; // KS X 1001 완성형 음절 개수 정도
+const size_t TEXT_LENGTH = 4096;
+const int REPEAT = 2000;
+
+// 간단한 선형 합동 난수 (플랫폼과 상관없이 같은 문자열을 만들기 위함)
+unsigned int nextRandom(unsigned int &state)
+{
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+std::vector<unsigned int> makeText(unsigned int first, unsigned int count, unsigned int seed)
+{
+  std::vector<unsigned int> text(TEXT_LENGTH);
+  for (size_t i = 0; i < TEXT_LENGTH; i++)
+  {
+    text[i] = first + nextRandom(seed) % count;
+  }
+  return text;
+}
+
+template <typename Lookup>
+double measure(const std::vector<unsigned int> &text, Lookup lookup)
+{
+  unsigned long long sum = 0;
+  Stopwatch watch;
+  for (int r = 0; r < REPEAT; r++)
+  {
+    for (size_t i = 0; i < text.size(); i++)
+    {
+      sum += lookup(text[i]);
+    }
+  }
+  double ms = watch.elapsedMs();
+  consume(sum);
+  return ms * 1000000.0 / (static_cast<double>(REPEAT) * text.size());
+}
+
+struct TableLookup
+{
+  const GlyphTable *table;
+  unsigned int operator()(unsigned int codepoint) const { return table->find(codepoint); }
+};
+
+struct MapLookup
+{
+  const std::map<unsigned int, unsigned int> *map;
+  unsigned int operator()(unsigned int codepoint) const
+  {
+    std::map<unsigned int, unsigned int>::const_iterator it = map->find(codepoint);
+    return it != map->end() ? it->second : GlyphTable::NO_INDEX;
+  }
+};
+
+int main()
+{
+  GlyphTable table;
+  std::map<unsigned int, unsigned int> map;
+  unsigned int index = 0;
+  for (unsigned int c = 32; c < 127; c++, index++)
+  {
+    table.insert(c, index);
+    map[c] = index;
+  }
+  for (unsigned int c = HANGUL_FIRST; c < HANGUL_FIRST + HANGUL_COUNT; c++, index++)
+  {
+    table.insert(c, index);
+    map[c] = index;
+  }
+
+  std::vector<unsigned int> ascii = makeText(32, 127 - 32, 1);
+  std::vector<unsigned int> hangul = makeText(HANGUL_FIRST, HANGUL_COUNT, 2);
+
+  TableLookup tableLookup = {&table};
+  MapLookup mapLookup = {&map};
+
+  std::printf("%u glyphs, %zu lookups per run\n", index, TEXT_LENGTH * REPEAT);
+  std::printf("%-8s %14s %14s\n", "text", "GlyphTable", "std::map");
+  std::printf("%-8s %11.2f ns %11.2f ns\n", "ascii", measure(ascii, tableLookup), measure(ascii, mapLookup));
+  std::printf("%-8s %11.2f ns %11.2f ns\n", "hangul", measure(hangul, tableLookup), measure(hangul, mapLookup));
+  std::printf("checksum %llu\n", benchmarkSink());
+  return 0;
+}
@@ -0,0 +1,75 @@
+#include "support/benchmark.hpp"
+#include "support/test_font.hpp"
+
+#include <text/kerning_table.hpp>
+
+#include <cstdio>  // std::printf
+#include <cstring> // std::strlen
+
+/**
+ * KerningTable::lookup() 과 예전 layout 루프처럼 인접한 문자 쌍마다 FT_Get_Kerning() 을 호출하는 방식 비교
+ *
+ * 기본 폰트(Antonio-Bold)에는 'kern' 테이블이 없어서 두 방식 모두 kerning 이 0 이므로,
+ * kerning 이 있는 폰트로 측정하려면 첫 번째 인자로 폰트 파일 경로를 지정함.
+ *   kerning_benchmark [font.ttf]
+ */
+const char *const SAMPLE_TEXT =
+    "AVATAR Type WAVE To Yo. The quick brown fox jumps over the lazy dog, "
+    "\"Trying\" LT P. Vowel AWAY; rY fy 11 ms / frame, 1234 glyphs, 5 draw calls.";
+const int REPEAT = 20000;
+
+int main(int argc, char **argv)
+{
+  const char *path = argc > 1 ? argv[1] : TEST_FONT_PATH;
+  TestFont font(path);
+  FT_Face face = font.getFace();
+  if (!face)
+  {
+    return 1;
+  }
+
+  Stopwatch buildWatch;
+  KerningTable table;
+  size_t pairs = table.build(face, 32, 126, false);
+  double buildMs = buildWatch.elapsedMs();
+
+  const size_t length = std::strlen(SAMPLE_TEXT);
+  const size_t lookups = (length - 1) * REPEAT;
+
+  /** KerningTable : 인접한 쌍마다 hash table 조회 한 번 */
+  float tableSum = 0.0f;
+  Stopwatch tableWatch;
+  for (int r = 0; r < REPEAT; r++)
+  {
+    for (size_t i = 1; i < length; i++)
+    {
+      tableSum += table.lookup(static_cast<unsigned char>(SAMPLE_TEXT[i - 1]), static_cast<unsigned char>(SAMPLE_TEXT[i]));
+    }
+  }
+  double tableMs = tableWatch.elapsedMs();
+
+  /** FT_Get_Kerning : 인접한 쌍마다 두 codepoint 의 glyph index 조회 + 'kern' 테이블 탐색 */
+  float freetypeSum = 0.0f;
+  Stopwatch freetypeWatch;
+  for (int r = 0; r < REPEAT; r++)
+  {
+    for (size_t i = 1; i < length; i++)
+    {
+      FT_UInt left = FT_Get_Char_Index(face, static_cast<unsigned char>(SAMPLE_TEXT[i - 1]));
+      FT_UInt right = FT_Get_Char_Index(face, static_cast<unsigned char>(SAMPLE_TEXT[i]));
+      FT_Vector delta;
+      if (FT_Get_Kerning(face, left, right, FT_KERNING_DEFAULT, &delta) == 0)
+      {
+        freetypeSum += static_cast<float>(delta.x) / 64.0f;
+      }
+    }
+  }
+  double freetypeMs = freetypeWatch.elapsedMs();
+
+  std::printf("font %s: %zu kerning pairs extracted in %.2f ms%s\n", path, pairs, buildMs,
+              FT_HAS_KERNING(face) ? "" : " (no 'kern' table)");
+  std::printf("%zu pair lookups per run\n", lookups);
+  std::printf("%-14s %10.2f ns / pair  (sum %.1f px)\n", "KerningTable", tableMs * 1000000.0 / lookups, tableSum);
+  std::printf("%-14s %10.2f ns / pair  (sum %.1f px)\n", "FT_Get_Kerning", freetypeMs * 1000000.0 / lookups, freetypeSum);
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "support/benchmark.hpp"
+
+#include <text/quad_kernel.hpp>
+
+#include <cstdio> // std::printf
+#include <vector> // std::vector
+
+/**
+ * 2D Quad 생성 커널별 처리량 (glyphs / sec) 비교
+ *
+ * 한 프레임에 그리는 텍스트 정도(glyph 4093 개, 8 로 나누어 떨어지지 않아서 나머지 구간도 포함)를
+ * 두 출력 형식(TEXT_BATCH_VERTICES, TEXT_BATCH_INSTANCED)으로 반복 생성함.
+ * CPU 가 지원하지 않는 커널은 지원되는 가장 넓은 커널로 낮춰서 실행되므로 해당 행은 건너뜀.
+ */
+const size_t GLYPH_COUNT = 4093;
+const int REPEAT = 2000;
+
+double measure(QuadKernel kernel, const QuadSource &source, TextBatchMode mode, std::vector<unsigned char> &out)
+{
+  glm::vec4 color(1.0f, 1.0f, 1.0f, 1.0f);
+  Stopwatch watch;
+  for (int r = 0; r < REPEAT; r++)
+  {
+    generateQuads(kernel, source, 0, GLYPH_COUNT, 0.35f + r * 1e-6f, color, mode, &out[0]);
+    consume(out[r % out.size()]);
+  }
+  double seconds = watch.elapsedMs() / 1000.0;
+  return static_cast<double>(GLYPH_COUNT) * REPEAT / seconds;
+}
+
+int main()
+{
+  std::vector<float> fields[10];
+  for (int f = 0; f < 10; f++)
+  {
+    fields[f].resize(GLYPH_COUNT);
+    for (size_t i = 0; i < GLYPH_COUNT; i++)
+    {
+      fields[f][i] = static_cast<float>((i * 37 + f * 11) % 97) * 0.25f;
+    }
+  }
+  QuadSource source = {&fields[0][0], &fields[1][0], &fields[2][0], &fields[3][0], &fields[4][0],
+                       &fields[5][0], &fields[6][0], &fields[7][0], &fields[8][0], &fields[9][0]};
+
+  std::vector<unsigned char> out(GLYPH_COUNT * 6 * sizeof(TextVertex));
+
+  QuadKernel widest = detectQuadKernel();
+  std::printf("%zu glyphs x %d runs, widest kernel on this CPU: %s\n", GLYPH_COUNT, REPEAT, quadKernelName(widest));
+  std::printf("%-8s %18s %18s\n", "kernel", "vertices", "instanced");
+
+  const QuadKernel kernels[] = {QUAD_KERNEL_SCALAR, QUAD_KERNEL_SSE2, QUAD_KERNEL_AVX2};
+  double scalar[2] = {0.0, 0.0};
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+  {
+    if (kernels[k] > widest)
+    {
+      std::printf("%-8s %18s %18s\n", quadKernelName(kernels[k]), "unsupported", "unsupported");
+      continue;
+    }
+
+    double vertices = measure(kernels[k], source, TEXT_BATCH_VERTICES, out);
+    double instanced = measure(kernels[k], source, TEXT_BATCH_INSTANCED, out);
+    if (kernels[k] == QUAD_KERNEL_SCALAR)
+    {
+      scalar[0] = vertices;
+      scalar[1] = instanced;
+    }
+    std::printf("%-8s %8.1f M/s %4.2fx %8.1f M/s %4.2fx\n", quadKernelName(kernels[k]),
+                vertices / 1e6, vertices / scalar[0], instanced / 1e6, instanced / scalar[1]);
+  }
+
+  std::printf("checksum %llu\n", benchmarkSink());
+  return 0;
+}
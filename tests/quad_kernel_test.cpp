@@ -0,0 +1,121 @@
+#include "support/test.hpp"
+
+#include <text/quad_kernel.hpp>
+
+#include <cstring> // std::memcmp
+#include <vector>  // std::vector
+
+/**
+ * SSE2 / AVX2 커널은 glyph 수와 시작 위치에 상관없이 scalar 커널과 byte 단위로 같은 결과를 기록해야 함.
+ *
+ * count % 8 != 0, count % 4 != 0 인 나머지 구간과 정렬되지 않은 시작 위치(first)를 모두 확인하며,
+ * 출력 버퍼 끝에 sentinel 을 두어서 커널이 기록해야 할 범위를 넘어서 쓰지 않는지도 확인함.
+ */
+const size_t GLYPH_COUNT = 1100;
+const unsigned char SENTINEL = 0xCD;
+
+struct SoaGlyphs
+{
+  std::vector<float> fields[10];
+
+  QuadSource source() const
+  {
+    QuadSource s = {&fields[0][0], &fields[1][0], &fields[2][0], &fields[3][0], &fields[4][0],
+                    &fields[5][0], &fields[6][0], &fields[7][0], &fields[8][0], &fields[9][0]};
+    return s;
+  }
+};
+
+// 간단한 선형 합동 난수로 [lo, hi) 범위의 float 생성 (반올림 차이가 드러나도록 소수점 아래 값을 포함)
+float nextFloat(unsigned int &state, float lo, float hi)
+{
+  state = state * 1664525u + 1013904223u;
+  return lo + (hi - lo) * static_cast<float>(state >> 8) / 16777216.0f;
+}
+
+SoaGlyphs makeGlyphs()
+{
+  SoaGlyphs glyphs;
+  unsigned int state = 7;
+  for (int f = 0; f < 10; f++)
+  {
+    glyphs.fields[f].resize(GLYPH_COUNT);
+  }
+  for (size_t i = 0; i < GLYPH_COUNT; i++)
+  {
+    glyphs.fields[0][i] = nextFloat(state, -100.0f, 900.0f); // originX
+    glyphs.fields[1][i] = nextFloat(state, -100.0f, 700.0f); // originY
+    glyphs.fields[2][i] = nextFloat(state, -8.0f, 8.0f);     // bearingX
+    glyphs.fields[3][i] = nextFloat(state, -10.0f, 60.0f);   // bearingY
+    glyphs.fields[4][i] = nextFloat(state, 0.0f, 64.0f);     // sizeX
+    glyphs.fields[5][i] = nextFloat(state, 0.0f, 64.0f);     // sizeY
+    for (int f = 6; f < 10; f++)
+    {
+      glyphs.fields[f][i] = nextFloat(state, 0.0f, 1.0f); // uv
+    }
+  }
+  return glyphs;
+}
+
+std::vector<unsigned char> run(QuadKernel kernel, const QuadSource &source, size_t first, size_t count, TextBatchMode mode)
+{
+  size_t stride = mode == TEXT_BATCH_INSTANCED ? sizeof(TextInstance) : 6 * sizeof(TextVertex);
+  std::vector<unsigned char> out(count * stride + stride, SENTINEL);
+  generateQuads(kernel, source, first, count, 0.35f, glm::vec4(0.9f, 0.5f, 0.25f, 0.75f), mode, &out[0]);
+  return out;
+}
+
+void testKernel(QuadKernel kernel, const SoaGlyphs &glyphs, TextBatchMode mode)
+{
+  QuadSource source = glyphs.source();
+  size_t stride = mode == TEXT_BATCH_INSTANCED ? sizeof(TextInstance) : 6 * sizeof(TextVertex);
+
+  // 0 ~ 33 개 (8 의 배수 전후, 4 의 배수 전후) + 큰 개수, 정렬된 / 정렬되지 않은 시작 위치
+  const size_t firsts[] = {0, 1, 3, 5, 8, 13};
+  const size_t bigCounts[] = {64, 255, 1021, 1087};
+  for (size_t f = 0; f < sizeof(firsts) / sizeof(firsts[0]); f++)
+  {
+    for (size_t count = 0; count < 34 + sizeof(bigCounts) / sizeof(bigCounts[0]); count++)
+    {
+      size_t n = count < 34 ? count : bigCounts[count - 34];
+      std::vector<unsigned char> expected = run(QUAD_KERNEL_SCALAR, source, firsts[f], n, mode);
+      std::vector<unsigned char> actual = run(kernel, source, firsts[f], n, mode);
+
+      bool same = std::memcmp(&expected[0], &actual[0], expected.size()) == 0;
+      CHECK(same);
+      if (!same)
+      {
+        std::cout << "  " << quadKernelName(kernel) << " differs from scalar: first " << firsts[f] << ", count " << n
+                  << (mode == TEXT_BATCH_INSTANCED ? ", instanced" : ", vertices") << std::endl;
+      }
+
+      // 마지막 glyph 다음은 건드리지 않아야 함
+      for (size_t i = n * stride; i < actual.size(); i++)
+      {
+        if (actual[i] != SENTINEL)
+        {
+          CHECK(actual[i] == SENTINEL);
+          break;
+        }
+      }
+    }
+  }
+}
+
+int main()
+{
+  SoaGlyphs glyphs = makeGlyphs();
+
+  QuadKernel widest = detectQuadKernel();
+  std::cout << "widest kernel on this CPU: " << quadKernelName(widest) << std::endl;
+
+  // CPU 가 지원하지 않는 커널은 generateQuads() 가 낮춰서 실행하므로 항상 모두 호출해도 안전함
+  const QuadKernel kernels[] = {QUAD_KERNEL_SSE2, QUAD_KERNEL_AVX2};
+  for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+  {
+    testKernel(kernels[k], glyphs, TEXT_BATCH_VERTICES);
+    testKernel(kernels[k], glyphs, TEXT_BATCH_INSTANCED);
+  }
+
+  return TEST_RESULT();
+}
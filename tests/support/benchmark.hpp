@@ -0,0 +1,38 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono> // std::chrono
+
+/**
+ * 벤치마크용 시간 측정 도구
+ *
+ * 측정할 루프의 결과값은 consume() 에 누적해서 출력하도록 하면, 컴파일러가 결과를 사용하지 않는 루프를 제거하지 못함.
+ */
+class Stopwatch
+{
+public:
+  Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+  // 생성 이후 경과 시간 (ms)
+  double elapsedMs() const
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start;
+};
+
+// 측정 결과를 모아두는 checksum (벤치마크 마지막에 출력)
+inline unsigned long long &benchmarkSink()
+{
+  static unsigned long long sink = 0;
+  return sink;
+}
+
+inline void consume(unsigned long long value)
+{
+  benchmarkSink() += value;
+}
+
+#endif // BENCHMARK_HPP
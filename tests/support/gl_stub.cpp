@@ -0,0 +1,332 @@
+#include "support/gl_stub.hpp"
+
+#include <cstring> // std::memcpy, std::strcpy
+#include <map>     // std::map
+#include <vector>  // std::vector
+
+namespace
+{
+  struct Texture
+  {
+    int width;
+    int height;
+    int channels;
+    std::vector<unsigned char> pixels;
+  };
+
+  GlStubStats stats;
+  GLuint nextName = 1;
+  GLint unpackAlignment = 4;
+  GLint packAlignment = 4;
+  GLuint boundBuffer = 0;
+  GLuint boundTexture = 0;
+  std::map<GLuint, std::vector<unsigned char> > buffers;
+  std::map<GLuint, Texture> textures;
+
+  int formatChannels(GLenum format)
+  {
+    switch (format)
+    {
+    case GL_RED:
+      return 1;
+    case GL_RG:
+      return 2;
+    case GL_RGB:
+      return 3;
+    default:
+      return 4;
+    }
+  }
+
+  // alignment 에 맞춰 올림한 텍스쳐 한 줄의 byte 수
+  size_t rowStride(int width, int channels, GLint alignment)
+  {
+    size_t row = static_cast<size_t>(width) * channels;
+    return (row + alignment - 1) / alignment * alignment;
+  }
+
+  void APIENTRY genNames(GLsizei n, GLuint *names)
+  {
+    for (GLsizei i = 0; i < n; i++)
+    {
+      names[i] = nextName++;
+    }
+  }
+
+  /** 텍스쳐 */
+  void APIENTRY genTextures(GLsizei n, GLuint *names)
+  {
+    genNames(n, names);
+    for (GLsizei i = 0; i < n; i++)
+    {
+      textures[names[i]].width = 0;
+    }
+  }
+  void APIENTRY deleteTextures(GLsizei n, const GLuint *names)
+  {
+    for (GLsizei i = 0; i < n; i++)
+    {
+      textures.erase(names[i]);
+    }
+  }
+  void APIENTRY bindTexture(GLenum, GLuint texture) { boundTexture = texture; }
+  void APIENTRY activeTexture(GLenum) {}
+  void APIENTRY pixelStorei(GLenum pname, GLint param)
+  {
+    if (pname == GL_UNPACK_ALIGNMENT)
+      unpackAlignment = param;
+    else if (pname == GL_PACK_ALIGNMENT)
+      packAlignment = param;
+  }
+  void APIENTRY texParameteri(GLenum, GLenum, GLint) {}
+  void APIENTRY texImage2D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum format, GLenum, const void *pixels)
+  {
+    Texture &texture = textures[boundTexture];
+    texture.width = width;
+    texture.height = height;
+    texture.channels = formatChannels(format);
+    texture.pixels.assign(static_cast<size_t>(width) * height * texture.channels, 0);
+    if (pixels)
+    {
+      size_t stride = rowStride(width, texture.channels, unpackAlignment);
+      for (GLsizei y = 0; y < height; y++)
+      {
+        std::memcpy(&texture.pixels[static_cast<size_t>(y) * width * texture.channels],
+                    static_cast<const unsigned char *>(pixels) + y * stride, static_cast<size_t>(width) * texture.channels);
+      }
+    }
+  }
+  void APIENTRY texSubImage2D(GLenum, GLint, GLint x, GLint y, GLsizei width, GLsizei height, GLenum, GLenum, const void *pixels)
+  {
+    Texture &texture = textures[boundTexture];
+    if (!pixels || x < 0 || y < 0 || x + width > texture.width || y + height > texture.height)
+    {
+      return;
+    }
+    size_t stride = rowStride(width, texture.channels, unpackAlignment);
+    for (GLsizei row = 0; row < height; row++)
+    {
+      std::memcpy(&texture.pixels[(static_cast<size_t>(y + row) * texture.width + x) * texture.channels],
+                  static_cast<const unsigned char *>(pixels) + row * stride, static_cast<size_t>(width) * texture.channels);
+    }
+  }
+  void APIENTRY getTexImage(GLenum, GLint, GLenum, GLenum, void *pixels)
+  {
+    const Texture &texture = textures[boundTexture];
+    size_t stride = rowStride(texture.width, texture.channels, packAlignment);
+    for (int row = 0; row < texture.height; row++)
+    {
+      std::memcpy(static_cast<unsigned char *>(pixels) + row * stride,
+                  &texture.pixels[static_cast<size_t>(row) * texture.width * texture.channels],
+                  static_cast<size_t>(texture.width) * texture.channels);
+    }
+  }
+
+  /** 버퍼 객체 */
+  void APIENTRY genBuffers(GLsizei n, GLuint *names)
+  {
+    genNames(n, names);
+    for (GLsizei i = 0; i < n; i++)
+    {
+      buffers[names[i]];
+    }
+  }
+  void APIENTRY deleteBuffers(GLsizei n, const GLuint *names)
+  {
+    for (GLsizei i = 0; i < n; i++)
+    {
+      buffers.erase(names[i]);
+    }
+  }
+  void APIENTRY bindBuffer(GLenum, GLuint buffer) { boundBuffer = buffer; }
+  void APIENTRY bufferData(GLenum, GLsizeiptr size, const void *data, GLenum)
+  {
+    std::vector<unsigned char> &buffer = buffers[boundBuffer];
+    buffer.resize(static_cast<size_t>(size));
+    if (data && size > 0)
+    {
+      std::memcpy(&buffer[0], data, static_cast<size_t>(size));
+    }
+  }
+  void APIENTRY bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield) { bufferData(target, size, data, 0); }
+  void APIENTRY bufferSubData(GLenum, GLintptr offset, GLsizeiptr size, const void *data)
+  {
+    std::vector<unsigned char> &buffer = buffers[boundBuffer];
+    if (offset >= 0 && static_cast<size_t>(offset + size) <= buffer.size() && size > 0)
+    {
+      std::memcpy(&buffer[offset], data, static_cast<size_t>(size));
+    }
+  }
+  void *APIENTRY mapBufferRange(GLenum, GLintptr offset, GLsizeiptr length, GLbitfield)
+  {
+    std::vector<unsigned char> &buffer = buffers[boundBuffer];
+    if (offset < 0 || static_cast<size_t>(offset + length) > buffer.size() || buffer.empty())
+    {
+      return NULL;
+    }
+    return &buffer[offset];
+  }
+  GLboolean APIENTRY unmapBuffer(GLenum) { return GL_TRUE; }
+
+  /** vertex array, draw call */
+  void APIENTRY genVertexArrays(GLsizei n, GLuint *names) { genNames(n, names); }
+  void APIENTRY deleteVertexArrays(GLsizei, const GLuint *) {}
+  void APIENTRY bindVertexArray(GLuint) {}
+  void APIENTRY enableVertexAttribArray(GLuint) {}
+  void APIENTRY vertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) {}
+  void APIENTRY vertexAttribDivisor(GLuint, GLuint) {}
+  void APIENTRY blendFunc(GLenum, GLenum) {}
+  void APIENTRY drawArrays(GLenum, GLint, GLsizei count)
+  {
+    stats.drawCalls++;
+    stats.drawnVertices += count;
+  }
+  void APIENTRY drawArraysInstanced(GLenum, GLint, GLsizei, GLsizei instances)
+  {
+    stats.drawCalls++;
+    stats.drawnInstances += instances;
+  }
+
+  /** fence */
+  GLsync APIENTRY fenceSync(GLenum, GLbitfield) { return reinterpret_cast<GLsync>(static_cast<size_t>(nextName++)); }
+  GLenum APIENTRY clientWaitSync(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+  void APIENTRY deleteSync(GLsync) {}
+
+  /** 쉐이더 */
+  GLuint APIENTRY createShader(GLenum) { return nextName++; }
+  GLuint APIENTRY createProgram() { return nextName++; }
+  void APIENTRY shaderSource(GLuint, GLsizei, const GLchar *const *, const GLint *) {}
+  void APIENTRY compileShader(GLuint) {}
+  void APIENTRY attachShader(GLuint, GLuint) {}
+  void APIENTRY linkProgram(GLuint) {}
+  void APIENTRY deleteShader(GLuint) {}
+  void APIENTRY deleteProgram(GLuint) {}
+  void APIENTRY useProgram(GLuint program)
+  {
+    if (program)
+      stats.programBinds++;
+  }
+  void APIENTRY programParameteri(GLuint, GLenum, GLint) {}
+  void APIENTRY programBinary(GLuint, GLenum, const void *, GLsizei) {}
+  void APIENTRY getProgramBinary(GLuint, GLsizei, GLsizei *length, GLenum *format, void *)
+  {
+    if (length)
+      *length = 0;
+    *format = 0;
+  }
+  void APIENTRY getShaderiv(GLuint, GLenum pname, GLint *params) { *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0; }
+  void APIENTRY getProgramiv(GLuint, GLenum pname, GLint *params) { *params = pname == GL_LINK_STATUS ? GL_TRUE : 0; }
+  void APIENTRY getInfoLog(GLuint, GLsizei, GLsizei *length, GLchar *log)
+  {
+    if (length)
+      *length = 0;
+    log[0] = '\0';
+  }
+  void APIENTRY getActiveUniform(GLuint, GLuint, GLsizei, GLsizei *length, GLint *size, GLenum *type, GLchar *name)
+  {
+    *length = 0;
+    *size = 0;
+    *type = GL_NONE;
+    name[0] = '\0';
+  }
+  GLint APIENTRY getUniformLocation(GLuint, const GLchar *) { return -1; }
+  void APIENTRY uniform1i(GLint, GLint) {}
+  void APIENTRY uniform1f(GLint, GLfloat) {}
+  void APIENTRY uniform2f(GLint, GLfloat, GLfloat) {}
+  void APIENTRY uniform3f(GLint, GLfloat, GLfloat, GLfloat) {}
+  void APIENTRY uniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) {}
+  void APIENTRY uniformfv(GLint, GLsizei, const GLfloat *) {}
+  void APIENTRY uniformMatrixfv(GLint, GLsizei, GLboolean, const GLfloat *) {}
+
+  /** 상태 조회 (확장 없음, 프로그램 바이너리 포맷 없음) */
+  void APIENTRY getIntegerv(GLenum, GLint *data) { *data = 0; }
+  const GLubyte *APIENTRY getString(GLenum) { return reinterpret_cast<const GLubyte *>("gl stub"); }
+  const GLubyte *APIENTRY getStringi(GLenum, GLuint) { return NULL; }
+}
+
+// glad 함수 포인터들을 stub 으로 교체
+void installGlStub()
+{
+  glad_glGenTextures = genTextures;
+  glad_glDeleteTextures = deleteTextures;
+  glad_glBindTexture = bindTexture;
+  glad_glActiveTexture = activeTexture;
+  glad_glPixelStorei = pixelStorei;
+  glad_glTexParameteri = texParameteri;
+  glad_glTexImage2D = texImage2D;
+  glad_glTexSubImage2D = texSubImage2D;
+  glad_glGetTexImage = getTexImage;
+
+  glad_glGenBuffers = genBuffers;
+  glad_glDeleteBuffers = deleteBuffers;
+  glad_glBindBuffer = bindBuffer;
+  glad_glBufferData = bufferData;
+  glad_glBufferStorage = bufferStorage;
+  glad_glBufferSubData = bufferSubData;
+  glad_glMapBufferRange = mapBufferRange;
+  glad_glUnmapBuffer = unmapBuffer;
+
+  glad_glGenVertexArrays = genVertexArrays;
+  glad_glDeleteVertexArrays = deleteVertexArrays;
+  glad_glBindVertexArray = bindVertexArray;
+  glad_glEnableVertexAttribArray = enableVertexAttribArray;
+  glad_glVertexAttribPointer = vertexAttribPointer;
+  glad_glVertexAttribDivisor = vertexAttribDivisor;
+  glad_glBlendFunc = blendFunc;
+  glad_glDrawArrays = drawArrays;
+  glad_glDrawArraysInstanced = drawArraysInstanced;
+
+  glad_glFenceSync = fenceSync;
+  glad_glClientWaitSync = clientWaitSync;
+  glad_glDeleteSync = deleteSync;
+
+  glad_glCreateShader = createShader;
+  glad_glCreateProgram = createProgram;
+  glad_glShaderSource = shaderSource;
+  glad_glCompileShader = compileShader;
+  glad_glAttachShader = attachShader;
+  glad_glLinkProgram = linkProgram;
+  glad_glDeleteShader = deleteShader;
+  glad_glDeleteProgram = deleteProgram;
+  glad_glUseProgram = useProgram;
+  glad_glProgramParameteri = programParameteri;
+  glad_glProgramBinary = programBinary;
+  glad_glGetProgramBinary = getProgramBinary;
+  glad_glGetShaderiv = getShaderiv;
+  glad_glGetProgramiv = getProgramiv;
+  glad_glGetShaderInfoLog = getInfoLog;
+  glad_glGetProgramInfoLog = getInfoLog;
+  glad_glGetActiveUniform = getActiveUniform;
+  glad_glGetUniformLocation = getUniformLocation;
+  glad_glUniform1i = uniform1i;
+  glad_glUniform1f = uniform1f;
+  glad_glUniform2f = uniform2f;
+  glad_glUniform3f = uniform3f;
+  glad_glUniform4f = uniform4f;
+  glad_glUniform2fv = uniformfv;
+  glad_glUniform3fv = uniformfv;
+  glad_glUniform4fv = uniformfv;
+  glad_glUniformMatrix2fv = uniformMatrixfv;
+  glad_glUniformMatrix3fv = uniformMatrixfv;
+  glad_glUniformMatrix4fv = uniformMatrixfv;
+
+  glad_glGetIntegerv = getIntegerv;
+  glad_glGetString = getString;
+  glad_glGetStringi = getStringi;
+
+  resetGlStubStats();
+}
+
+// 마지막 resetGlStubStats() 이후의 draw call 기록
+const GlStubStats &getGlStubStats()
+{
+  return stats;
+}
+
+void resetGlStubStats()
+{
+  stats.drawCalls = 0;
+  stats.drawnVertices = 0;
+  stats.drawnInstances = 0;
+  stats.programBinds = 0;
+}
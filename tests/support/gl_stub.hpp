@@ -0,0 +1,32 @@
+#ifndef GL_STUB_HPP
+#define GL_STUB_HPP
+
+#include <glad/glad.h> // OpenGL 함수 포인터
+
+/**
+ * 테스트용 OpenGL 함수 stub
+ *
+ * 테스트는 윈도우나 GL 컨텍스트 없이 실행되므로, gladLoadGLLoader() 대신 installGlStub() 으로
+ * src/ 가 사용하는 glad 함수 포인터들을 CPU 메모리만 사용하는 가짜 구현으로 채움.
+ *   - 텍스쳐 / 버퍼 객체는 id 별 byte 배열로 흉내내므로 glTexSubImage2D() 로 올린 픽셀을 glGetTexImage() 로 다시 읽을 수 있고,
+ *     glMapBufferRange() 는 해당 버퍼 배열의 포인터를 반환함.
+ *   - 쉐이더 컴파일 / 링킹은 항상 성공하고, active uniform 은 없는 것으로 보고함.
+ *   - draw call 은 그리지 않고 getGlStubStats() 에 쉐이더 전환 횟수와 함께 횟수만 기록함.
+ * GL 버전 플래그(GLAD_GL_VERSION_*)와 확장 목록은 비어있으므로 GL 3.3 기본 경로로 동작함.
+ */
+struct GlStubStats
+{
+  unsigned int drawCalls;      // glDrawArrays() + glDrawArraysInstanced() 호출 횟수
+  unsigned int drawnVertices;  // glDrawArrays() 로 그린 정점 개수
+  unsigned int drawnInstances; // glDrawArraysInstanced() 로 그린 인스턴스 개수
+  unsigned int programBinds;   // glUseProgram() 으로 0 이 아닌 프로그램을 바인딩한 횟수 (쉐이더 전환 횟수)
+};
+
+// glad 함수 포인터들을 stub 으로 교체
+void installGlStub();
+
+// 마지막 resetGlStubStats() 이후의 draw call 기록
+const GlStubStats &getGlStubStats();
+void resetGlStubStats();
+
+#endif // GL_STUB_HPP
@@ -0,0 +1,41 @@
+#ifndef TEST_HPP
+#define TEST_HPP
+
+#include <iostream> // 콘솔 입출력을 위한 헤더
+
+/**
+ * 테스트용 최소 검사 매크로
+ *
+ * 실패해도 테스트를 중단하지 않고 위치와 조건식을 출력한 뒤 실패 횟수만 누적하며,
+ * 테스트의 main() 은 TEST_RESULT() 를 반환해서 ctest 가 실패를 알 수 있도록 함.
+ */
+inline int &testFailures()
+{
+  static int failures = 0;
+  return failures;
+}
+
+#define CHECK(condition)                                                                       \
+  do                                                                                           \
+  {                                                                                            \
+    if (!(condition))                                                                          \
+    {                                                                                          \
+      std::cout << "FAILED: " << __FILE__ << ":" << __LINE__ << ": " << #condition << std::endl; \
+      testFailures()++;                                                                        \
+    }                                                                                          \
+  } while (0)
+
+#define CHECK_EQUAL(expected, actual)                                                     \
+  do                                                                                      \
+  {                                                                                       \
+    if (!((expected) == (actual)))                                                        \
+    {                                                                                     \
+      std::cout << "FAILED: " << __FILE__ << ":" << __LINE__ << ": " << #actual << " == " \
+                << (actual) << ", expected " << (expected) << std::endl;                  \
+      testFailures()++;                                                                   \
+    }                                                                                     \
+  } while (0)
+
+#define TEST_RESULT() (testFailures() == 0 ? 0 : 1)
+
+#endif // TEST_HPP
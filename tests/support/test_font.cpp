@@ -0,0 +1,34 @@
+#include "support/test_font.hpp"
+
+#include <iostream> // 콘솔 입출력을 위한 헤더
+
+const char *const TEST_FONT_PATH = "resources/fonts/Antonio-Bold.ttf";
+
+TestFont::TestFont(const char *path, unsigned int pixelSize)
+    : library(NULL), face(NULL), bytes(NULL)
+{
+  if (FT_Init_FreeType(&library))
+  {
+    std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+    library = NULL;
+    return;
+  }
+
+  bytes = loader.load(path);
+  face = bytes ? loader.openFace(library, path) : NULL;
+  if (!face)
+  {
+    std::cout << "ERROR::FREETYPE: Failed to load font " << path << std::endl;
+    return;
+  }
+
+  FT_Set_Pixel_Sizes(face, 0, pixelSize);
+}
+
+TestFont::~TestFont()
+{
+  if (face)
+    FT_Done_Face(face);
+  if (library)
+    FT_Done_FreeType(library);
+}
@@ -0,0 +1,40 @@
+#ifndef TEST_FONT_HPP
+#define TEST_FONT_HPP
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <text/font_loader.hpp> // 내장 폰트 / 메모리 매핑된 폰트 바이트
+
+// 테스트 기본 폰트 (실행파일에 내장되어 있으므로 작업 디렉토리와 상관없이 열림)
+extern const char *const TEST_FONT_PATH;
+
+/*
+  TestFont 클래스
+
+  테스트와 벤치마크가 공통으로 사용하는 FreeType 초기화 + FT_Face 생성을 묶어둔 클래스.
+  main.cpp 와 같은 FontLoader 경로로 폰트를 열고, 소멸될 때 FT_Face -> FT_Library 순으로 해제함.
+*/
+class TestFont
+{
+public:
+  // path 의 폰트를 pixelSize 크기로 열기 (실패하면 getFace() 가 NULL)
+  explicit TestFont(const char *path = TEST_FONT_PATH, unsigned int pixelSize = 48);
+
+  ~TestFont();
+
+  FT_Face getFace() const { return face; }
+  const Resource *getBytes() const { return bytes; }
+
+private:
+  FontLoader loader;
+  FT_Library library;
+  FT_Face face;
+  const Resource *bytes;
+
+  // 복사 방지 (FT_Face 중복 해제 방지)
+  TestFont(const TestFont &);
+  TestFont &operator=(const TestFont &);
+};
+
+#endif // TEST_FONT_HPP
@@ -0,0 +1,148 @@
+#include "support/gl_stub.hpp"
+#include "support/test.hpp"
+#include "support/test_font.hpp"
+
+#include <shader/shader_library.hpp>
+#include <text/glyph_cache.hpp>
+#include <text/text_batcher.hpp>
+#include <text/text_layout.hpp>
+#include <text/text_mesh.hpp>
+
+#include <cstdio>  // std::snprintf
+#include <cstring> // std::strlen
+#include <vector>  // std::vector
+
+/**
+ * 같은 아틀라스와 쉐이더를 공유하는 문자열 N 개는 문자열 개수와 상관없이 draw call 한 번으로 그려져야 함.
+ * 기능 플래그가 다른 문자열을 섞으면 batch key 개수만큼 draw call 이 늘어남.
+ */
+const int LABEL_COUNT = 64;
+const int MESH_COUNT = 4;
+
+void testSharedKey(GlyphCache &glyphs, ShaderLibrary &shaders, TextBatchMode mode)
+{
+  TextBatcher batcher(shaders, "resources/shaders/text.vs", "resources/shaders/text.fs", mode);
+
+  std::vector<TextLayout> layouts(LABEL_COUNT);
+  unsigned int glyphCount = 0;
+  for (int i = 0; i < LABEL_COUNT; i++)
+  {
+    char label[32];
+    std::snprintf(label, sizeof(label), "label %d", i);
+    layouts[i].layout(label, std::strlen(label), glyphs, 10.0f, 10.0f + i * 8.0f, 0.25f);
+    CHECK(layouts[i].isComplete());
+    glyphCount += static_cast<unsigned int>(layouts[i].getGlyphCount());
+  }
+
+  // 여러 번 flush 해도 매 프레임 draw call 은 한 번
+  for (int frame = 0; frame < 3; frame++)
+  {
+    glyphs.beginFrame();
+    for (int i = 0; i < LABEL_COUNT; i++)
+    {
+      CHECK(batcher.submitLayout(layouts[i], glyphs, TEXT_FEATURE_NONE, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f)));
+    }
+
+    resetGlStubStats();
+    batcher.flush();
+
+    CHECK_EQUAL(1u, batcher.getStats().drawCalls);
+    CHECK_EQUAL(1u, getGlStubStats().drawCalls);
+    CHECK_EQUAL(glyphCount, batcher.getStats().glyphs);
+    if (mode == TEXT_BATCH_INSTANCED)
+      CHECK_EQUAL(glyphCount, getGlStubStats().drawnInstances);
+    else
+      CHECK_EQUAL(glyphCount * 6, getGlStubStats().drawnVertices);
+  }
+
+  // 기능 플래그가 다른 문자열이 섞이면 batch key 별로 한 번씩
+  glyphs.beginFrame();
+  for (int i = 0; i < LABEL_COUNT; i++)
+  {
+    batcher.submitLayout(layouts[i], glyphs, i % 2 ? TEXT_FEATURE_SDF : TEXT_FEATURE_NONE, glm::vec4(1.0f));
+  }
+  resetGlStubStats();
+  batcher.flush();
+  CHECK_EQUAL(2u, batcher.getStats().drawCalls);
+  CHECK_EQUAL(2u, getGlStubStats().drawCalls);
+
+  // 아무것도 제출하지 않은 프레임은 draw call 없음
+  resetGlStubStats();
+  batcher.flush();
+  CHECK_EQUAL(0u, batcher.getStats().drawCalls);
+  CHECK_EQUAL(0u, getGlStubStats().drawCalls);
+}
+
+/**
+ * TextMesh 의 segment 는 매 프레임 제출된 glyph 들과 같은 draw 목록에서 batch key 순으로 그려져야 함.
+ * TextMesh 는 각자 버퍼를 가지므로 TextMesh 마다 draw call 이 하나씩 추가되지만, 쉐이더는 batch key 가 바뀔 때만 전환됨.
+ */
+void testMeshOrdering(GlyphCache &glyphs, ShaderLibrary &shaders, TextBatchMode mode)
+{
+  TextBatcher batcher(shaders, "resources/shaders/text.vs", "resources/shaders/text.fs", mode);
+
+  TextMesh meshes[MESH_COUNT];
+  for (int i = 0; i < MESH_COUNT; i++)
+  {
+    meshes[i].setFont(&glyphs);
+    meshes[i].setText(TextView("static label"));
+    meshes[i].setPosition(10.0f, 300.0f + i * 20.0f);
+    meshes[i].setScale(0.5f);
+    meshes[i].setFeatures(TEXT_FEATURE_NONE);
+  }
+
+  TextLayout layout;
+  layout.layout("dynamic", 7, glyphs, 10.0f, 10.0f, 0.25f);
+
+  for (int frame = 0; frame < 3; frame++)
+  {
+    glyphs.beginFrame();
+
+    // 기능 플래그가 NONE -> SDF -> (TextMesh) NONE 순으로 제출되더라도 쉐이더 전환은 두 번이어야 함
+    batcher.submitLayout(layout, glyphs, TEXT_FEATURE_NONE, glm::vec4(1.0f));
+    batcher.submitLayout(layout, glyphs, TEXT_FEATURE_SDF, glm::vec4(1.0f));
+    for (int i = 0; i < MESH_COUNT; i++)
+    {
+      batcher.submitMesh(meshes[i]);
+    }
+
+    resetGlStubStats();
+    batcher.flush();
+
+    CHECK_EQUAL(static_cast<unsigned int>(MESH_COUNT), batcher.getStats().meshes);
+    CHECK_EQUAL(2u + MESH_COUNT, batcher.getStats().drawCalls);
+    CHECK_EQUAL(2u + MESH_COUNT, getGlStubStats().drawCalls);
+    CHECK_EQUAL(2u, getGlStubStats().programBinds);
+  }
+
+  // TextMesh 만 제출된 프레임
+  for (int i = 0; i < MESH_COUNT; i++)
+  {
+    batcher.submitMesh(meshes[i]);
+  }
+  resetGlStubStats();
+  batcher.flush();
+  CHECK_EQUAL(static_cast<unsigned int>(MESH_COUNT), getGlStubStats().drawCalls);
+  CHECK_EQUAL(1u, getGlStubStats().programBinds);
+}
+
+int main()
+{
+  installGlStub();
+
+  TestFont font;
+  CHECK(font.getFace() != NULL);
+  if (!font.getFace())
+    return TEST_RESULT();
+
+  ShaderLibrary shaders(NULL);
+  GlyphCache glyphs(font.getFace());
+  glyphs.preload(32, 126);
+
+  testSharedKey(glyphs, shaders, TEXT_BATCH_VERTICES);
+  testSharedKey(glyphs, shaders, TEXT_BATCH_INSTANCED);
+  testMeshOrdering(glyphs, shaders, TEXT_BATCH_VERTICES);
+  testMeshOrdering(glyphs, shaders, TEXT_BATCH_INSTANCED);
+
+  return TEST_RESULT();
+}